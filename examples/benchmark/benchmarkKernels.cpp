@@ -0,0 +1,452 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+/*
+ * Microbenchmarks for the computational kernels of the sparse
+ * solver, run in isolation over a sweep of front sizes and scalar
+ * types. For each kernel, the minimum and median time over a number
+ * of repetitions are reported, in JSON, to stdout or to a file, so
+ * that kernel level performance can be compared across versions.
+ *
+ * Run as:
+ *   OMP_NUM_THREADS=8 ./benchmarkKernels --sizes 256,512,1024 \
+ *       --types d,z --reps 5 --out kernels.json
+ */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <cmath>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#include "StrumpackOptions.hpp"
+#include "sparse/CSRMatrix.hpp"
+#include "sparse/fronts/FrontalMatrixDense.hpp"
+#include "BLR/BLRMatrix.hpp"
+#include "BLR/LRTile.hpp"
+#include "HSS/HSSMatrix.hpp"
+#include "structured/ClusterTree.hpp"
+#include "misc/TaskTimer.hpp"
+
+using namespace strumpack;
+
+typedef int integer;
+
+/*
+ * Expose the protected phases of the dense frontal matrix
+ * factorization, so they can be timed separately.
+ */
+template<typename scalar_t> class BenchFront
+  : public FrontalMatrixDense<scalar_t,integer> {
+  using FD_t = FrontalMatrixDense<scalar_t,integer>;
+public:
+  BenchFront(integer sep_begin, integer sep_end, std::vector<integer>& upd)
+    : FD_t(0, sep_begin, sep_end, upd) {}
+  using FD_t::extract_front;
+  using FD_t::assemble_children;
+  using FD_t::factor_phase2;
+};
+
+template<typename scalar_t> std::string scalar_name();
+template<> std::string scalar_name<float>() { return "s"; }
+template<> std::string scalar_name<double>() { return "d"; }
+template<> std::string scalar_name<std::complex<float>>() { return "c"; }
+template<> std::string scalar_name<std::complex<double>>() { return "z"; }
+
+struct Result {
+  std::string kernel, variant, scalar;
+  std::size_t n = 0, m = 0;
+  double tmin = 0., tmed = 0., flops = 0., rank = -1, memory = -1;
+};
+
+class Benchmark {
+public:
+  int reps = 5;
+  std::vector<std::string> kernels;
+  std::vector<Result> results;
+
+  bool enabled(const std::string& k) const {
+    return kernels.empty() ||
+      std::find(kernels.begin(), kernels.end(), k) != kernels.end();
+  }
+
+  /*
+   * Run setup() followed by the timed f(), reps times, keep the
+   * minimum and the median time. When in_parallel, f is called from
+   * a single thread inside an OpenMP parallel region, as the
+   * multifrontal factorization does, so OpenMP tasks can be used.
+   */
+  Result& run(const std::string& kernel, const std::string& variant,
+              const std::string& scalar, std::size_t n, std::size_t m,
+              double flops, bool in_parallel,
+              const std::function<void()>& setup,
+              const std::function<void()>& f) {
+    std::vector<double> t(reps);
+    for (int r=0; r<reps; r++) {
+      setup();
+      TaskTimer timer("");
+      timer.start();
+      if (in_parallel) {
+#pragma omp parallel
+#pragma omp single nowait
+        f();
+      } else f();
+      t[r] = timer.elapsed();
+    }
+    std::sort(t.begin(), t.end());
+    Result res;
+    res.kernel = kernel; res.variant = variant; res.scalar = scalar;
+    res.n = n; res.m = m; res.flops = flops;
+    res.tmin = t[0]; res.tmed = t[reps/2];
+    results.push_back(res);
+    std::cerr << "# " << kernel << (variant.empty() ? "" : "/")
+              << variant << " " << scalar << " n=" << n << " m=" << m
+              << " tmin=" << res.tmin << "s";
+    if (flops > 0)
+      std::cerr << " GFlop/s=" << flops / res.tmin / 1e9;
+    std::cerr << std::endl;
+    return results.back();
+  }
+
+  void write_json(std::ostream& os, int threads) const {
+    os << "{\n  \"strumpack_version\": \"" << STRUMPACK_VERSION_MAJOR << "."
+       << STRUMPACK_VERSION_MINOR << "." << STRUMPACK_VERSION_PATCH << "\",\n"
+       << "  \"threads\": " << threads << ",\n"
+       << "  \"reps\": " << reps << ",\n"
+       << "  \"results\": [";
+    os.precision(8);
+    for (std::size_t i=0; i<results.size(); i++) {
+      auto& r = results[i];
+      os << (i ? ",\n" : "\n") << "    {\"kernel\": \"" << r.kernel
+         << "\", \"variant\": \"" << r.variant
+         << "\", \"scalar\": \"" << r.scalar
+         << "\", \"n\": " << r.n << ", \"m\": " << r.m
+         << ", \"time_min\": " << r.tmin << ", \"time_median\": " << r.tmed;
+      if (r.flops > 0)
+        os << ", \"flops\": " << r.flops
+           << ", \"gflops\": " << r.flops / r.tmin / 1e9;
+      if (r.rank >= 0) os << ", \"rank\": " << r.rank;
+      if (r.memory >= 0) os << ", \"memory\": " << r.memory;
+      os << "}";
+    }
+    os << "\n  ]\n}" << std::endl;
+  }
+};
+
+/*
+ * Random sparse matrix with nnz_row (random) off-diagonal nonzeros
+ * per row, and a dominant diagonal.
+ */
+template<typename scalar_t> CSRMatrix<scalar_t,integer>
+random_sparse(integer n, int nnz_row, std::mt19937& gen) {
+  std::uniform_int_distribution<integer> col(0, n-1);
+  std::uniform_real_distribution<double> val(-1., 1.);
+  std::vector<integer> ptr(n+1), ind;
+  std::vector<scalar_t> v;
+  ptr[0] = 0;
+  for (integer i=0; i<n; i++) {
+    std::vector<integer> c(1, i);
+    for (int k=0; k<nnz_row; k++) c.push_back(col(gen));
+    std::sort(c.begin(), c.end());
+    c.erase(std::unique(c.begin(), c.end()), c.end());
+    for (auto j : c) {
+      ind.push_back(j);
+      v.push_back(j == i ? scalar_t(2.*nnz_row) : scalar_t(val(gen)));
+    }
+    ptr[i+1] = ind.size();
+  }
+  return CSRMatrix<scalar_t,integer>(n, ptr.data(), ind.data(), v.data());
+}
+
+/*
+ * 5-point 2D Poisson matrix on a k x k grid.
+ */
+template<typename scalar_t> CSRMatrix<scalar_t,integer> poisson2d(integer k) {
+  integer n = k * k;
+  std::vector<integer> ptr(n+1), ind;
+  std::vector<scalar_t> v;
+  ptr[0] = 0;
+  for (integer y=0; y<k; y++)
+    for (integer x=0; x<k; x++) {
+      integer i = x + y*k;
+      if (y > 0)   { ind.push_back(i-k); v.push_back(scalar_t(-1.)); }
+      if (x > 0)   { ind.push_back(i-1); v.push_back(scalar_t(-1.)); }
+      ind.push_back(i); v.push_back(scalar_t(4.));
+      if (x < k-1) { ind.push_back(i+1); v.push_back(scalar_t(-1.)); }
+      if (y < k-1) { ind.push_back(i+k); v.push_back(scalar_t(-1.)); }
+      ptr[i+1] = ind.size();
+    }
+  return CSRMatrix<scalar_t,integer>(n, ptr.data(), ind.data(), v.data());
+}
+
+/*
+ * Dense matrix with smooth (numerically low-rank) off-diagonal
+ * blocks, A(i,j) = 1/(1+|i-j|), with a dominant diagonal.
+ */
+template<typename scalar_t> DenseMatrix<scalar_t> smooth_dense(std::size_t n) {
+  DenseMatrix<scalar_t> A(n, n);
+  for (std::size_t j=0; j<n; j++)
+    for (std::size_t i=0; i<n; i++)
+      A(i, j) = (i == j) ? scalar_t(n) :
+        scalar_t(1. / (1. + std::abs(double(i) - double(j))));
+  return A;
+}
+
+template<typename scalar_t> void run(Benchmark& b, std::size_t n, int leaf) {
+  using DenseM_t = DenseMatrix<scalar_t>;
+  using real_t = typename RealType<scalar_t>::value_type;
+  const auto s = scalar_name<scalar_t>();
+  const double cf = is_complex<scalar_t>() ? 4. : 1.;
+  const double eps = blas::lamch<real_t>('E');
+  std::mt19937 gen(1);
+  SPOptions<scalar_t> opts;
+  VectorPool<scalar_t> workspace;
+
+  // front with a separator and an update set of size n, the
+  // separator is [0,n), the update set is [n,2n)
+  const integer ds = n, du = n;
+  auto A = random_sparse<scalar_t>(ds+du, 26, gen);
+  std::vector<integer> upd(du);
+  std::iota(upd.begin(), upd.end(), ds);
+  BenchFront<scalar_t> F(0, ds, upd);
+
+  if (b.enabled("extract_front"))
+    b.run("extract_front", "", s, ds, du, 0., true, [&]() {},
+          [&]() { F.extract_front(A, 0); });
+
+  if (b.enabled("extend_add_to_dense")) {
+    // the child has a separator [2n,3n), and its update set is every
+    // other index of the parent's separator and update set
+    std::vector<integer> cupd;
+    for (integer i=0; i<ds+du; i+=2) cupd.push_back(i);
+    const std::size_t cdu = cupd.size();
+    BenchFront<scalar_t> C(ds+du, 2*ds+du, cupd);
+    DenseM_t F11(ds, ds), F12(ds, du), F21(du, ds), F22(du, du);
+    F11.zero(); F12.zero(); F21.zero(); F22.zero();
+    b.run("extend_add_to_dense", "", s, ds, cdu,
+          (is_complex<scalar_t>() ? 2. : 1.) * cdu * cdu, true,
+          [&]() { C.assemble_children(opts, workspace, 0, 0); },
+          [&]() { C.extend_add_to_dense
+              (F11, F12, F21, F22, &F, workspace, 0); });
+  }
+
+  if (b.enabled("factor_phase2")) {
+    double flops = cf * (2./3.*ds*ds*ds + 2.*ds*ds*du + 2.*ds*du*du);
+    b.run("factor_phase2", "", s, ds, du, flops, true,
+          [&]() {
+            F.extract_front(A, 0);
+            F.assemble_children(opts, workspace, 0, 0);
+          },
+          [&]() { F.factor_phase2(A, opts, 0, 0); });
+    F.release_work_memory(workspace);
+  }
+
+  const auto D = smooth_dense<scalar_t>(2*n);
+
+  if (b.enabled("BLR_construct_and_partial_factor")) {
+    BLR::BLROptions<scalar_t> bopts;
+    bopts.set_leaf_size(leaf);
+    structured::ClusterTree t1(ds), t2(du);
+    t1.refine(leaf); t2.refine(leaf);
+    auto tiles1 = t1.template leaf_sizes<std::size_t>(),
+      tiles2 = t2.template leaf_sizes<std::size_t>();
+    DenseMatrix<bool> adm(tiles1.size(), tiles1.size());
+    adm.fill(true);
+    for (std::size_t t=0; t<tiles1.size(); t++) adm(t, t) = false;
+    DenseM_t A11, A12, A21, A22;
+    auto setup = [&]() {
+      A11 = DenseM_t(ds, ds, D, 0, 0);
+      A12 = DenseM_t(ds, du, D, 0, ds);
+      A21 = DenseM_t(du, ds, D, ds, 0);
+      A22 = DenseM_t(du, du, D, ds, ds);
+    };
+    for (auto alg : {BLR::BLRFactorAlgorithm::COLWISE,
+          BLR::BLRFactorAlgorithm::RL, BLR::BLRFactorAlgorithm::LL,
+          BLR::BLRFactorAlgorithm::COMB, BLR::BLRFactorAlgorithm::STAR}) {
+      bopts.set_BLR_factor_algorithm(alg);
+      BLR::BLRMatrix<scalar_t> B11, B12, B21, B22;
+      std::function<void()> f;
+      if (alg == BLR::BLRFactorAlgorithm::COLWISE) {
+        // the column-wise algorithm assembles the front one block
+        // column at a time, here simply copied from A11/A12/A21/A22
+        f = [&]() {
+          B11 = BLR::BLRMatrix<scalar_t>(ds, tiles1, ds, tiles1);
+          B12 = BLR::BLRMatrix<scalar_t>(ds, tiles1, du, tiles2);
+          B21 = BLR::BLRMatrix<scalar_t>(du, tiles2, ds, tiles1);
+          B22 = BLR::BLRMatrix<scalar_t>(du, tiles2, du, tiles2);
+          BLR::BLRMatrix<scalar_t>::construct_and_partial_factor_col
+            (B11, B12, B21, B22, tiles1, tiles2, adm, bopts,
+             [&](int i, bool part, std::size_t CP) {
+              auto& B = part ? B11 : B22;
+              std::size_t c0 = B.tilecoff(i),
+                c1 = B.tilecoff(std::min(i+CP, B.colblocks()));
+              for (std::size_t c=c0; c<c1; c++) {
+                if (part) {
+                  for (integer r=0; r<ds; r++) B11(r, c) = A11(r, c);
+                  for (integer r=0; r<du; r++) B21(r, c) = A21(r, c);
+                } else {
+                  for (integer r=0; r<ds; r++) B12(r, c) = A12(r, c);
+                  for (integer r=0; r<du; r++) B22(r, c) = A22(r, c);
+                }
+              }
+            });
+        };
+      } else
+        f = [&]() {
+          BLR::BLRMatrix<scalar_t>::construct_and_partial_factor
+            (A11, A12, A21, A22, B11, B12, B21, tiles1, tiles2, adm, bopts);
+        };
+      auto& r = b.run("BLR_construct_and_partial_factor",
+                      BLR::get_name(alg), s, ds, du, 0., true, setup, f);
+      r.rank = std::max(B11.rank(), std::max(B12.rank(), B21.rank()));
+      r.memory = (B11.memory() + B12.memory() + B21.memory()) * 1.;
+    }
+  }
+
+  if (b.enabled("LRTile")) {
+    // off-diagonal block of the smooth matrix
+    DenseM_t T(n, n, D, n, 0);
+    BLR::BLROptions<scalar_t> bopts;
+    bopts.set_rel_tol(std::max(real_t(1e-4), real_t(100*eps)));
+    for (auto alg : {BLR::LowRankAlgorithm::RRQR, BLR::LowRankAlgorithm::ACA,
+          BLR::LowRankAlgorithm::BACA}) {
+      bopts.set_low_rank_algorithm(alg);
+      std::unique_ptr<BLR::LRTile<scalar_t>> lr;
+      std::function<void()> f;
+      if (alg == BLR::LowRankAlgorithm::BACA)
+        f = [&]() {
+          lr.reset(new BLR::LRTile<scalar_t>
+                   (n, n, [&](const std::vector<std::size_t>& I, DenseM_t& R) {
+                     T.extract_rows(I, R); },
+                     [&](const std::vector<std::size_t>& J, DenseM_t& C) {
+                       T.extract_cols(J, C); }, bopts));
+        };
+      else
+        f = [&]() { lr.reset(new BLR::LRTile<scalar_t>(T, bopts)); };
+      auto& r = b.run("LRTile", BLR::get_name(alg), s, n, n, 0., false,
+                      []() {}, f);
+      r.rank = lr->rank();
+      r.memory = lr->memory();
+    }
+  }
+
+  if (b.enabled("HSS")) {
+    HSS::HSSOptions<scalar_t> hopts;
+    hopts.set_leaf_size(leaf);
+    hopts.set_verbose(false);
+    const std::size_t m = 2*n;
+    HSS::HSSMatrix<scalar_t> H;
+    auto& r = b.run("HSS", "compress", s, m, m, 0., false,
+                    [&]() { H = HSS::HSSMatrix<scalar_t>(m, m, hopts); },
+                    [&]() { H.compress(D, hopts); });
+    r.rank = H.rank();
+    r.memory = H.memory();
+    b.run("HSS", "factor", s, m, m, 0., false,
+          [&]() { H = HSS::HSSMatrix<scalar_t>(D, hopts); },
+          [&]() { H.factor(); });
+    DenseM_t rhs(m, 1);
+    b.run("HSS", "solve", s, m, 1, 0., false,
+          [&]() { rhs.random(); }, [&]() { H.solve(rhs); });
+  }
+
+  if (b.enabled("spmv")) {
+    auto P = poisson2d<scalar_t>(n);
+    std::vector<scalar_t> x(P.size(), scalar_t(1.)), y(P.size());
+    b.run("spmv", "CSR", s, P.size(), P.nnz(), cf * 2. * P.nnz(), false,
+          []() {}, [&]() { P.spmv(x.data(), y.data()); });
+  }
+}
+
+std::vector<std::string> split(const std::string& s) {
+  std::vector<std::string> v;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ','))
+    if (!item.empty()) v.push_back(item);
+  return v;
+}
+
+int main(int argc, char* argv[]) {
+  Benchmark b;
+  std::vector<std::size_t> sizes = {256, 512, 1024};
+  std::vector<std::string> types = {"d"};
+  std::string out;
+  int leaf = 128;
+  auto usage = [&]() {
+    std::cerr
+      << "Usage: " << argv[0] << " [options]\n"
+      << "  --sizes n1,n2,..  front sizes (default 256,512,1024)\n"
+      << "  --types s,d,c,z   scalar types (default d)\n"
+      << "  --kernels k1,..   subset of extract_front, extend_add_to_dense,\n"
+      << "                    factor_phase2, BLR_construct_and_partial_factor,\n"
+      << "                    LRTile, HSS, spmv (default all)\n"
+      << "  --leaf n          BLR tile size and HSS leaf size (default 128)\n"
+      << "  --reps n          repetitions per kernel (default 5)\n"
+      << "  --out file        write the JSON results to file (default stdout)"
+      << std::endl;
+  };
+  for (int i=1; i<argc; i++) {
+    std::string a = argv[i];
+    if (i+1 >= argc) { usage(); return 1; }
+    std::string v = argv[++i];
+    if (a == "--sizes") {
+      sizes.clear();
+      for (auto& n : split(v)) sizes.push_back(std::stoul(n));
+    } else if (a == "--types") types = split(v);
+    else if (a == "--kernels") b.kernels = split(v);
+    else if (a == "--leaf") leaf = std::stoi(v);
+    else if (a == "--reps") b.reps = std::max(1, std::stoi(v));
+    else if (a == "--out") out = v;
+    else { usage(); return 1; }
+  }
+  for (auto n : sizes)
+    for (auto& t : types) {
+      if (t == "s") run<float>(b, n, leaf);
+      else if (t == "d") run<double>(b, n, leaf);
+      else if (t == "c") run<std::complex<float>>(b, n, leaf);
+      else if (t == "z") run<std::complex<double>>(b, n, leaf);
+      else { usage(); return 1; }
+    }
+  int threads = 1;
+#if defined(_OPENMP)
+  threads = omp_get_max_threads();
+#endif
+  if (out.empty()) b.write_json(std::cout, threads);
+  else {
+    std::ofstream f(out);
+    b.write_json(f, threads);
+  }
+  return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly. Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "clustering/NeighborSearch.hpp"
+#include "misc/TaskTimer.hpp"
+
+using namespace std;
+using namespace strumpack;
+
+
+// fraction of the approximate neighbors (columns samples of nbrs)
+// that are among the true k nearest neighbors
+template<typename real_t> double
+recall(const DenseMatrix<unsigned int>& nbrs,
+       const DenseMatrix<unsigned int>& exact,
+       const vector<size_t>& samples) {
+  auto k = exact.rows();
+  size_t found = 0;
+  for (size_t s=0; s<samples.size(); s++)
+    for (size_t i=0; i<k; i++)
+      for (size_t j=0; j<k; j++)
+        if (nbrs(i, samples[s]) == exact(j, s)) {
+          found++;
+          break;
+        }
+  return double(found) / (k * samples.size());
+}
+
+template<typename real_t> void
+run(size_t n, size_t d, size_t k, size_t trees, size_t leaf) {
+  // clustered random data, harder than uniform random data
+  mt19937 gen(13);
+  normal_distribution<real_t> nd(0., 1.);
+  uniform_int_distribution<size_t> uc(0, 31);
+  DenseMatrix<real_t> centers(d, 32), data(d, n);
+  for (size_t j=0; j<32; j++)
+    for (size_t i=0; i<d; i++)
+      centers(i, j) = 10 * nd(gen);
+  for (size_t j=0; j<n; j++) {
+    auto c = uc(gen);
+    for (size_t i=0; i<d; i++)
+      data(i, j) = centers(i, c) + nd(gen);
+  }
+
+  // exact neighbors for a random subset of points
+  size_t ns = min(n, size_t(1000));
+  vector<size_t> samples(ns);
+  uniform_int_distribution<size_t> up(0, n-1);
+  DenseMatrix<real_t> Q(d, ns);
+  for (size_t s=0; s<ns; s++) {
+    samples[s] = up(gen);
+    copy(data.ptr(0, samples[s]), data.ptr(0, samples[s])+d, Q.ptr(0, s));
+  }
+  DenseMatrix<unsigned int> exact;
+  DenseMatrix<real_t> exact_scores;
+  NeighborIndex<real_t> bf(data, NeighborIndexType::BRUTE_FORCE);
+  bf.query(Q, k, exact, exact_scores);
+
+  cout << "# n = " << n << ", d = " << d << ", k = " << k << endl;
+  cout << "# " << setw(12) << "method" << setw(12) << "build(s)"
+       << setw(12) << "knn(s)" << setw(14) << "points/s"
+       << setw(10) << "recall" << endl;
+  auto report = [&](const string& name, double tb, double tq,
+                    const DenseMatrix<unsigned int>& nbrs) {
+    cout << "  " << setw(12) << name << setw(12) << tb
+         << setw(12) << tq << setw(14) << size_t(n / tq)
+         << setw(10) << recall<real_t>(nbrs, exact, samples) << endl;
+  };
+
+  {
+    TaskTimer t("legacy");
+    DenseMatrix<unsigned int> nbrs;
+    DenseMatrix<real_t> scores;
+    t.start();
+    find_approximate_neighbors(data, 5, k, nbrs, scores);
+    report("legacy-ann", 0., t.elapsed(), nbrs);
+  }
+  for (auto type : {NeighborIndexType::KD_TREE,
+        NeighborIndexType::RP_FOREST}) {
+    TaskTimer tb("build"), tq("query");
+    DenseMatrix<unsigned int> nbrs;
+    DenseMatrix<real_t> scores;
+    tb.start();
+    NeighborIndex<real_t> index(data, type, leaf, trees);
+    auto build = tb.elapsed();
+    tq.start();
+    index.query_all(k, nbrs, scores);
+    report(get_name(type), build, tq.elapsed(), nbrs);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  size_t n = 100000, d = 8, k = 16, trees = 4, leaf = 0;
+  cout << "# usage: ./testNeighborSearch n d k trees leaf_size "
+       << "(trees and leaf_size for the random projection forest)" << endl;
+  if (argc > 1) n = stoul(argv[1]);
+  if (argc > 2) d = stoul(argv[2]);
+  if (argc > 3) k = stoul(argv[3]);
+  if (argc > 4) trees = stoul(argv[4]);
+  if (argc > 5) leaf = stoul(argv[5]);
+  cout << "## double precision" << endl;
+  run<double>(n, d, k, trees, leaf);
+  cout << "## single precision" << endl;
+  run<float>(n, d, k, trees, leaf);
+  return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+
+#include "StrumpackSparseSolver.hpp"
+#include "StrumpackSparseSolverBatched.hpp"
+
+typedef double scalar;
+typedef int integer;
+
+using namespace strumpack;
+
+/**
+ * Solve a batch of 2D convection-diffusion problems on an n x n
+ * grid, all with the same 5-point sparsity pattern, but with a
+ * different (random) convection velocity and shift for each system.
+ * The batched solver is compared to a SparseSolver per system.
+ */
+int main(int argc, char* argv[]) {
+  int n = 30, batch = 100;
+  if (argc > 1) n = atoi(argv[1]); // get grid size
+  else std::cout << "# please provide grid size" << std::endl;
+  if (argc > 2) batch = std::max(1, atoi(argv[2])); // nr of systems
+  std::cout << "solving " << batch << " 2D " << n << "x" << n
+            << " convection-diffusion problems" << std::endl;
+
+  integer N = n * n;
+  std::vector<integer> ptr(N+1), ind(5*N);
+  integer nnz = 0;
+  ptr[0] = 0;
+  for (integer row=0; row<n; row++) {
+    for (integer col=0; col<n; col++) {
+      integer i = col+n*row;
+      ind[nnz++] = i;
+      if (col > 0)   ind[nnz++] = i-1; // left
+      if (col < n-1) ind[nnz++] = i+1; // right
+      if (row > 0)   ind[nnz++] = i-n; // up
+      if (row < n-1) ind[nnz++] = i+n; // down
+      ptr[i+1] = nnz;
+    }
+  }
+  ind.resize(nnz);
+
+  std::default_random_engine gen;
+  std::uniform_real_distribution<double> dist(-1., 1.);
+  std::vector<scalar> val(std::size_t(batch)*nnz),
+    b(std::size_t(batch)*N), x(std::size_t(batch)*N);
+  for (int s=0; s<batch; s++) {
+    auto v = &val[std::size_t(s)*nnz];
+    double cx = .5*dist(gen), cy = .5*dist(gen), shift = 1. + dist(gen);
+    for (integer i=0; i<N; i++)
+      for (integer k=ptr[i]; k<ptr[i+1]; k++) {
+        auto j = ind[k];
+        if (j == i) v[k] = 4. + shift;
+        else if (j == i-1) v[k] = -1. - cx;
+        else if (j == i+1) v[k] = -1. + cx;
+        else if (j == i-n) v[k] = -1. - cy;
+        else v[k] = -1. + cy;
+      }
+    for (integer i=0; i<N; i++)
+      b[std::size_t(s)*N+i] = dist(gen);
+  }
+
+  SparseSolverBatched<scalar,integer> bs;
+  bs.options().set_reordering_method(ReorderingStrategy::GEOMETRIC);
+  bs.options().set_from_command_line(argc, argv);
+  bs.set_csr_pattern(N, ptr.data(), ind.data());
+  bs.reorder(n, n);
+
+  std::vector<ReturnCode> info;
+  auto t0 = std::chrono::steady_clock::now();
+  bs.factor(batch, val.data(), info);
+  bs.solve(b.data(), x.data(), info);
+  auto t1 = std::chrono::steady_clock::now();
+
+  double res = 0.;
+  for (int s=0; s<batch; s++) {
+    CSRMatrix<scalar,integer> A
+      (N, ptr.data(), ind.data(), &val[std::size_t(s)*nnz], true);
+    res = std::max
+      (res, A.max_scaled_residual(&x[std::size_t(s)*N],
+                                  &b[std::size_t(s)*N]));
+    if (info[s] != ReturnCode::SUCCESS)
+      std::cout << "# system " << s << ": " << info[s] << std::endl;
+  }
+  std::cout << "# batched solver, time = "
+            << std::chrono::duration<double>(t1 - t0).count()
+            << std::endl
+            << "# max COMPONENTWISE SCALED RESIDUAL = " << res
+            << std::endl;
+
+  t0 = std::chrono::steady_clock::now();
+  for (int s=0; s<batch; s++) {
+    SparseSolver<scalar,integer> spss(false);
+    spss.options().set_reordering_method(ReorderingStrategy::GEOMETRIC);
+    spss.options().set_from_command_line(argc, argv);
+    spss.set_csr_matrix
+      (N, ptr.data(), ind.data(), &val[std::size_t(s)*nnz], true);
+    spss.reorder(n, n);
+    spss.solve(&b[std::size_t(s)*N], &x[std::size_t(s)*N]);
+  }
+  t1 = std::chrono::steady_clock::now();
+  std::cout << "# SparseSolver per system, time = "
+            << std::chrono::duration<double>(t1 - t0).count()
+            << std::endl;
+  return 0;
+}
@@ -79,7 +79,17 @@ int main(int argc, char* argv[]) {
   A.spmv(x_exact, b);
 
   spss.set_csr_matrix(N, ptr, ind, val, true);
-  spss.reorder(n, n);
+  if (spss.options().reordering_method() == ReorderingStrategy::COORDINATE) {
+    // run with --sp_reordering_method coordinate, this works on any
+    // mesh, as long as the coordinates of the unknowns are known
+    std::vector<real> coords(2*N);
+    for (integer row=0; row<n; row++)
+      for (integer col=0; col<n; col++) {
+        coords[2*(col+n*row)] = col;
+        coords[2*(col+n*row)+1] = row;
+      }
+    spss.reorder(coords.data(), 2);
+  } else spss.reorder(n, n);
   // spss.factor();   // not really necessary, called if needed by solve
 
   spss.solve(b, x);
@@ -127,6 +127,73 @@ namespace strumpack {
           sbuf[pr[r]+pcc].push_back(CB(r,c));
     }
 
+    template<typename scalar_t,typename integer_t> void
+    BLRExtendAdd<scalar_t,integer_t>::copy_to_buffers_compressed
+    (const BLRMPI_t& CB, VVS_t& sbuf, const FBLRMPI_t* pa, const VI_t& I) {
+      if (!CB.active()) return;
+      const int lrows = CB.lrows();
+      const int lcols = CB.lcols();
+      const std::size_t pa_sep = pa->dim_sep();
+      const int nprows = pa->grid2d().nprows();
+      const int npcols = pa->grid2d().npcols();
+      // destination rank is pr[r] + pc[c] * nprows
+      std::vector<int> pr(lrows), pc(lcols);
+      for (int r=0; r<lrows; r++) {
+        auto t = I[CB.rl2g(r)];
+        pr[r] = (t < pa_sep) ? pa->sep_rg2p(t) : pa->upd_rg2p(t-pa_sep);
+      }
+      for (int c=0; c<lcols; c++) {
+        auto t = I[CB.cl2g(c)];
+        pc[c] = (t < pa_sep) ? pa->sep_cg2p(t) : pa->upd_cg2p(t-pa_sep);
+      }
+      // Each tile is split in sub-blocks, one per destination. A
+      // sub-block is sent as a header [rows, cols, rank], followed by
+      // U and V if the tile is low-rank and this is smaller than the
+      // dense sub-block, or by the dense sub-block (rank -1). The
+      // sub-blocks are sent column of tiles by column of tiles, the
+      // receiver can find the corresponding rows/columns.
+      auto g = CB.grid();
+      std::vector<VI_t> Ir(nprows), Jc(npcols);
+      for (std::size_t tc=0, c0=0; tc<CB.colblockslocal(); tc++) {
+        auto n = CB.tilecols(tc*g->npcols()+g->pcol());
+        for (auto& J : Jc) J.clear();
+        for (std::size_t c=0; c<n; c++)
+          Jc[pc[c0+c]].push_back(c);
+        for (std::size_t tr=0, r0=0; tr<CB.rowblockslocal(); tr++) {
+          auto m = CB.tilerows(tr*g->nprows()+g->prow());
+          for (auto& Ii : Ir) Ii.clear();
+          for (std::size_t r=0; r<m; r++)
+            Ir[pr[r0+r]].push_back(r);
+          auto& t = CB.ltile(tr, tc);
+          for (int b=0; b<npcols; b++) {
+            if (Jc[b].empty()) continue;
+            for (int a=0; a<nprows; a++) {
+              if (Ir[a].empty()) continue;
+              auto& buf = sbuf[a+b*nprows];
+              std::size_t nr = Ir[a].size(), nc = Jc[b].size();
+              bool lr = t.is_low_rank() && t.rank()*(nr+nc) < nr*nc;
+              buf.push_back(scalar_t(nr));
+              buf.push_back(scalar_t(nc));
+              buf.push_back(lr ? scalar_t(t.rank()) : scalar_t(-1.));
+              if (lr) {
+                if (!t.rank()) continue;
+                auto U = t.U().extract_rows(Ir[a]);
+                auto V = t.V().extract_cols(Jc[b]);
+                buf.insert(buf.end(), U.data(), U.end());
+                buf.insert(buf.end(), V.data(), V.end());
+              } else {
+                DenseM_t B(nr, nc);
+                t.extract(Ir[a], Jc[b], B);
+                buf.insert(buf.end(), B.data(), B.end());
+              }
+            }
+          }
+          r0 += m;
+        }
+        c0 += n;
+      }
+    }
+
     template<typename scalar_t,typename integer_t> void
     BLRExtendAdd<scalar_t,integer_t>::copy_to_buffers_col
     (const DistM_t& CB, VVS_t& sbuf, const FBLRMPI_t* pa, const VI_t& I,
@@ -344,6 +411,94 @@ namespace strumpack {
           F22(r_2[r],cc) += *(pbuf[upd_r_2[r]+ucc]++);
     }
 
+    template<typename scalar_t,typename integer_t> void
+    BLRExtendAdd<scalar_t,integer_t>::copy_from_buffers_compressed
+    (BLRMPI_t& F11, BLRMPI_t& F12, BLRMPI_t& F21, BLRMPI_t& F22,
+     scalar_t** pbuf, const FBLRMPI_t* pa, const FBLRMPI_t* ch) {
+      assert(pa != nullptr);
+      if (!pa->grid2d().active()) return;
+      const auto ch_dim_upd = ch->dim_upd();
+      const int chprows = ch->grid2d().nprows();
+      const int chpcols = ch->grid2d().npcols();
+      const auto& ch_upd = ch->upd();
+      const auto& pa_upd = pa->upd();
+      const auto pa_sep = pa->sep_begin();
+      // local rows/columns receiving from each process row/column of
+      // the child, as (local index, in F21/F22 or F12/F22)
+      using LI_t = std::pair<std::size_t,bool>;
+      std::vector<std::vector<LI_t>> R(chprows), C(chpcols);
+      for (int r=0, ur=0; r<int(F11.lrows()); r++) {
+        integer_t fgr = F11.rl2g(r) + pa_sep;
+        while (ur < ch_dim_upd && ch_upd[ur] < fgr) ur++;
+        if (ur == ch_dim_upd) break;
+        if (ch_upd[ur] != fgr) continue;
+        R[ch->upd_rg2p(ur)].emplace_back(r, false);
+      }
+      for (int c=0, uc=0; c<int(F11.lcols()); c++) {
+        integer_t fgc = F11.cl2g(c) + pa_sep;
+        while (uc < ch_dim_upd && ch_upd[uc] < fgc) uc++;
+        if (uc == ch_dim_upd) break;
+        if (ch_upd[uc] != fgc) continue;
+        C[ch->upd_cg2p(uc)].emplace_back(c, false);
+      }
+      for (int r=0, ur=0; r<int(F22.lrows()); r++) {
+        auto fgr = pa_upd[F22.rl2g(r)];
+        while (ur < ch_dim_upd && ch_upd[ur] < fgr) ur++;
+        if (ur == ch_dim_upd) break;
+        if (ch_upd[ur] != fgr) continue;
+        R[ch->upd_rg2p(ur)].emplace_back(r, true);
+      }
+      for (int c=0, uc=0; c<int(F22.lcols()); c++) {
+        auto fgc = pa_upd[F22.cl2g(c)];
+        while (uc < ch_dim_upd && ch_upd[uc] < fgc) uc++;
+        if (uc == ch_dim_upd) break;
+        if (ch_upd[uc] != fgc) continue;
+        C[ch->upd_cg2p(uc)].emplace_back(c, true);
+      }
+      auto add = [&](const DenseM_t& B, const LI_t* r, const LI_t* c) {
+        for (std::size_t j=0; j<B.cols(); j++)
+          for (std::size_t i=0; i<B.rows(); i++) {
+            auto lr = r[i].first, lc = c[j].first;
+            if (r[i].second) {
+              if (c[j].second) F22(lr, lc) += B(i, j);
+              else F21(lr, lc) += B(i, j);
+            } else {
+              if (c[j].second) F12(lr, lc) += B(i, j);
+              else F11(lr, lc) += B(i, j);
+            }
+          }
+      };
+      for (int b=0; b<chpcols; b++) {
+        if (C[b].empty()) continue;
+        for (int a=0; a<chprows; a++) {
+          if (R[a].empty()) continue;
+          auto& p = pbuf[a+b*chprows];
+          for (std::size_t cc=0, nc=0; cc<C[b].size(); cc+=nc) {
+            for (std::size_t rr=0, nr=0; rr<R[a].size(); rr+=nr) {
+              nr = std::size_t(std::real(p[0]));
+              nc = std::size_t(std::real(p[1]));
+              int rank = int(std::real(p[2]));
+              p += 3;
+              if (rank < 0) {
+                DenseMW_t B(nr, nc, p, nr);
+                add(B, &R[a][rr], &C[b][cc]);
+                p += nr*nc;
+              } else if (rank > 0) {
+                DenseMW_t U(nr, rank, p, nr);
+                p += nr*rank;
+                DenseMW_t V(rank, nc, p, rank);
+                p += rank*nc;
+                DenseM_t B(nr, nc);
+                gemm(Trans::N, Trans::N, scalar_t(1.), U, V,
+                     scalar_t(0.), B);
+                add(B, &R[a][rr], &C[b][cc]);
+              }
+            }
+          }
+        }
+      }
+    }
+
     template<typename scalar_t,typename integer_t> void
     BLRExtendAdd<scalar_t,integer_t>::copy_from_buffers_col
     (BLRMPI_t& F11, BLRMPI_t& F12, BLRMPI_t& F21, BLRMPI_t& F22,
@@ -43,6 +43,7 @@ namespace strumpack {
 
     template<typename scalar_t,typename integer_t> class BLRExtendAdd {
       using DenseM_t = DenseMatrix<scalar_t>;
+      using DenseMW_t = DenseMatrixWrapper<scalar_t>;
       using DistM_t = DistributedMatrix<scalar_t>;
       using BLR_t = BLRMatrix<scalar_t>;
       using BLRMPI_t = BLRMatrixMPI<scalar_t>;
@@ -59,6 +60,15 @@ namespace strumpack {
       static void
       copy_to_buffers(const BLRMPI_t& CB, VVS_t& sbuf,
                       const FBLRMPI_t* pa, const VI_t& I);
+      /**
+       * Same as copy_to_buffers, but the low-rank tiles of CB are
+       * sent as U and V factors, restricted to the rows/columns of
+       * each destination. To be received with
+       * copy_from_buffers_compressed.
+       */
+      static void
+      copy_to_buffers_compressed(const BLRMPI_t& CB, VVS_t& sbuf,
+                                 const FBLRMPI_t* pa, const VI_t& I);
       static void
       copy_to_buffers_col(const DistM_t& CB, VVS_t& sbuf,
                           const FBLRMPI_t* pa, const VI_t& I,
@@ -82,6 +92,11 @@ namespace strumpack {
                         BLRMPI_t& F21, BLRMPI_t& F22, scalar_t** pbuf,
                         const FBLRMPI_t* pa, const FBLRMPI_t* ch);
       static void
+      copy_from_buffers_compressed(BLRMPI_t& F11, BLRMPI_t& F12,
+                                   BLRMPI_t& F21, BLRMPI_t& F22,
+                                   scalar_t** pbuf, const FBLRMPI_t* pa,
+                                   const FBLRMPI_t* ch);
+      static void
       copy_from_buffers_col(BLRMPI_t& F11, BLRMPI_t& F12,
                             BLRMPI_t& F21, BLRMPI_t& F22, scalar_t** pbuf,
                             const FBLRMPI_t* pa, const FBLRMPI_t* ch,
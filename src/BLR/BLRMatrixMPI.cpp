@@ -1489,6 +1489,9 @@ namespace strumpack {
 
     template<typename scalar_t> std::vector<int>
     BLRMatrixMPI<scalar_t>::factor(const adm_t& adm, const Opts_t& opts) {
+      if (opts.lookahead() &&
+          opts.BLR_factor_algorithm() == BLRFactorAlgorithm::RL)
+        return factor_lookahead(*this, nullptr, nullptr, nullptr, adm, opts);
       std::vector<int> piv, piv_tile;
       if (!grid()->active()) return piv;
       DenseTile<scalar_t> Tii;
@@ -2088,6 +2091,325 @@ namespace strumpack {
       return piv;
     }
 
+    template<typename scalar_t> void
+    BLRMatrixMPI<scalar_t>::PanelBcast::start(const MPIComm& c, int src) {
+      if (m.empty()) return;
+      bool root = c.rank() == src;
+      std::size_t msg_size = 0;
+      if (root) {
+        ranks.clear();
+        for (auto t : T) {
+          msg_size += t->nonzeros();
+          ranks.push_back(t->is_low_rank() ? t->rank() : -1);
+        }
+      } else ranks.resize(m.size());
+      ranks.push_back(msg_size);
+      c.broadcast_from(ranks, src);
+      buf.resize(ranks.back());
+      if (root) {
+        auto ptr = buf.data();
+        for (auto t : T) {
+          if (t->is_low_rank()) {
+            ptr = std::copy(t->U().data(), t->U().end(), ptr);
+            ptr = std::copy(t->V().data(), t->V().end(), ptr);
+          } else ptr = std::copy(t->D().data(), t->D().end(), ptr);
+        }
+      }
+      c.ibroadcast_from(buf.data(), buf.size(), src, &req);
+    }
+
+    template<typename scalar_t> void
+    BLRMatrixMPI<scalar_t>::PanelBcast::finish
+    (std::vector<std::unique_ptr<BLRTile<scalar_t>>>& TA,
+     std::vector<std::unique_ptr<BLRTile<scalar_t>>>& TB) {
+      TA.clear();
+      TB.clear();
+      if (m.empty()) return;
+      MPI_Wait(&req, MPI_STATUS_IGNORE);
+      TA.reserve(nA);
+      TB.reserve(m.size() - nA);
+      auto ptr = buf.data();
+      for (std::size_t l=0; l<m.size(); l++) {
+        auto r = ranks[l];
+        auto& Tl = (l < nA) ? TA : TB;
+        if (r != -1) {
+          auto t = new LRTile<scalar_t>(m[l], n[l], r);
+          std::copy(ptr, ptr+m[l]*r, t->U().data());  ptr += m[l]*r;
+          std::copy(ptr, ptr+r*n[l], t->V().data());  ptr += r*n[l];
+          Tl.emplace_back(t);
+        } else {
+          auto t = new DenseTile<scalar_t>(m[l], n[l]);
+          std::copy(ptr, ptr+m[l]*n[l], t->D().data());  ptr += m[l]*n[l];
+          Tl.emplace_back(t);
+        }
+      }
+      T.clear();
+      std::vector<scalar_t>().swap(buf);
+    }
+
+    template<typename scalar_t> void
+    BLRMatrixMPI<scalar_t>::ibcast_row_panel
+    (const BLRMPI_t& A11, const BLRMPI_t* A12, std::size_t i,
+     PanelBcast& p) {
+      auto g = A11.grid();
+      bool root = g->is_local_row(i);
+      p.T.clear();  p.m.clear();  p.n.clear();
+      for (std::size_t j=i+1; j<A11.colblocks(); j++)
+        if (g->is_local_col(j)) {
+          if (root) p.T.push_back(&A11.tile(i, j));
+          p.m.push_back(A11.tilerows(i));
+          p.n.push_back(A11.tilecols(j));
+        }
+      p.nA = p.m.size();
+      if (A12)
+        for (std::size_t j=0; j<A12->colblocks(); j++)
+          if (g->is_local_col(j)) {
+            if (root) p.T.push_back(&A12->tile(i, j));
+            p.m.push_back(A12->tilerows(i));
+            p.n.push_back(A12->tilecols(j));
+          }
+      p.start(g->col_comm(), i % g->nprows());
+    }
+
+    template<typename scalar_t> void
+    BLRMatrixMPI<scalar_t>::ibcast_col_panel
+    (const BLRMPI_t& A11, const BLRMPI_t* A21, std::size_t i,
+     PanelBcast& p) {
+      auto g = A11.grid();
+      bool root = g->is_local_col(i);
+      p.T.clear();  p.m.clear();  p.n.clear();
+      for (std::size_t k=i+1; k<A11.rowblocks(); k++)
+        if (g->is_local_row(k)) {
+          if (root) p.T.push_back(&A11.tile(k, i));
+          p.m.push_back(A11.tilerows(k));
+          p.n.push_back(A11.tilecols(i));
+        }
+      p.nA = p.m.size();
+      if (A21)
+        for (std::size_t k=0; k<A21->rowblocks(); k++)
+          if (g->is_local_row(k)) {
+            if (root) p.T.push_back(&A21->tile(k, i));
+            p.m.push_back(A21->tilerows(k));
+            p.n.push_back(A21->tilecols(i));
+          }
+      p.start(g->row_comm(), i % g->npcols());
+    }
+
+    /**
+     * Right-looking factorization with a look-ahead of one panel.
+     * After the panel broadcasts of step i complete, the tiles in
+     * trailing block row and column i+1 are updated first. Then
+     * panel i+1 is factored and its (nonblocking) broadcast is
+     * started, before the remainder of the trailing matrix is
+     * updated with panel i. A12, A21 and A22 can be null, for the
+     * factorization of a single matrix.
+     */
+    template<typename scalar_t> std::vector<int>
+    BLRMatrixMPI<scalar_t>::factor_lookahead
+    (BLRMPI_t& A11, BLRMPI_t* A12, BLRMPI_t* A21, BLRMPI_t* A22,
+     const adm_t& adm, const Opts_t& opts) {
+      auto B1 = A11.rowblocks();
+      auto B2 = A22 ? A22->rowblocks() : 0;
+      auto g = A11.grid();
+      std::vector<int> piv, piv_tile;
+      if (!g->active()) return piv;
+      DenseTile<scalar_t> Tii;
+      auto factor_panel = [&](std::size_t i) {
+#pragma omp parallel
+        {
+#pragma omp master
+          {
+            if (g->is_local_row(i)) {
+              // LU factorization of diagonal tile
+              if (g->is_local_col(i))
+                piv_tile = A11.tile(i, i).LU();
+              else piv_tile.resize(A11.tilerows(i));
+              g->row_comm().broadcast_from(piv_tile, i % g->npcols());
+              int r0 = A11.tileroff(i);
+              std::transform
+                (piv_tile.begin(), piv_tile.end(), std::back_inserter(piv),
+                 [r0](int p) -> int { return p + r0; });
+              Tii = A11.bcast_dense_tile_along_row(i, i);
+            }
+            if (g->is_local_col(i))
+              Tii = A11.bcast_dense_tile_along_col(i, i);
+          }
+#pragma omp single
+          {
+            if (g->is_local_row(i)) {
+              for (std::size_t j=i+1; j<B1; j++) {
+                if (g->is_local_col(j) && adm(i, j)) {
+#pragma omp task default(shared) firstprivate(i,j)
+                  A11.compress_tile(i, j, opts);
+                }
+              }
+              for (std::size_t j=0; j<B2; j++) {
+                if (g->is_local_col(j)) {
+#pragma omp task default(shared) firstprivate(i,j)
+                  A12->compress_tile(i, j, opts);
+                }
+              }
+            }
+            if (g->is_local_col(i)) {
+              for (std::size_t j=i+1; j<B1; j++) {
+                if (g->is_local_row(j) && adm(j, i)) {
+#pragma omp task default(shared) firstprivate(i,j)
+                  A11.compress_tile(j, i, opts);
+                }
+              }
+              for (std::size_t j=0; j<B2; j++) {
+                if (g->is_local_row(j)) {
+#pragma omp task default(shared) firstprivate(i,j)
+                  A21->compress_tile(j, i, opts);
+                }
+              }
+            }
+          }
+        }
+#pragma omp parallel
+#pragma omp single nowait
+        {
+          if (g->is_local_row(i)) {
+            for (std::size_t j=i+1; j<B1; j++) {
+              if (g->is_local_col(j)) {
+#pragma omp task default(shared) firstprivate(i,j)
+                {
+                  A11.tile(i, j).laswp(piv_tile, true);
+                  trsm(Side::L, UpLo::L, Trans::N, Diag::U,
+                       scalar_t(1.), Tii, A11.tile(i, j));
+                }
+              }
+            }
+            for (std::size_t j=0; j<B2; j++) {
+              if (g->is_local_col(j)) {
+#pragma omp task default(shared) firstprivate(i,j)
+                {
+                  A12->tile(i, j).laswp(piv_tile, true);
+                  trsm(Side::L, UpLo::L, Trans::N, Diag::U,
+                       scalar_t(1.), Tii, A12->tile(i, j));
+                }
+              }
+            }
+          }
+          if (g->is_local_col(i)) {
+            for (std::size_t j=i+1; j<B1; j++) {
+              if (g->is_local_row(j)) {
+#pragma omp task default(shared) firstprivate(i,j)
+                trsm(Side::R, UpLo::U, Trans::N, Diag::N,
+                     scalar_t(1.), Tii, A11.tile(j, i));
+              }
+            }
+            for (std::size_t j=0; j<B2; j++) {
+              if (g->is_local_row(j)) {
+#pragma omp task default(shared) firstprivate(i,j)
+                trsm(Side::R, UpLo::U, Trans::N, Diag::N,
+                     scalar_t(1.), Tii, A21->tile(j, i));
+              }
+            }
+          }
+        }
+      };
+      using Tiles_t = std::vector<std::unique_ptr<BLRTile<scalar_t>>>;
+      // Schur complement update with panel i, either only the tiles
+      // in the look-ahead window, or only the tiles outside of it.
+      // Tile (k,j) of A22 is at (B1+k,B1+j) in [A11 A12; A21 A22].
+      auto update = [&](std::size_t i, const Tiles_t& Tij,
+                        const Tiles_t& Tij2, const Tiles_t& Tki,
+                        const Tiles_t& Tk2i, bool window) {
+        auto in = [&](std::size_t r, std::size_t c) {
+          return (r <= i+1 || c <= i+1) == window;
+        };
+#pragma omp parallel
+#pragma omp single nowait
+        {
+          for (std::size_t k=i+1, lk=0; k<B1; k++) {
+            if (g->is_local_row(k)) {
+              for (std::size_t j=i+1, lj=0; j<B1; j++) {
+                if (g->is_local_col(j)) {
+                  if (in(k, j)) {
+#pragma omp task default(shared) firstprivate(i,j,k,lk,lj)
+                    gemm(Trans::N, Trans::N, scalar_t(-1.),
+                         *(Tki[lk]), *(Tij[lj]), scalar_t(1.),
+                         A11.tile_dense(k, j).D());
+                  }
+                  lj++;
+                }
+              }
+              lk++;
+            }
+          }
+          for (std::size_t k=0, lk=0; k<B2; k++) {
+            if (g->is_local_row(k)) {
+              for (std::size_t j=i+1, lj=0; j<B1; j++) {
+                if (g->is_local_col(j)) {
+                  if (in(B1+k, j)) {
+#pragma omp task default(shared) firstprivate(i,j,k,lk,lj)
+                    gemm(Trans::N, Trans::N, scalar_t(-1.),
+                         *(Tk2i[lk]), *(Tij[lj]), scalar_t(1.),
+                         A21->tile_dense(k, j).D());
+                  }
+                  lj++;
+                }
+              }
+              lk++;
+            }
+          }
+          for (std::size_t k=i+1, lk=0; k<B1; k++) {
+            if (g->is_local_row(k)) {
+              for (std::size_t j=0, lj=0; j<B2; j++) {
+                if (g->is_local_col(j)) {
+                  if (in(k, B1+j)) {
+#pragma omp task default(shared) firstprivate(i,j,k,lk,lj)
+                    gemm(Trans::N, Trans::N, scalar_t(-1.),
+                         *(Tki[lk]), *(Tij2[lj]), scalar_t(1.),
+                         A12->tile_dense(k, j).D());
+                  }
+                  lj++;
+                }
+              }
+              lk++;
+            }
+          }
+          for (std::size_t k=0, lk=0; k<B2; k++) {
+            if (g->is_local_row(k)) {
+              for (std::size_t j=0, lj=0; j<B2; j++) {
+                if (g->is_local_col(j)) {
+                  if (in(B1+k, B1+j)) {
+#pragma omp task default(shared) firstprivate(i,j,k,lk,lj)
+                    gemm(Trans::N, Trans::N, scalar_t(-1.),
+                         *(Tk2i[lk]), *(Tij2[lj]), scalar_t(1.),
+                         A22->tile_dense(k, j).D());
+                  }
+                  lj++;
+                }
+              }
+              lk++;
+            }
+          }
+        }
+      };
+      if (!B1) return piv;
+      // double buffered, panel i+1 is in flight while the trailing
+      // matrix is updated with panel i
+      PanelBcast prow[2], pcol[2];
+      factor_panel(0);
+      ibcast_row_panel(A11, A12, 0, prow[0]);
+      ibcast_col_panel(A11, A21, 0, pcol[0]);
+      for (std::size_t i=0; i<B1; i++) {
+        Tiles_t Tij, Tij2, Tki, Tk2i;
+        prow[i%2].finish(Tij, Tij2);
+        pcol[i%2].finish(Tki, Tk2i);
+        update(i, Tij, Tij2, Tki, Tk2i, true);
+        if (i+1 < B1) {
+          factor_panel(i+1);
+          ibcast_row_panel(A11, A12, i+1, prow[(i+1)%2]);
+          ibcast_col_panel(A11, A21, i+1, pcol[(i+1)%2]);
+        }
+        update(i, Tij, Tij2, Tki, Tk2i, false);
+      }
+      return piv;
+    }
+
     template<typename scalar_t> std::vector<int>
     BLRMatrixMPI<scalar_t>::partial_factor(BLRMPI_t& A11, BLRMPI_t& A12,
                                            BLRMPI_t& A21, BLRMPI_t& A22,
@@ -2097,6 +2419,9 @@ namespace strumpack {
              A21.rows() == A22.rows() && A12.cols() == A22.cols());
       assert(A11.grid() == A12.grid() && A11.grid() == A21.grid() &&
              A11.grid() == A22.grid());
+      if (opts.lookahead() &&
+          opts.BLR_factor_algorithm() == BLRFactorAlgorithm::RL)
+        return factor_lookahead(A11, &A12, &A21, &A22, adm, opts);
       auto B1 = A11.rowblocks();
       auto B2 = A22.rowblocks();
       auto g = A11.grid();
@@ -316,6 +316,32 @@ namespace strumpack {
       bcast_col_of_tiles_along_rows(std::size_t i0, std::size_t i1,
                                     std::size_t j) const;
 
+      /**
+       * Nonblocking broadcast of a panel of tiles, packed in a single
+       * message (a header with the ranks of the tiles is broadcast
+       * first). Used for the look-ahead in the factorization.
+       */
+      struct PanelBcast {
+        std::vector<const BLRTile<scalar_t>*> T; // only on the root
+        std::vector<std::size_t> m, n;           // tile dimensions
+        std::size_t nA = 0; // number of tiles from the first matrix
+        std::vector<std::int64_t> ranks;
+        std::vector<scalar_t> buf;
+        MPI_Request req = MPI_REQUEST_NULL;
+        void start(const MPIComm& c, int src);
+        void finish(std::vector<std::unique_ptr<BLRTile<scalar_t>>>& TA,
+                    std::vector<std::unique_ptr<BLRTile<scalar_t>>>& TB);
+      };
+      static void
+      ibcast_row_panel(const BLRMPI_t& A11, const BLRMPI_t* A12,
+                       std::size_t i, PanelBcast& p);
+      static void
+      ibcast_col_panel(const BLRMPI_t& A11, const BLRMPI_t* A21,
+                       std::size_t i, PanelBcast& p);
+      static std::vector<int>
+      factor_lookahead(BLRMPI_t& A11, BLRMPI_t* A12, BLRMPI_t* A21,
+                       BLRMPI_t* A22, const adm_t& adm, const Opts_t& opts);
+
       std::vector<std::unique_ptr<BLRTile<scalar_t>>>
       gather_rows(std::size_t i0, std::size_t i1,
                   std::size_t j0, std::size_t j1) const;
@@ -96,6 +96,10 @@ namespace strumpack {
          {"blr_BACA_blocksize",        required_argument, 0, 7},
          {"blr_factor_algorithm",      required_argument, 0, 8},
          {"blr_compression_kernel",    required_argument, 0, 9},
+         {"blr_enable_lookahead",      no_argument, 0, 10},
+         {"blr_disable_lookahead",     no_argument, 0, 13},
+         {"blr_enable_compressed_extend_add",  no_argument, 0, 11},
+         {"blr_disable_compressed_extend_add", no_argument, 0, 12},
          {"blr_verbose",               no_argument, 0, 'v'},
          {"blr_quiet",                 no_argument, 0, 'q'},
          {"help",                      no_argument, 0, 'h'},
@@ -187,6 +191,10 @@ namespace strumpack {
                       << " recognized, use 'full' or 'half'."
                       << std::endl;
         } break;
+        case 10: set_lookahead(true); break;
+        case 11: set_compressed_extend_add(true); break;
+        case 12: set_compressed_extend_add(false); break;
+        case 13: set_lookahead(false); break;
         case 'v': this->set_verbose(true); break;
         case 'q': this->set_verbose(false); break;
         case 'h': describe_options(); break;
@@ -225,6 +233,16 @@ namespace strumpack {
                 << "#      should be [full|half]" << std::endl
                 << "#   --blr_BACA_blocksize int (default "
                 << BACA_blocksize() << ")" << std::endl
+                << "#   --blr_enable_lookahead (default "
+                << lookahead() << ")" << std::endl
+                << "#   --blr_disable_lookahead (default "
+                << !lookahead() << ")" << std::endl
+                << "#      look-ahead of one panel in the distributed"
+                << " RL factorization" << std::endl
+                << "#   --blr_enable_compressed_extend_add (default "
+                << compressed_extend_add() << ")" << std::endl
+                << "#   --blr_disable_compressed_extend_add (default "
+                << !compressed_extend_add() << ")" << std::endl
                 << "#   --blr_verbose or -v (default "
                 << this->verbose() << ")" << std::endl
                 << "#   --blr_quiet or -q (default "
@@ -113,12 +113,34 @@ namespace strumpack {
       void set_compression_kernel(CompressionKernel a) {
         crn_krnl_ = a;
       }
+      /**
+       * Enable look-ahead in the distributed memory (BLRMatrixMPI)
+       * right-looking (RL) factorization. The next block row and
+       * column of the trailing matrix are updated first, then the
+       * next panel is factored and its (nonblocking) broadcast is
+       * started, and it is overlapped with the rest of the trailing
+       * matrix update. This is a look-ahead of depth one: a single
+       * panel broadcast is in flight at any time.
+       */
+      void set_lookahead(bool b) { lookahead_ = b; }
+      /**
+       * Compress the contribution block of a distributed memory BLR
+       * front after its partial factorization, and send the low-rank
+       * tiles of the contribution block in compressed form (U and V
+       * factors) to the parent front during the extend-add. The
+       * parent expands the tiles locally. This reduces the
+       * communication volume of the extend-add, at the cost of an
+       * additional approximation of the contribution blocks.
+       */
+      void set_compressed_extend_add(bool b) { cmp_ea_ = b; }
 
       LowRankAlgorithm low_rank_algorithm() const { return lr_algo_; }
       Admissibility admissibility() const { return adm_; }
       int BACA_blocksize() const { return BACA_blocksize_; }
       BLRFactorAlgorithm BLR_factor_algorithm() const { return blr_algo_; }
       CompressionKernel compression_kernel() const { return crn_krnl_; }
+      bool lookahead() const { return lookahead_; }
+      bool compressed_extend_add() const { return cmp_ea_; }
 
       void set_from_command_line(int argc, const char* const* cargv) override;
 
@@ -131,6 +153,8 @@ namespace strumpack {
       Admissibility adm_ = Admissibility::WEAK;
       BLRFactorAlgorithm blr_algo_ = BLRFactorAlgorithm::RL;
       CompressionKernel crn_krnl_ = CompressionKernel::HALF;
+      bool lookahead_ = false;
+      bool cmp_ea_ = false;
 
       void set_defaults() {
         this->rel_tol_ = default_BLR_rel_tol<real_t>();
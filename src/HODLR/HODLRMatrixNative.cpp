@@ -0,0 +1,211 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <algorithm>
+#include <stdexcept>
+
+#include "HODLRMatrixNative.hpp"
+#include "StrumpackParameters.hpp"
+
+namespace strumpack {
+  namespace HODLR {
+
+    template<typename scalar_t> HODLRMatrixNative<scalar_t>::HODLRMatrixNative
+    (const structured::ClusterTree& t, const DenseM_t& A,
+     const opts_t& opts, int task_depth) : rows_(t.size) {
+      if (t.c.empty()) {
+        D_ = DenseM_t(A);
+        return;
+      }
+      std::size_t n1 = t.c[0].size, n2 = t.c[1].size;
+      auto A11 = ConstDenseMatrixWrapperPtr(n1, n1, A, 0, 0);
+      auto A12 = ConstDenseMatrixWrapperPtr(n1, n2, A, 0, n1);
+      auto A21 = ConstDenseMatrixWrapperPtr(n2, n1, A, n1, 0);
+      auto A22 = ConstDenseMatrixWrapperPtr(n2, n2, A, n1, n1);
+      bool tasked = task_depth < params::task_recursion_cutoff_level;
+#pragma omp task default(shared) if(tasked)                             \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+      A11_.reset
+        (new HODLRMatrixNative<scalar_t>(t.c[0], *A11, opts, task_depth+1));
+#pragma omp task default(shared) if(tasked)                             \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+      A22_.reset
+        (new HODLRMatrixNative<scalar_t>(t.c[1], *A22, opts, task_depth+1));
+#pragma omp task default(shared) if(tasked)                             \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+      A12->low_rank(U12_, V12_, opts.rel_tol(), opts.abs_tol(),
+                    opts.max_rank(), task_depth+1);
+      A21->low_rank(U21_, V21_, opts.rel_tol(), opts.abs_tol(),
+                    opts.max_rank(), task_depth+1);
+#pragma omp taskwait
+    }
+
+    template<typename scalar_t> std::size_t
+    HODLRMatrixNative<scalar_t>::nonzeros() const {
+      if (leaf()) return D_.nonzeros();
+      return A11_->nonzeros() + A22_->nonzeros()
+        + U12_.nonzeros() + V12_.nonzeros()
+        + U21_.nonzeros() + V21_.nonzeros()
+        + W12_.nonzeros() + W21_.nonzeros() + K_.nonzeros();
+    }
+
+    template<typename scalar_t> std::size_t
+    HODLRMatrixNative<scalar_t>::rank() const {
+      if (leaf()) return 0;
+      return std::max
+        ({A11_->rank(), A22_->rank(), V12_.rows(), V21_.rows()});
+    }
+
+    template<typename scalar_t> void HODLRMatrixNative<scalar_t>::mult
+    (Trans op, const DenseM_t& x, DenseM_t& y) const {
+      if (factored_)
+        throw std::logic_error
+          ("HODLRMatrixNative::mult is not supported after factor.");
+      if (leaf()) {
+        gemm(op, Trans::N, scalar_t(1.), D_, x, scalar_t(0.), y);
+        return;
+      }
+      std::size_t n1 = A11_->rows(), n2 = A22_->rows(), k = x.cols();
+      auto x1 = ConstDenseMatrixWrapperPtr(n1, k, x, 0, 0);
+      auto x2 = ConstDenseMatrixWrapperPtr(n2, k, x, n1, 0);
+      DenseMW_t y1(n1, k, y, 0, 0), y2(n2, k, y, n1, 0);
+      A11_->mult(op, *x1, y1);
+      A22_->mult(op, *x2, y2);
+      // y1 += A12 x2, y2 += A21 x1, or with the transposes of A21
+      // and A12 for op != N
+      auto lr_mult = [&](const DenseM_t& U, const DenseM_t& V,
+                         const DenseM_t& xi, DenseM_t& yi) {
+        if (!V.rows()) return;
+        DenseM_t tmp(V.rows(), k);
+        if (op == Trans::N) {
+          gemm(Trans::N, Trans::N, scalar_t(1.), V, xi, scalar_t(0.), tmp);
+          gemm(Trans::N, Trans::N, scalar_t(1.), U, tmp, scalar_t(1.), yi);
+        } else {
+          gemm(op, Trans::N, scalar_t(1.), U, xi, scalar_t(0.), tmp);
+          gemm(op, Trans::N, scalar_t(1.), V, tmp, scalar_t(1.), yi);
+        }
+      };
+      if (op == Trans::N) {
+        lr_mult(U12_, V12_, *x2, y1);
+        lr_mult(U21_, V21_, *x1, y2);
+      } else {
+        lr_mult(U21_, V21_, *x2, y1);
+        lr_mult(U12_, V12_, *x1, y2);
+      }
+    }
+
+    template<typename scalar_t> int HODLRMatrixNative<scalar_t>::factor
+    (real_t thresh, int task_depth) {
+      factored_ = true;
+      if (leaf()) {
+        if (!rows_) return 0;
+        int info = D_.LU(piv_, task_depth);
+        if (thresh > real_t(0.))
+          for (std::size_t i=0; i<D_.rows(); i++)
+            if (std::abs(D_(i,i)) < thresh)
+              D_(i,i) = (std::real(D_(i,i)) < 0) ? -thresh : thresh;
+        return info;
+      }
+      int info1 = 0, info2 = 0, infoK = 0;
+      bool tasked = task_depth < params::task_recursion_cutoff_level;
+#pragma omp task default(shared) if(tasked)                             \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+      {
+        info1 = A11_->factor(thresh, task_depth+1);
+        W12_ = U12_;
+        A11_->solve(W12_, task_depth+1);
+      }
+#pragma omp task default(shared) if(tasked)                             \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+      {
+        info2 = A22_->factor(thresh, task_depth+1);
+        W21_ = U21_;
+        A22_->solve(W21_, task_depth+1);
+      }
+#pragma omp taskwait
+      U12_.clear();
+      U21_.clear();
+      std::size_t r1 = V12_.rows(), r2 = V21_.rows();
+      if (r1 + r2) {
+        K_ = DenseM_t(r1+r2, r1+r2);
+        K_.eye();
+        if (r1 && r2) {
+          DenseMW_t K12(r1, r2, K_, 0, r1), K21(r2, r1, K_, r1, 0);
+          gemm(Trans::N, Trans::N, scalar_t(1.), V12_, W21_,
+               scalar_t(0.), K12, task_depth);
+          gemm(Trans::N, Trans::N, scalar_t(1.), V21_, W12_,
+               scalar_t(0.), K21, task_depth);
+        }
+        infoK = K_.LU(pivK_, task_depth);
+      }
+      return info1 ? info1 : (info2 ? info2 : infoK);
+    }
+
+    template<typename scalar_t> void HODLRMatrixNative<scalar_t>::solve
+    (DenseM_t& B, int task_depth) const {
+      if (leaf()) {
+        if (rows_) D_.solve_LU_in_place(B, piv_, task_depth);
+        return;
+      }
+      std::size_t n1 = A11_->rows(), n2 = A22_->rows(), k = B.cols();
+      DenseMW_t B1(n1, k, B, 0, 0), B2(n2, k, B, n1, 0);
+      bool tasked = task_depth < params::task_recursion_cutoff_level;
+#pragma omp task default(shared) if(tasked)                             \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+      A11_->solve(B1, task_depth+1);
+#pragma omp task default(shared) if(tasked)                             \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+      A22_->solve(B2, task_depth+1);
+#pragma omp taskwait
+      std::size_t r1 = V12_.rows(), r2 = V21_.rows();
+      if (!(r1 + r2)) return;
+      // B -= W K^{-1} [V12 B2; V21 B1]
+      DenseM_t Z(r1+r2, k);
+      DenseMW_t Z1(r1, k, Z, 0, 0), Z2(r2, k, Z, r1, 0);
+      if (r1)
+        gemm(Trans::N, Trans::N, scalar_t(1.), V12_, B2,
+             scalar_t(0.), Z1, task_depth);
+      if (r2)
+        gemm(Trans::N, Trans::N, scalar_t(1.), V21_, B1,
+             scalar_t(0.), Z2, task_depth);
+      K_.solve_LU_in_place(Z, pivK_, task_depth);
+      if (r1)
+        gemm(Trans::N, Trans::N, scalar_t(-1.), W12_, Z1,
+             scalar_t(1.), B1, task_depth);
+      if (r2)
+        gemm(Trans::N, Trans::N, scalar_t(-1.), W21_, Z2,
+             scalar_t(1.), B2, task_depth);
+    }
+
+    // explicit template instantiations
+    template class HODLRMatrixNative<float>;
+    template class HODLRMatrixNative<double>;
+    template class HODLRMatrixNative<std::complex<float>>;
+    template class HODLRMatrixNative<std::complex<double>>;
+
+  } // end namespace HODLR
+} // end namespace strumpack
@@ -0,0 +1,164 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+/**
+ * \file HODLRMatrixNative.hpp
+ * \brief Shared memory HODLR matrix, does not require
+ * ButterflyPACK or MPI.
+ */
+#ifndef STRUMPACK_HODLR_MATRIX_NATIVE_HPP
+#define STRUMPACK_HODLR_MATRIX_NATIVE_HPP
+
+#include <memory>
+#include <vector>
+
+#include "dense/DenseMatrix.hpp"
+#include "HODLROptions.hpp"
+#include "structured/ClusterTree.hpp"
+#include "structured/StructuredMatrix.hpp"
+
+namespace strumpack {
+  namespace HODLR {
+
+    /**
+     * \class HODLRMatrixNative
+     *
+     * \brief Hierarchically off-diagonal low-rank matrix, with a
+     * factorization based on the recursive Sherman-Morrison-Woodbury
+     * formula.
+     *
+     * The matrix is split recursively, according to a
+     * structured::ClusterTree, as
+     *
+     *   A = [ A11        U12*V12 ]
+     *       [ U21*V21    A22     ],
+     *
+     * where A11 and A22 are again HODLR matrices, and the leafs are
+     * stored as dense matrices. The off-diagonal blocks are
+     * compressed with a rank-revealing QR, with the relative and
+     * absolute tolerances from the HODLROptions.
+     *
+     * With D = diag(A11, A22), the factorization stores W =
+     * D^{-1}*diag(U12, U21), and the LU factors of the small matrix
+     * K = I + [0 V12; V21 0] * W, such that A^{-1} = (I - W K^{-1} [0
+     * V12; V21 0]) D^{-1}. The factorization costs O(r^2 n log^2 n),
+     * and a solve O(r n log n), for ranks r. The U12/U21 bases are
+     * released after the factorization, so mult is only supported
+     * before calling factor.
+     *
+     * This is a sequential (OpenMP tasking) alternative to the
+     * ButterflyPACK based HODLRMatrix.
+     *
+     * \tparam scalar_t Can be float, double, std:complex<float> or
+     * std::complex<double>.
+     */
+    template<typename scalar_t> class HODLRMatrixNative
+      : public structured::StructuredMatrix<scalar_t> {
+      using DenseM_t = DenseMatrix<scalar_t>;
+      using DenseMW_t = DenseMatrixWrapper<scalar_t>;
+      using real_t = typename RealType<scalar_t>::value_type;
+      using opts_t = HODLROptions<scalar_t>;
+
+    public:
+      HODLRMatrixNative() {}
+
+      /**
+       * Compress the dense matrix A as a HODLR matrix, with the
+       * hierarchical partitioning given by the cluster tree t. The
+       * matrix A is not modified.
+       *
+       * \param t cluster tree, t.size should equal A.rows()
+       * \param A dense, square input matrix
+       * \param opts tolerances and leaf size
+       * \param task_depth current OpenMP task recursion depth
+       */
+      HODLRMatrixNative(const structured::ClusterTree& t,
+                        const DenseM_t& A, const opts_t& opts,
+                        int task_depth=0);
+
+      HODLRMatrixNative(HODLRMatrixNative<scalar_t>&&) = default;
+      HODLRMatrixNative<scalar_t>&
+      operator=(HODLRMatrixNative<scalar_t>&&) = default;
+
+      std::size_t rows() const override { return rows_; }
+      std::size_t cols() const override { return rows_; }
+      std::size_t memory() const override {
+        return nonzeros() * sizeof(scalar_t);
+      }
+      std::size_t nonzeros() const override;
+      std::size_t rank() const override;
+
+      bool leaf() const { return !A11_; }
+
+      /**
+       * Multiply with this matrix, only possible before factor.
+       */
+      void mult(Trans op, const DenseM_t& x, DenseM_t& y) const override;
+
+      /**
+       * Compute the factorization.
+       */
+      void factor() override { factor(real_t(0.), 0); }
+
+      /**
+       * Compute the factorization. The leafs are factored with
+       * partial pivoting, pivots smaller than thresh (in absolute
+       * value) are replaced by thresh.
+       *
+       * \param thresh threshold for tiny pivots, ignored when 0
+       * \param task_depth current OpenMP task recursion depth
+       * \return nonzero if an exactly zero pivot was encountered,
+       * in one of the leafs (even if it was replaced by thresh), or
+       * in the LU factorization of K
+       */
+      int factor(real_t thresh, int task_depth);
+
+      /**
+       * Solve A X = B, B is overwritten with the solution X.
+       */
+      void solve(DenseM_t& B) const override { solve(B, 0); }
+
+      void solve(DenseM_t& B, int task_depth) const;
+
+    private:
+      std::size_t rows_ = 0;
+      bool factored_ = false;
+      // leaf, LU factors when factored
+      DenseM_t D_;
+      std::vector<int> piv_;
+      // internal node
+      std::unique_ptr<HODLRMatrixNative<scalar_t>> A11_, A22_;
+      DenseM_t U12_, V12_, U21_, V21_;
+      // W12 = A11^{-1} U12, W21 = A22^{-1} U21, K = LU(I + V W)
+      DenseM_t W12_, W21_, K_;
+      std::vector<int> pivK_;
+    };
+
+  } // end namespace HODLR
+} // end namespace strumpack
+
+#endif // STRUMPACK_HODLR_MATRIX_NATIVE_HPP
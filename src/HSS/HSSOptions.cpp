@@ -167,9 +167,12 @@ namespace strumpack {
             set_random_engine(random::RandomEngine::LINEAR);
           else if (s.compare("mersenne") == 0)
             set_random_engine(random::RandomEngine::MERSENNE);
+          else if (s.compare("philox") == 0)
+            set_random_engine(random::RandomEngine::PHILOX);
           else
             std::cerr << "# WARNING: random number engine not recognized,"
-                      << " use 'linear' or 'mersenne'." << std::endl;
+                      << " use 'linear', 'mersenne' or 'philox'."
+                      << std::endl;
         } break;
         case 12: {
           std::istringstream iss(optarg);
@@ -259,7 +262,7 @@ namespace strumpack {
                 << this->max_rank() << ")" << std::endl
                 << "#   --hss_random_distribution normal|uniform (default "
                 << get_name(random_distribution()) << ")" << std::endl
-                << "#   --hss_random_engine linear|mersenne (default "
+                << "#   --hss_random_engine linear|mersenne|philox (default "
                 << get_name(random_engine()) << ")" << std::endl
                 << "#   --hss_compression_algorithm original|stable|hard_restart (default "
                 << get_name(compression_algorithm()) << ")" << std::endl
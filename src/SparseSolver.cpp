@@ -26,6 +26,10 @@
  *             Division).
  */
 
+#include <numeric>
+#include <chrono>
+#include <algorithm>
+
 #include "StrumpackSparseSolver.hpp"
 
 #if defined(STRUMPACK_USE_PAPI)
@@ -72,8 +76,22 @@ namespace strumpack {
   (const int* p, int base, int nx, int ny, int nz,
    int components, int width) {
     if (p) return nd_->set_permutation(opts_, *mat_, p, base);
-    return nd_->nested_dissection
-      (opts_, *mat_, nx, ny, nz, components, width);
+    std::string fname;
+    if (!opts_.ordering_cache().empty()) {
+      fname = nd_->cache_file
+        (opts_, *mat_, nx, ny, nz, components, width,
+         coords_, coords_dim_);
+      if (!nd_->read_cache(opts_, *mat_, fname)) return 0;
+    }
+    int ierr = 0;
+    if (coords_ &&
+        opts_.reordering_method() == ReorderingStrategy::COORDINATE)
+      ierr = nd_->nested_dissection(opts_, *mat_, coords_, coords_dim_);
+    else ierr = nd_->nested_dissection
+           (opts_, *mat_, nx, ny, nz, components, width);
+    if (!ierr && !fname.empty())
+      nd_->write_cache(opts_, *mat_, fname);
+    return ierr;
   }
 
   template<typename scalar_t,typename integer_t> void
@@ -86,6 +104,7 @@ namespace strumpack {
   (const CSRMatrix<scalar_t,integer_t>& A) {
     mat_.reset(new CSRMatrix<scalar_t,integer_t>(A));
     factored_ = reordered_ = false;
+    scatter_.clear();
   }
 
   template<typename scalar_t,typename integer_t> void
@@ -96,6 +115,8 @@ namespace strumpack {
       this->print_wrong_sparsity_error();
       return;
     }
+    if (scatter_matrix_values(A.size(), A.ptr(), A.ind(), A.val()))
+      return;
     mat_.reset(new CSRMatrix<scalar_t,integer_t>(A));
     permute_matrix_values();
   }
@@ -107,6 +128,7 @@ namespace strumpack {
     mat_.reset(new CSRMatrix<scalar_t,integer_t>
                (N, row_ptr, col_ind, values, symmetric_pattern));
     factored_ = reordered_ = false;
+    scatter_.clear();
   }
 
   template<typename scalar_t,typename integer_t> void
@@ -118,6 +140,8 @@ namespace strumpack {
       this->print_wrong_sparsity_error();
       return;
     }
+    if (scatter_matrix_values(N, row_ptr, col_ind, values))
+      return;
     mat_.reset(new CSRMatrix<scalar_t,integer_t>
                (N, row_ptr, col_ind, values, symmetric_pattern));
     permute_matrix_values();
@@ -129,13 +153,92 @@ namespace strumpack {
       matrix()->apply_matching(matching_);
       matrix()->equilibrate(equil_);
       matrix()->symmetrize_sparsity();
-      matrix()->permute(reordering()->iperm(), reordering()->perm());
+      if (opts_.permute_in_place())
+        matrix()->permute_in_place
+          (reordering()->iperm(), reordering()->perm());
+      else
+        matrix()->permute(reordering()->iperm(), reordering()->perm());
       if (opts_.compression() != CompressionType::NONE)
         separator_reordering();
     }
     factored_ = false;
   }
 
+  template<typename scalar_t,typename integer_t> bool
+  SparseSolver<scalar_t,integer_t>::setup_value_scatter
+  (integer_t N, const integer_t* row_ptr, const integer_t* col_ind) {
+    scatter_.clear();
+    // the separator reordering is recomputed for every update
+    if (!reordered_ || opts_.compression() != CompressionType::NONE)
+      return false;
+    auto nnz = row_ptr[N];
+    auto& perm = reordering()->perm();
+    const auto Aptr = mat_->ptr();
+    const auto Aind = mat_->ind();
+    // column permutation from the matching, see permute_columns
+    std::vector<integer_t> Qi(N);
+    if (matching_.job == MatchingJob::NONE)
+      std::iota(Qi.begin(), Qi.end(), 0);
+    else
+      for (integer_t i=0; i<N; i++) Qi[matching_.Q[i]] = i;
+    std::vector<real_t> Dr(N, real_t(1.)), Dc(N, real_t(1.));
+    if (matching_.job == MatchingJob::MAX_DIAGONAL_PRODUCT_SCALING)
+      for (integer_t i=0; i<N; i++) {
+        Dr[i] = matching_.R[i];
+        Dc[i] = matching_.C[i];
+      }
+    // equilibration is applied after the column permutation
+    if (equil_.type == EquilibrationType::ROW ||
+        equil_.type == EquilibrationType::BOTH)
+      for (integer_t i=0; i<N; i++) Dr[i] *= equil_.R[i];
+    if (equil_.type == EquilibrationType::COLUMN ||
+        equil_.type == EquilibrationType::BOTH)
+      for (integer_t i=0; i<N; i++) Dc[i] *= equil_.C[Qi[i]];
+    std::vector<integer_t> sc(nnz);
+    bool ok = true;
+#pragma omp parallel for reduction(&&:ok)
+    for (integer_t r=0; r<N; r++) {
+      auto pr = perm[r];
+      auto b = Aind + Aptr[pr], e = Aind + Aptr[pr+1];
+      for (integer_t k=row_ptr[r]; k<row_ptr[r+1]; k++) {
+        auto c = perm[Qi[col_ind[k]]];
+        auto p = std::lower_bound(b, e, c);
+        if (p == e || *p != c) ok = false;
+        else sc[k] = p - Aind;
+      }
+    }
+    if (!ok) return false;
+    // entries not covered by the input pattern (symmetrization) are 0
+    std::fill(mat_->val(), mat_->val()+mat_->nnz(), scalar_t(0.));
+    std::swap(scatter_, sc);
+    std::swap(scatter_Dr_, Dr);
+    std::swap(scatter_Dc_, Dc);
+    return true;
+  }
+
+  template<typename scalar_t,typename integer_t> bool
+  SparseSolver<scalar_t,integer_t>::scatter_matrix_values
+  (integer_t N, const integer_t* row_ptr, const integer_t* col_ind,
+   const scalar_t* values) {
+    if (!reordered_ || opts_.compression() != CompressionType::NONE ||
+        N != mat_->size())
+      return false;
+    if (scatter_.size() != std::size_t(row_ptr[N]) &&
+        !setup_value_scatter(N, row_ptr, col_ind))
+      return false;
+    auto Aval = mat_->val();
+#pragma omp parallel for
+    for (integer_t r=0; r<N; r++) {
+      auto dr = scatter_Dr_[r];
+      for (integer_t k=row_ptr[r]; k<row_ptr[r+1]; k++)
+        Aval[scatter_[k]] = values[k] * (dr * scatter_Dc_[col_ind[k]]);
+    }
+    STRUMPACK_FLOPS((is_complex<scalar_t>()?2:1)*
+                    static_cast<long long int>(2.*double(scatter_.size())));
+    factored_ = false;
+    return true;
+  }
+
   template<typename scalar_t,typename integer_t> ReturnCode
   SparseSolver<scalar_t,integer_t>::solve_internal
   (const scalar_t* b, scalar_t* x, bool use_initial_guess) {
@@ -147,7 +250,7 @@ namespace strumpack {
 
   template<typename scalar_t,typename integer_t> void
   SparseSolver<scalar_t,integer_t>::transform_x0
-  (DenseM_t& x, DenseM_t& xtmp) {
+  (DenseM_t& x, DenseM_t& xtmp) const {
     integer_t N = matrix()->size(), d = x.cols();
     auto& P = reordering()->iperm();
     if (opts_.matching() == MatchingJob::MAX_DIAGONAL_PRODUCT_SCALING)
@@ -176,7 +279,7 @@ namespace strumpack {
 
   template<typename scalar_t,typename integer_t> void
   SparseSolver<scalar_t,integer_t>::transform_x
-  (DenseM_t& x, DenseM_t& xtmp) {
+  (DenseM_t& x, DenseM_t& xtmp) const {
     integer_t N = matrix()->size(), d = x.cols();
     auto& Pi = reordering()->perm();
     for (integer_t j=0; j<d; j++)
@@ -206,7 +309,7 @@ namespace strumpack {
 
   template<typename scalar_t,typename integer_t> void
   SparseSolver<scalar_t,integer_t>::transform_b
-  (const DenseM_t& b, DenseM_t& bloc) {
+  (const DenseM_t& b, DenseM_t& bloc) const {
     using real_t = typename RealType<scalar_t>::value_type;
     integer_t N = matrix()->size(), d = b.cols();
     auto& P = reordering()->iperm();
@@ -251,13 +354,50 @@ namespace strumpack {
       if (ierr != ReturnCode::SUCCESS) return ierr;
     }
 
+    SolveContext<scalar_t> ctx;
+    auto ierr = solve(b, x, ctx, use_initial_guess);
+    Krylov_its_ = ctx.Krylov_iterations();
+
+    t.stop();
+    this->perf_counters_stop("DIRECT/GMRES solve");
+    this->print_solve_stats(t);
+    return ierr;
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  SparseSolver<scalar_t,integer_t>::solve
+  (const scalar_t* b, scalar_t* x, SolveContext<scalar_t>& ctx,
+   bool use_initial_guess) const {
+    if (!mat_) return ReturnCode::MATRIX_NOT_SET;
+    auto N = matrix()->size();
+    auto B = ConstDenseMatrixWrapperPtr(N, 1, b, N);
+    DenseMW_t X(N, 1, x, N);
+    return solve(*B, X, ctx, use_initial_guess);
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  SparseSolver<scalar_t,integer_t>::solve
+  (const DenseM_t& b, DenseM_t& x, SolveContext<scalar_t>& ctx,
+   bool use_initial_guess) const {
+    // not a TaskTimer, it logs to a global (per thread) list
+    auto t0 = std::chrono::steady_clock::now();
+    assert(b.cols() == x.cols());
+    // the non-preconditioned solvers only need the reordering
+    const bool prec = opts_.Krylov_solver() != KrylovSolver::GMRES &&
+      opts_.Krylov_solver() != KrylovSolver::BICGSTAB;
+    if (!mat_ || !this->reordered_ || (prec && !this->factored_))
+      return ReturnCode::MATRIX_NOT_SET;
+
     integer_t d = b.cols();
     assert(matrix()->size() < std::numeric_limits<int>::max());
-    DenseM_t bloc(b.rows(), d);
+    auto& bloc = ctx.bloc_;
+    if (bloc.rows() != b.rows() || bloc.cols() != std::size_t(d))
+      bloc = DenseM_t(b.rows(), d);
 
     auto spmv = [&](const scalar_t* x, scalar_t* y)
                 { matrix()->spmv(x, y); };
-    Krylov_its_ = 0;
+    int& its = ctx.Krylov_its_;
+    its = 0;
 
     if (use_initial_guess &&
         opts_.Krylov_solver() != KrylovSolver::DIRECT)
@@ -275,14 +415,14 @@ namespace strumpack {
       if (opts_.compression() != CompressionType::NONE && x.cols() == 1)
         iterative::GMRes<scalar_t>
           (spmv, MFsolve, x.rows(), x.data(), bloc.data(),
-           opts_.rel_tol(), opts_.abs_tol(), Krylov_its_, opts_.maxit(),
+           opts_.rel_tol(), opts_.abs_tol(), its, opts_.maxit(),
            opts_.gmres_restart(), opts_.GramSchmidt_type(),
            use_initial_guess, opts_.verbose() && is_root_);
       else
         iterative::IterativeRefinement<scalar_t,integer_t>
           (*matrix(), [&](DenseM_t& w) { tree()->multifrontal_solve(w); },
            x, bloc, opts_.rel_tol(), opts_.abs_tol(),
-           Krylov_its_, opts_.maxit(), use_initial_guess,
+           its, opts_.maxit(), use_initial_guess,
            opts_.verbose() && is_root_);
     }; break;
     case KrylovSolver::DIRECT: {
@@ -293,14 +433,14 @@ namespace strumpack {
       iterative::IterativeRefinement<scalar_t,integer_t>
         (*matrix(), [&](DenseM_t& w) { tree()->multifrontal_solve(w); },
          x, bloc, opts_.rel_tol(), opts_.abs_tol(),
-         Krylov_its_, opts_.maxit(), use_initial_guess,
+         its, opts_.maxit(), use_initial_guess,
          opts_.verbose() && is_root_);
     }; break;
     case KrylovSolver::PREC_GMRES: {
       assert(x.cols() == 1);
       iterative::GMRes<scalar_t>
         (spmv, MFsolve, x.rows(), x.data(), bloc.data(),
-         opts_.rel_tol(), opts_.abs_tol(), Krylov_its_, opts_.maxit(),
+         opts_.rel_tol(), opts_.abs_tol(), its, opts_.maxit(),
          opts_.gmres_restart(), opts_.GramSchmidt_type(),
          use_initial_guess, opts_.verbose() && is_root_);
     }; break;
@@ -308,14 +448,30 @@ namespace strumpack {
       assert(x.cols() == 1);
       iterative::BiCGStab<scalar_t>
         (spmv, MFsolve, x.rows(), x.data(), bloc.data(),
-         opts_.rel_tol(), opts_.abs_tol(), Krylov_its_, opts_.maxit(),
+         opts_.rel_tol(), opts_.abs_tol(), its, opts_.maxit(),
+         use_initial_guess, opts_.verbose() && is_root_);
+    }; break;
+    case KrylovSolver::PREC_SSTEP_GMRES: {
+      assert(x.cols() == 1);
+      iterative::SStepGMRes<scalar_t>
+        (spmv, MFsolve, x.rows(), x.data(), bloc.data(),
+         opts_.rel_tol(), opts_.abs_tol(), its, opts_.maxit(),
+         opts_.gmres_restart(), opts_.gmres_sstep(),
+         use_initial_guess, opts_.verbose() && is_root_);
+    }; break;
+    case KrylovSolver::PREC_FGMRES: {
+      assert(x.cols() == 1);
+      iterative::FGMRes<scalar_t>
+        (spmv, MFsolve, x.rows(), x.data(), bloc.data(),
+         opts_.rel_tol(), opts_.abs_tol(), its, opts_.maxit(),
+         opts_.gmres_restart(), opts_.GramSchmidt_type(),
          use_initial_guess, opts_.verbose() && is_root_);
     }; break;
     case KrylovSolver::GMRES: { // see above
       assert(x.cols() == 1);
       iterative::GMRes<scalar_t>
         (spmv, [](scalar_t* x) {}, x.rows(), x.data(), bloc.data(),
-         opts_.rel_tol(), opts_.abs_tol(), Krylov_its_, opts_.maxit(),
+         opts_.rel_tol(), opts_.abs_tol(), its, opts_.maxit(),
          opts_.gmres_restart(), opts_.GramSchmidt_type(),
          use_initial_guess, opts_.verbose() && is_root_);
     }; break;
@@ -323,15 +479,65 @@ namespace strumpack {
       assert(x.cols() == 1);
       iterative::BiCGStab<scalar_t>
         (spmv, [](scalar_t* x) {}, x.rows(), x.data(), bloc.data(),
-         opts_.rel_tol(), opts_.abs_tol(), Krylov_its_, opts_.maxit(),
+         opts_.rel_tol(), opts_.abs_tol(), its, opts_.maxit(),
          use_initial_guess, opts_.verbose() && is_root_);
     }
     }
     transform_x(x, bloc);
 
-    t.stop();
-    this->perf_counters_stop("DIRECT/GMRES solve");
-    this->print_solve_stats(t);
+    ctx.time_ = std::chrono::duration<double>
+      (std::chrono::steady_clock::now() - t0).count();
+    return ReturnCode::SUCCESS;
+  }
+
+  template<typename scalar_t,typename integer_t>
+  template<typename refine_t> ReturnCode
+  SparseSolver<scalar_t,integer_t>::apply_factors
+  (DenseMatrix<refine_t>& w, DenseM_t& work) {
+    using real_t = typename RealType<scalar_t>::value_type;
+    if (!this->reordered_) {
+      ReturnCode ierr = this->reorder();
+      if (ierr != ReturnCode::SUCCESS) return ierr;
+    }
+    if (!this->factored_) {
+      ReturnCode ierr = this->factor();
+      if (ierr != ReturnCode::SUCCESS) return ierr;
+    }
+    integer_t N = matrix()->size(), d = w.cols();
+    if (work.rows() != std::size_t(N) || work.cols() != std::size_t(d))
+      work = DenseM_t(N, d);
+    const auto& P = reordering()->iperm();
+    const auto& Pi = reordering()->perm();
+    const bool eqR = equil_.type == EquilibrationType::ROW ||
+      equil_.type == EquilibrationType::BOTH;
+    const bool eqC = equil_.type == EquilibrationType::COLUMN ||
+      equil_.type == EquilibrationType::BOTH;
+    const bool mcR = reordered_ &&
+      opts_.matching() == MatchingJob::MAX_DIAGONAL_PRODUCT_SCALING;
+    const bool mcC =
+      opts_.matching() == MatchingJob::MAX_DIAGONAL_PRODUCT_SCALING;
+    const bool mcQ = opts_.matching() != MatchingJob::NONE;
+    // same as transform_b, fused with the conversion to scalar_t
+    for (integer_t j=0; j<d; j++)
+#pragma omp parallel for
+      for (integer_t i=0; i<N; i++) {
+        auto p = P[i];
+        real_t r(1.);
+        if (eqR) r *= equil_.R[p];
+        if (mcR) r *= matching_.R[p];
+        work(i, j) = r * static_cast<scalar_t>(w(p, j));
+      }
+    tree()->multifrontal_solve(work);
+    // same as transform_x, fused with the conversion to refine_t
+    for (integer_t j=0; j<d; j++)
+#pragma omp parallel for
+      for (integer_t i=0; i<N; i++) {
+        auto xi = work(Pi[i], j);
+        if (eqC) xi = equil_.C[i] * xi;
+        auto r = mcQ ? matching_.Q[i] : i;
+        if (mcC) xi = matching_.C[r] * xi;
+        w(r, j) = static_cast<refine_t>(xi);
+      }
     return ReturnCode::SUCCESS;
   }
 
@@ -356,4 +562,19 @@ namespace strumpack {
   template class SparseSolver<std::complex<float>,long long int>;
   template class SparseSolver<std::complex<double>,long long int>;
 
+  template ReturnCode SparseSolver<float,int>::apply_factors
+  (DenseMatrix<double>& w, DenseMatrix<float>& work);
+  template ReturnCode SparseSolver<std::complex<float>,int>::apply_factors
+  (DenseMatrix<std::complex<double>>& w, DenseMatrix<std::complex<float>>& work);
+
+  template ReturnCode SparseSolver<float,long int>::apply_factors
+  (DenseMatrix<double>& w, DenseMatrix<float>& work);
+  template ReturnCode SparseSolver<std::complex<float>,long int>::apply_factors
+  (DenseMatrix<std::complex<double>>& w, DenseMatrix<std::complex<float>>& work);
+
+  template ReturnCode SparseSolver<float,long long int>::apply_factors
+  (DenseMatrix<double>& w, DenseMatrix<float>& work);
+  template ReturnCode SparseSolver<std::complex<float>,long long int>::apply_factors
+  (DenseMatrix<std::complex<double>>& w, DenseMatrix<std::complex<float>>& work);
+
 } //end namespace strumpack
@@ -134,6 +134,29 @@ namespace strumpack {
     return tree()->factor_nonzeros() * sizeof(scalar_t);
   }
 
+  template<typename scalar_t,typename integer_t> MemoryReport
+  SparseSolverBase<scalar_t,integer_t>::memory_report() const {
+    MemoryReport r = mem_report_;
+    if (reordered_) tree()->memory_report(r);
+    return r;
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  SparseSolverBase<scalar_t,integer_t>::memory_phase_start() const {
+#if defined(STRUMPACK_COUNT_FLOPS)
+    params::phase_peak_memory = params::memory.load();
+#endif
+  }
+
+  template<typename scalar_t,typename integer_t> long long
+  SparseSolverBase<scalar_t,integer_t>::memory_phase_peak() const {
+#if defined(STRUMPACK_COUNT_FLOPS)
+    return params::phase_peak_memory.load();
+#else
+    return 0;
+#endif
+  }
+
   template<typename scalar_t,typename integer_t> int
   SparseSolverBase<scalar_t,integer_t>::Krylov_iterations() const {
     return Krylov_its_;
@@ -311,12 +334,33 @@ namespace strumpack {
     return reorder_internal(p, base, 1, 1, 1, 1, 1);
   }
 
+  template<typename scalar_t,typename integer_t> ReturnCode
+  SparseSolverBase<scalar_t,integer_t>::reorder
+  (const real_t* coords, int d) {
+    coords_ = coords;
+    coords_dim_ = d;
+    auto ierr = reorder_internal(nullptr, 0, 1, 1, 1, 1, 1);
+    coords_ = nullptr;
+    coords_dim_ = 0;
+    return ierr;
+  }
+
   template<typename scalar_t,typename integer_t> ReturnCode
   SparseSolverBase<scalar_t,integer_t>::reorder_internal
   (const int* p, int base, int nx, int ny, int nz,
    int components, int width) {
     if (!matrix()) return ReturnCode::MATRIX_NOT_SET;
     if (reordered_) return ReturnCode::SUCCESS;
+    // check this before the matrix is scaled and permuted, so that
+    // reorder(coords, d) can still be called after this error
+    if (!p && (!coords_ || coords_dim_ < 1) &&
+        opts_.reordering_method() == ReorderingStrategy::COORDINATE) {
+      if (is_root_)
+        std::cerr << "# ERROR: coordinate ordering requires the"
+          " coordinates, use reorder(coords, d)." << std::endl;
+      return ReturnCode::REORDERING_ERROR;
+    }
+    memory_phase_start();
     TaskTimer t1("permute-scale");
     int ierr;
     if (opts_.verbose() && is_root_)
@@ -364,7 +408,10 @@ namespace strumpack {
                 << ierr << std::endl;
       return ReturnCode::REORDERING_ERROR;
     }
-    matrix()->permute(reordering()->iperm(), reordering()->perm());
+    if (opts_.permute_in_place())
+      matrix()->permute_in_place(reordering()->iperm(), reordering()->perm());
+    else
+      matrix()->permute(reordering()->iperm(), reordering()->perm());
     t3.stop();
     if (opts_.verbose() && is_root_) {
       std::cout << "#   - nd time = " << t3.elapsed() << std::endl;
@@ -374,7 +421,9 @@ namespace strumpack {
                 << std::endl;
     }
     perf_counters_stop("nested dissection");
+    mem_report_.reordering = memory_phase_peak();
 
+    memory_phase_start();
     perf_counters_start();
     TaskTimer t0("symbolic-factorization", [&](){ setup_tree(); });
     /* do not clear the tree data, because if we update the matrix
@@ -386,12 +435,21 @@ namespace strumpack {
         std::cout << "# symbolic factorization:" << std::endl;
         std::cout << "#   - nr of dense Frontal matrices = "
                   << number_format_with_commas(fc.dense) << std::endl;
+        if (opts_.front_amalgamation_fill() > 0)
+          std::cout << "#   - amalgamation merged "
+                    << number_format_with_commas
+                    (tree()->amalgamated_fronts())
+                    << " fronts, added "
+                    << number_format_with_commas
+                    (tree()->amalgamation_zeros())
+                    << " zeros" << std::endl;
         switch (opts_.compression()) {
         case CompressionType::HSS:
           std::cout << "#   - nr of HSS Frontal matrices = "
                     << number_format_with_commas(fc.HSS) << std::endl;
           break;
         case CompressionType::BLR:
+        case CompressionType::AUTO:
           std::cout << "#   - nr of BLR Frontal matrices = "
                     << number_format_with_commas(fc.BLR) << std::endl;
           break;
@@ -432,9 +490,10 @@ namespace strumpack {
         if (opts_.compression() == CompressionType::HODLR ||
             opts_.compression() == CompressionType::BLR_HODLR ||
             opts_.compression() == CompressionType::ZFP_BLR_HODLR) {
-          std::cerr << "WARNING: Compression type requires ButterflyPACK, "
-            "but STRUMPACK was not configured with ButterflyPACK support!"
-                    << std::endl;
+          std::cerr << "WARNING: STRUMPACK was not configured with "
+            "ButterflyPACK support, using the shared memory HODLR "
+            "code, without butterfly compression, and with dense "
+            "fronts for distributed memory!" << std::endl;
         }
 #endif
 #if !defined(STRUMPACK_USE_ZFP)
@@ -455,6 +514,7 @@ namespace strumpack {
                   << t4.elapsed() << std::endl;
       perf_counters_stop("separator reordering");
     }
+    mem_report_.symbolic = memory_phase_peak();
 
     reordered_ = true;
     return ReturnCode::SUCCESS;
@@ -572,6 +632,7 @@ namespace strumpack {
     }
     perf_counters_start();
     flop_breakdown_reset();
+    memory_phase_start();
     ReturnCode err_code;
     TaskTimer t1("Sparse-factorization", [&]() {
       // TODO add shift if opts_.replace...
@@ -580,6 +641,7 @@ namespace strumpack {
       err_code = tree()->multifrontal_factorization(*matrix(), opts_);
     });
     perf_counters_stop("numerical factorization");
+    mem_report_.factor = memory_phase_peak();
     if (opts_.verbose()) {
       auto fnnz = factor_nonzeros();
       auto max_rank = maximum_rank();
@@ -626,13 +688,13 @@ namespace strumpack {
                       << get_name(opts_.HSS_options().random_engine())
                       << " engine" << std::endl;
           }
-          if (opts_.compression() == CompressionType::BLR) {
+          if (opts_.compression() == CompressionType::BLR ||
+              opts_.compression() == CompressionType::AUTO) {
             std::cout << "#   - BLR relative compression tolerance = "
                       << opts_.BLR_options().rel_tol() << std::endl;
             std::cout << "#   - BLR absolute compression tolerance = "
                       << opts_.BLR_options().abs_tol() << std::endl;
           }
-#if defined(STRUMPACK_USE_BPACK)
           if (opts_.compression() == CompressionType::HODLR) {
             std::cout << "#   - maximum HODLR rank = " << max_rank << std::endl;
             std::cout << "#   - relative compression tolerance = "
@@ -650,8 +712,6 @@ namespace strumpack {
             std::cout << "#   - BLR absolute compression tolerance = "
                       << opts_.BLR_options().abs_tol() << std::endl;
           }
-#endif
-#if defined(STRUMPACK_USE_BPACK)
 #if defined(STRUMPACK_USE_ZFP)
           if (opts_.compression() == CompressionType::ZFP_BLR_HODLR) {
             std::cout << "#   - maximum HODLR rank = " << max_rank << std::endl;
@@ -665,7 +725,6 @@ namespace strumpack {
                       << opts_.BLR_options().abs_tol() << std::endl;
           }
 #endif
-#endif
 #if defined(STRUMPACK_USE_ZFP)
           if (opts_.compression() == CompressionType::LOSSY)
             std::cout << "#   - lossy compression precision = "
@@ -684,13 +743,19 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> ReturnCode
   SparseSolverBase<scalar_t,integer_t>::solve
   (const scalar_t* b, scalar_t* x, bool use_initial_guess) {
-    return solve_internal(b, x, use_initial_guess);
+    memory_phase_start();
+    auto ierr = solve_internal(b, x, use_initial_guess);
+    mem_report_.solve = memory_phase_peak();
+    return ierr;
   }
 
   template<typename scalar_t,typename integer_t> ReturnCode
   SparseSolverBase<scalar_t,integer_t>::solve
   (const DenseM_t& b, DenseM_t& x, bool use_initial_guess) {
-    return solve_internal(b, x, use_initial_guess);
+    memory_phase_start();
+    auto ierr = solve_internal(b, x, use_initial_guess);
+    mem_report_.solve = memory_phase_peak();
+    return ierr;
   }
 
   template<typename scalar_t,typename integer_t> ReturnCode
@@ -82,6 +82,7 @@ namespace strumpack {
     using Reord_t = MatrixReordering<scalar_t,integer_t>;
     using DenseM_t = DenseMatrix<scalar_t>;
     using DenseMW_t = DenseMatrixWrapper<scalar_t>;
+    using real_t = typename RealType<scalar_t>::value_type;
 
   public:
 
@@ -167,6 +168,24 @@ namespace strumpack {
      */
     ReturnCode reorder(const int* p, int base=0);
 
+    /**
+     * Perform sparse matrix reordering, using the coordinates of the
+     * unknowns. This is meant for matrices from unstructured meshes,
+     * with ReorderingStrategy::COORDINATE, see
+     * SPOptions::set_reordering_method and
+     * SPOptions::set_coordinate_ND_clustering. With any other
+     * reordering method, the coordinates are ignored. Not supported
+     * for the distributed memory solver.
+     *
+     * \param coords coordinates of the unknowns, a d x N column
+     * major array, with N the size of the sparse matrix, ie, the
+     * coordinates of unknown i are coords[i*d], ...,
+     * coords[i*d+d-1]. This is only used during this call.
+     * \param d number of spatial dimensions, d >= 1
+     * \return error code
+     */
+    ReturnCode reorder(const real_t* coords, int d);
+
     /**
      * Perform numerical factorization of the sparse input matrix.
      *
@@ -335,6 +354,24 @@ namespace strumpack {
      */
     std::size_t factor_memory() const;
 
+    /**
+     * Return a breakdown of the memory usage: the peak memory during
+     * the reordering, symbolic factorization, numerical
+     * factorization and the last solve (only when STRUMPACK was
+     * built with STRUMPACK_COUNT_FLOPS), the factor memory per front
+     * type, and the factor and contribution block memory per level
+     * of the elimination tree. Call this after the factorization.
+     * The solve peak includes the factorization if it was triggered
+     * by the solve. For the distributed memory solvers, this
+     * routine is not collective, the peaks are for the calling
+     * process, but the factor and contribution block memory of a
+     * distributed front is counted on the root of its communicator
+     * only (for the whole front), not per process.
+     *
+     * \see MemoryReport
+     */
+    MemoryReport memory_report() const;
+
     /**
      * Return the number of iterations performed by the outer (Krylov)
      * iterative solver. Call this after calling the solve routine.
@@ -415,6 +452,8 @@ namespace strumpack {
     { return double(params::peak_memory); }
 
     void papi_initialize();
+    void memory_phase_start() const;
+    long long memory_phase_peak() const;
     long long dense_factor_nonzeros() const;
     void print_solve_stats(TaskTimer& t) const;
 
@@ -436,6 +475,11 @@ namespace strumpack {
     bool factored_ = false;
     bool reordered_ = false;
     int Krylov_its_ = 0;
+    // only set during reorder(coords, d)
+    const real_t* coords_ = nullptr;
+    int coords_dim_ = 0;
+    // only the phase peaks are stored, the rest is computed from the tree
+    MemoryReport mem_report_;
 
 #if defined(STRUMPACK_USE_PAPI)
     float rtime_ = 0., ptime_ = 0.;
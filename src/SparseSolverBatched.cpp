@@ -0,0 +1,358 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+#include "StrumpackSparseSolverBatched.hpp"
+#include "misc/Tools.hpp"
+#include "misc/TaskTimer.hpp"
+#include "dense/DenseMatrix.hpp"
+#include "sparse/ordering/MatrixReordering.hpp"
+#include "sparse/EliminationTree.hpp"
+#include "sparse/fronts/FrontalMatrix.hpp"
+
+namespace strumpack {
+
+  template<typename scalar_t,typename integer_t>
+  SparseSolverBatched<scalar_t,integer_t>::SparseSolverBatched
+  (bool verbose, bool root) : solver_(verbose, root), is_root_(root) {
+    solver_.options().set_matching(MatchingJob::NONE);
+  }
+
+  template<typename scalar_t,typename integer_t>
+  SparseSolverBatched<scalar_t,integer_t>::SparseSolverBatched
+  (int argc, char* argv[], bool verbose, bool root)
+    : solver_(argc, argv, verbose, root), is_root_(root) {
+    solver_.options().set_matching(MatchingJob::NONE);
+  }
+
+  template<typename scalar_t,typename integer_t>
+  SparseSolverBatched<scalar_t,integer_t>::~SparseSolverBatched() = default;
+
+  template<typename scalar_t,typename integer_t> void
+  SparseSolverBatched<scalar_t,integer_t>::set_csr_pattern
+  (integer_t N, const integer_t* row_ptr, const integer_t* col_ind) {
+    N_ = N;
+    ptr_.assign(row_ptr, row_ptr+N+1);
+    ind_.assign(col_ind+row_ptr[0], col_ind+row_ptr[N]);
+    // make the row pointers start at zero
+    for (auto& p : ptr_) p -= row_ptr[0];
+    reordered_ = false;
+    fronts_.clear();
+    amap_.clear();
+    batch_ = 0;
+    factors_.clear();
+    piv_.clear();
+    finfo_.clear();
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  SparseSolverBatched<scalar_t,integer_t>::set_pattern
+  (const CSRMatrix<scalar_t,integer_t>& A) {
+    set_csr_pattern(A.size(), A.ptr(), A.ind());
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  SparseSolverBatched<scalar_t,integer_t>::reorder(int nx, int ny, int nz) {
+    if (ptr_.empty()) return ReturnCode::MATRIX_NOT_SET;
+    if (reordered_) return ReturnCode::SUCCESS;
+    auto& opts = solver_.options();
+    // only the pattern is used, no scaling, all fronts dense
+    opts.set_matching(MatchingJob::NONE);
+    opts.set_compression(CompressionType::NONE);
+    {
+      std::vector<scalar_t> ones(ind_.size(), scalar_t(1.));
+      solver_.set_csr_matrix
+        (N_, ptr_.data(), ind_.data(), ones.data(), false);
+    }
+    auto ierr = solver_.reorder(nx, ny, nz);
+    if (ierr != ReturnCode::SUCCESS) return ierr;
+    TaskTimer t("batched-symbolic");
+    t.start();
+    fronts_.clear();
+    fsize_ = psize_ = 0;
+    add_fronts(solver_.tree()->root());
+    const integer_t nf = fronts_.size();
+    // front holding each (permuted) row/column in its separator
+    std::vector<integer_t> owner(N_);
+    for (integer_t f=0; f<nf; f++)
+      std::fill(owner.begin()+fronts_[f].sep_begin,
+                owner.begin()+fronts_[f].sep_end, f);
+    auto upd_pos = [](const Front& F, integer_t u) {
+      return integer_t
+        (std::lower_bound(F.upd.begin(), F.upd.end(), u) - F.upd.begin());
+    };
+    // extend-add maps, position of child update indices in the parent
+    for (integer_t f=0; f<nf; f++) {
+      auto& F = fronts_[f];
+      for (auto ch : {F.lch, F.rch}) {
+        if (ch == -1) continue;
+        auto& C = fronts_[ch];
+        C.pmap.resize(C.upd.size());
+        for (std::size_t i=0; i<C.upd.size(); i++) {
+          auto u = C.upd[i];
+          C.pmap[i] = (u >= F.sep_begin && u < F.sep_end) ?
+            u - F.sep_begin : F.dim_sep() + upd_pos(F, u);
+        }
+      }
+    }
+    // assembly map, every nonzero of the (symmetrized, permuted)
+    // pattern is in F11, F12 or F21 of exactly one front
+    const auto& perm = solver_.reordering()->perm();
+    amap_.resize(ind_.size());
+#pragma omp parallel for
+    for (integer_t r=0; r<N_; r++) {
+      auto i = perm[r];
+      for (integer_t k=ptr_[r]; k<ptr_[r+1]; k++) {
+        auto j = perm[ind_[k]];
+        auto& F = fronts_[owner[std::min(i, j)]];
+        std::size_t ds = F.dim_sep(), du = F.dim_upd(),
+          i0 = i - F.sep_begin, j0 = j - F.sep_begin;
+        if (i < F.sep_end && j < F.sep_end)
+          amap_[k] = F.f11 + i0 + j0*ds;
+        else if (i < F.sep_end)
+          amap_[k] = F.f11 + ds*ds + i0 + upd_pos(F, j)*ds;
+        else
+          amap_[k] = F.f11 + ds*ds + ds*du + upd_pos(F, i) + j0*du;
+      }
+    }
+    t.stop();
+    if (opts.verbose() && is_root_)
+      std::cout << "# batched symbolic factorization:" << std::endl
+                << "#   - nr of fronts = "
+                << number_format_with_commas(nf) << std::endl
+                << "#   - factor nonzeros per system = "
+                << number_format_with_commas(fsize_) << std::endl
+                << "#   - time = " << t.elapsed() << std::endl;
+    reordered_ = true;
+    return ReturnCode::SUCCESS;
+  }
+
+  template<typename scalar_t,typename integer_t> integer_t
+  SparseSolverBatched<scalar_t,integer_t>::add_fronts
+  (const FrontalMatrix<scalar_t,integer_t>* f) {
+    Front F;
+    F.lch = f->lchild() ? add_fronts(f->lchild()) : -1;
+    F.rch = f->rchild() ? add_fronts(f->rchild()) : -1;
+    F.sep_begin = f->sep_begin();
+    F.sep_end = f->sep_end();
+    F.upd = f->upd();
+    std::size_t ds = F.dim_sep(), du = F.dim_upd();
+    F.f11 = fsize_;
+    F.piv = psize_;
+    fsize_ += ds*ds + 2*ds*du;
+    psize_ += ds;
+    fronts_.push_back(std::move(F));
+    return fronts_.size() - 1;
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  SparseSolverBatched<scalar_t,integer_t>::factor
+  (int batch, const scalar_t* values, std::vector<ReturnCode>& info) {
+    info.clear();
+    if (!reordered_) {
+      auto ierr = reorder();
+      if (ierr != ReturnCode::SUCCESS) {
+        info.assign(batch, ierr);
+        return ierr;
+      }
+    }
+    TaskTimer t("batched-factor");
+    t.start();
+    const std::size_t nnz = ind_.size();
+    batch_ = batch;
+    factors_.resize(batch*fsize_);
+    piv_.resize(batch*psize_);
+    finfo_.assign(batch, ReturnCode::SUCCESS);
+#pragma omp parallel for schedule(dynamic)
+    for (int i=0; i<batch; i++)
+      finfo_[i] = factor_system
+        (values+i*nnz, factors_.data()+i*fsize_, piv_.data()+i*psize_);
+    t.stop();
+    if (options().verbose() && is_root_)
+      std::cout << "# batched factorization of " << batch
+                << " systems, time = " << t.elapsed() << std::endl;
+    info = finfo_;
+    for (auto e : finfo_)
+      if (e != ReturnCode::SUCCESS) return e;
+    return ReturnCode::SUCCESS;
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  SparseSolverBatched<scalar_t,integer_t>::factor_system
+  (const scalar_t* values, scalar_t* F, int* piv) const {
+    using DenseM_t = DenseMatrix<scalar_t>;
+    const auto& opts = options();
+    ReturnCode ierr = ReturnCode::SUCCESS;
+    std::fill(F, F+fsize_, scalar_t(0.));
+    for (std::size_t k=0; k<ind_.size(); k++)
+      F[amap_[k]] += values[k];
+    real_t thresh(0.);
+    if (opts.replace_tiny_pivots()) {
+      // same threshold as SparseSolver, relative to the 1-norm
+      std::vector<real_t> colsum(N_, real_t(0.));
+      for (std::size_t k=0; k<ind_.size(); k++)
+        colsum[ind_[k]] += std::abs(values[k]);
+      thresh = std::sqrt(blas::lamch<real_t>('E')) *
+        *std::max_element(colsum.begin(), colsum.end());
+    }
+    // stack of contribution blocks, in postorder the contribution
+    // blocks of the children are on top
+    std::vector<DenseM_t> CB;
+    for (const auto& f : fronts_) {
+      const int ds = f.dim_sep(), du = f.dim_upd();
+      auto F11 = F + f.f11, F12 = F11 + ds*ds, F21 = F12 + ds*du;
+      DenseM_t F22(du, du);
+      F22.zero();
+      for (auto ch : {f.rch, f.lch}) {
+        if (ch == -1) continue;
+        const auto& C = CB.back();
+        const auto& m = fronts_[ch].pmap;
+        const int dc = m.size();
+        for (int j=0; j<dc; j++) {
+          const int pj = m[j];
+          for (int i=0; i<dc; i++) {
+            const int pi = m[i];
+            auto v = C(i, j);
+            if (pj < ds) {
+              if (pi < ds) F11[pi+pj*ds] += v;
+              else F21[pi-ds+pj*du] += v;
+            } else {
+              if (pi < ds) F12[pi+(pj-ds)*ds] += v;
+              else F22(pi-ds, pj-ds) += v;
+            }
+          }
+        }
+        CB.pop_back();
+      }
+      if (ds) {
+        auto fpiv = piv + f.piv;
+        if (blas::getrf(ds, ds, F11, ds, fpiv))
+          ierr = ReturnCode::ZERO_PIVOT;
+        if (thresh > real_t(0.))
+          for (int i=0; i<ds; i++)
+            if (std::abs(F11[i+i*ds]) < thresh)
+              F11[i+i*ds] = (std::real(F11[i+i*ds]) < 0) ? -thresh : thresh;
+        if (du) {
+          blas::laswp(du, F12, ds, 1, ds, fpiv, 1);
+          blas::trsm('L', 'L', 'N', 'U', ds, du, scalar_t(1.),
+                     F11, ds, F12, ds);
+          blas::trsm('R', 'U', 'N', 'N', du, ds, scalar_t(1.),
+                     F11, ds, F21, du);
+          blas::gemm('N', 'N', du, du, ds, scalar_t(-1.), F21, du,
+                     F12, ds, scalar_t(1.), F22.data(), F22.ld());
+        }
+      }
+      CB.push_back(std::move(F22));
+    }
+    return ierr;
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  SparseSolverBatched<scalar_t,integer_t>::solve
+  (const scalar_t* b, scalar_t* x, std::vector<ReturnCode>& info) const {
+    info.clear();
+    if (!batch_) return ReturnCode::MATRIX_NOT_SET;
+    const std::size_t N = N_;
+#pragma omp parallel for schedule(dynamic)
+    for (int i=0; i<batch_; i++)
+      solve_system(factors_.data()+i*fsize_, piv_.data()+i*psize_,
+                   b+i*N, x+i*N);
+    info = finfo_;
+    for (auto e : finfo_)
+      if (e != ReturnCode::SUCCESS) return e;
+    return ReturnCode::SUCCESS;
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  SparseSolverBatched<scalar_t,integer_t>::solve
+  (int i, const scalar_t* b, scalar_t* x) const {
+    if (i < 0 || i >= batch_) return ReturnCode::MATRIX_NOT_SET;
+    solve_system(factors_.data()+i*fsize_, piv_.data()+i*psize_, b, x);
+    return finfo_[i];
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  SparseSolverBatched<scalar_t,integer_t>::solve_system
+  (const scalar_t* F, const int* piv,
+   const scalar_t* b, scalar_t* x) const {
+    const auto& perm = solver_.reordering()->perm();
+    const auto& iperm = solver_.reordering()->iperm();
+    std::vector<scalar_t> y(N_), t;
+    for (integer_t i=0; i<N_; i++)
+      y[i] = b[iperm[i]];
+    for (const auto& f : fronts_) {
+      const int ds = f.dim_sep(), du = f.dim_upd();
+      if (!ds) continue;
+      auto F11 = F + f.f11, F21 = F11 + ds*ds + ds*du;
+      auto ys = y.data() + f.sep_begin;
+      blas::laswp(1, ys, ds, 1, ds, piv+f.piv, 1);
+      blas::trsv('L', 'N', 'U', ds, F11, ds, ys, 1);
+      if (du) {
+        t.resize(du);
+        blas::gemv('N', du, ds, scalar_t(1.), F21, du, ys, 1,
+                   scalar_t(0.), t.data(), 1);
+        for (int k=0; k<du; k++) y[f.upd[k]] -= t[k];
+      }
+    }
+    for (auto f=fronts_.rbegin(); f!=fronts_.rend(); f++) {
+      const int ds = f->dim_sep(), du = f->dim_upd();
+      if (!ds) continue;
+      auto F11 = F + f->f11, F12 = F11 + ds*ds;
+      auto ys = y.data() + f->sep_begin;
+      if (du) {
+        t.resize(du);
+        for (int k=0; k<du; k++) t[k] = y[f->upd[k]];
+        blas::gemv('N', ds, du, scalar_t(-1.), F12, ds, t.data(), 1,
+                   scalar_t(1.), ys, 1);
+      }
+      blas::trsv('U', 'N', 'N', ds, F11, ds, ys, 1);
+    }
+    for (integer_t i=0; i<N_; i++)
+      x[i] = y[perm[i]];
+  }
+
+  // explicit template instantiations
+  template class SparseSolverBatched<float,int>;
+  template class SparseSolverBatched<double,int>;
+  template class SparseSolverBatched<std::complex<float>,int>;
+  template class SparseSolverBatched<std::complex<double>,int>;
+
+  template class SparseSolverBatched<float,long int>;
+  template class SparseSolverBatched<double,long int>;
+  template class SparseSolverBatched<std::complex<float>,long int>;
+  template class SparseSolverBatched<std::complex<double>,long int>;
+
+  template class SparseSolverBatched<float,long long int>;
+  template class SparseSolverBatched<double,long long int>;
+  template class SparseSolverBatched<std::complex<float>,long long int>;
+  template class SparseSolverBatched<std::complex<double>,long long int>;
+
+} //end namespace strumpack
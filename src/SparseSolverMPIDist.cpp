@@ -310,6 +310,26 @@ namespace strumpack {
            opts_.gmres_restart(), opts_.GramSchmidt_type(),
            use_initial_guess, opts_.verbose() && is_root_);
       };
+    auto fgmres =
+      [&](const std::function<void(scalar_t*)>& prec) {
+        assert(x.cols() == 1);
+        iterative::FGMResMPI<scalar_t>
+          (comm_, spmv, prec, nloc, x.data(), bloc.data(),
+           opts_.rel_tol(), opts_.abs_tol(),
+           this->Krylov_its_, opts_.maxit(),
+           opts_.gmres_restart(), opts_.GramSchmidt_type(),
+           use_initial_guess, opts_.verbose() && is_root_);
+      };
+    auto sstep_gmres =
+      [&](const std::function<void(scalar_t*)>& prec) {
+        assert(x.cols() == 1);
+        iterative::SStepGMResMPI<scalar_t>
+          (comm_, spmv, prec, nloc, x.data(), bloc.data(),
+           opts_.rel_tol(), opts_.abs_tol(),
+           this->Krylov_its_, opts_.maxit(),
+           opts_.gmres_restart(), opts_.gmres_sstep(),
+           use_initial_guess, opts_.verbose() && is_root_);
+      };
     auto bicgstab =
       [&](const std::function<void(scalar_t*)>& prec) {
         assert(x.cols() == 1);
@@ -350,6 +370,12 @@ namespace strumpack {
     case KrylovSolver::PREC_GMRES: {
       gmres(MFsolve);
     }; break;
+    case KrylovSolver::PREC_SSTEP_GMRES: {
+      sstep_gmres(MFsolve);
+    }; break;
+    case KrylovSolver::PREC_FGMRES: {
+      fgmres(MFsolve);
+    }; break;
     case KrylovSolver::BICGSTAB: {
       bicgstab([](scalar_t*){});
     }; break;
@@ -66,10 +66,8 @@ namespace strumpack {
         bool use_initial_guess) {
     auto solve_func =
       [&](DenseMatrix<refine_t>& w) {
-        DenseMatrix<factor_t> new_x(w.rows(), w.cols()),
-          cast_b = cast_matrix<refine_t,factor_t>(w);
-        solver_.solve(cast_b, new_x);
-        copy(new_x, w);
+        // work_ is reused over iterations and calls to solve
+        solver_.apply_factors(w, work_);
       };
     auto solve_func_ptr =
       [&](refine_t* w) {
@@ -118,6 +116,22 @@ namespace strumpack {
          opts_.rel_tol(), opts_.abs_tol(), Krylov_its_, opts_.maxit(),
          use_initial_guess, opts_.verbose());
     }; break;
+    case KrylovSolver::PREC_SSTEP_GMRES: {
+      assert(x.cols() == 1);
+      iterative::SStepGMRes<refine_t>
+        (spmv, solve_func_ptr, x.rows(), x.data(), b.data(),
+         opts_.rel_tol(), opts_.abs_tol(), Krylov_its_, opts_.maxit(),
+         opts_.gmres_restart(), opts_.gmres_sstep(),
+         use_initial_guess, opts_.verbose());
+    }; break;
+    case KrylovSolver::PREC_FGMRES: {
+      assert(x.cols() == 1);
+      iterative::FGMRes<refine_t>
+        (spmv, solve_func_ptr, x.rows(), x.data(), b.data(),
+         opts_.rel_tol(), opts_.abs_tol(), Krylov_its_, opts_.maxit(),
+         opts_.gmres_restart(), opts_.GramSchmidt_type(),
+         use_initial_guess, opts_.verbose());
+    }; break;
     case KrylovSolver::GMRES:
     case KrylovSolver::BICGSTAB: {
       std::cerr << "ERROR: non-preconditioned solvers not supported "
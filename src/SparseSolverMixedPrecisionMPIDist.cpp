@@ -121,6 +121,22 @@ namespace strumpack {
          opts_.rel_tol(), opts_.abs_tol(), Krylov_its_, opts_.maxit(),
          use_initial_guess, verbose);
     }; break;
+    case KrylovSolver::PREC_SSTEP_GMRES: {
+      assert(x.cols() == 1);
+      iterative::SStepGMResMPI<refine_t>
+        (solver_.Comm(), spmv, solve_func_ptr, x.rows(), x.data(), b.data(),
+         opts_.rel_tol(), opts_.abs_tol(), Krylov_its_, opts_.maxit(),
+         opts_.gmres_restart(), opts_.gmres_sstep(),
+         use_initial_guess, verbose);
+    }; break;
+    case KrylovSolver::PREC_FGMRES: {
+      assert(x.cols() == 1);
+      iterative::FGMResMPI<refine_t>
+        (solver_.Comm(), spmv, solve_func_ptr, x.rows(), x.data(), b.data(),
+         opts_.rel_tol(), opts_.abs_tol(), Krylov_its_, opts_.maxit(),
+         opts_.gmres_restart(), opts_.GramSchmidt_type(),
+         use_initial_guess, verbose);
+    }; break;
     case KrylovSolver::GMRES:
     case KrylovSolver::BICGSTAB: {
       std::cerr << "ERROR: non-preconditioned solvers not supported "
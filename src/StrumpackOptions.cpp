@@ -52,6 +52,7 @@ namespace strumpack {
     case ReorderingStrategy::AND: return "AND";
     case ReorderingStrategy::MLF: return "MLF";
     case ReorderingStrategy::SPECTRAL: return "Spectral";
+    case ReorderingStrategy::COORDINATE: return "Coordinate";
     }
     return "UNKNOWN";
   }
@@ -70,6 +71,7 @@ namespace strumpack {
     case ReorderingStrategy::AND: return false;
     case ReorderingStrategy::MLF: return false;
     case ReorderingStrategy::SPECTRAL: return false;
+    case ReorderingStrategy::COORDINATE: return false;
     }
     return false;
   }
@@ -84,6 +86,7 @@ namespace strumpack {
     case CompressionType::ZFP_BLR_HODLR: return "zfp_blr_hodlr";
     case CompressionType::LOSSY: return "lossy";
     case CompressionType::LOSSLESS: return "lossless";
+    case CompressionType::AUTO: return "auto";
     }
     return "UNKNOWN";
   }
@@ -184,6 +187,26 @@ namespace strumpack {
        {"sp_proportional_mapping",      required_argument, 0, 49},
        {"sp_enable_openmp_tree",        no_argument, 0, 50},
        {"sp_disable_openmp_tree",       no_argument, 0, 51},
+       {"sp_enable_adaptive_precision", no_argument, 0, 52},
+       {"sp_disable_adaptive_precision", no_argument, 0, 53},
+       {"sp_adaptive_precision_tol",    required_argument, 0, 54},
+       {"sp_adaptive_precision_min_front_size", required_argument, 0, 55},
+       {"sp_gmres_sstep",               required_argument, 0, 56},
+       {"sp_tiled_LU_min_sep_size",     required_argument, 0, 57},
+       {"sp_tiled_LU_tile_size",        required_argument, 0, 58},
+       {"sp_enable_task_dag",           no_argument, 0, 59},
+       {"sp_disable_task_dag",          no_argument, 0, 60},
+       {"sp_auto_compression_rank_ratio", required_argument, 0, 61},
+       {"sp_auto_compression_memory_budget", required_argument, 0, 62},
+       {"sp_front_amalgamation_fill",   required_argument, 0, 67},
+       {"sp_front_amalgamation_min_size", required_argument, 0, 64},
+       {"sp_enable_distributed_tiled_LU", no_argument, 0, 65},
+       {"sp_disable_distributed_tiled_LU", no_argument, 0, 66},
+       {"sp_coordinate_ND_clustering",  required_argument, 0, 68},
+       {"sp_ordering_cache",            required_argument, 0, 69},
+       {"sp_nd_parallel_levels",        required_argument, 0, 70},
+       {"sp_enable_permute_in_place",   no_argument, 0, 71},
+       {"sp_disable_permute_in_place",  no_argument, 0, 72},
        {"sp_verbose",                   no_argument, 0, 'v'},
        {"sp_quiet",                     no_argument, 0, 'q'},
        {"help",                         no_argument, 0, 'h'},
@@ -220,6 +243,8 @@ namespace strumpack {
         else if (s == "gmres") set_Krylov_solver(KrylovSolver::GMRES);
         else if (s == "pbicgstab") set_Krylov_solver(KrylovSolver::PREC_BICGSTAB);
         else if (s == "bicgstab") set_Krylov_solver(KrylovSolver::BICGSTAB);
+        else if (s == "psgmres") set_Krylov_solver(KrylovSolver::PREC_SSTEP_GMRES);
+        else if (s == "pfgmres") set_Krylov_solver(KrylovSolver::PREC_FGMRES);
         else std::cerr << "# WARNING: Krylov solver not recognized,"
                " using default" << std::endl;
       } break;
@@ -251,10 +276,11 @@ namespace strumpack {
         else if (s == "mlf") set_reordering_method(ReorderingStrategy::MLF);
         else if (s == "and") set_reordering_method(ReorderingStrategy::AND);
         else if (s == "spectral") set_reordering_method(ReorderingStrategy::SPECTRAL);
+        else if (s == "coordinate") set_reordering_method(ReorderingStrategy::COORDINATE);
         else std::cerr << "# WARNING: matrix reordering strategy not"
                " recognized, use 'metis', 'parmetis', 'scotch', 'ptscotch',"
-               " 'rcm', 'geometric', 'amd', 'mmd', 'mlf', 'and' or 'spectral'"
-                       << std::endl;
+               " 'rcm', 'geometric', 'amd', 'mmd', 'mlf', 'and', 'spectral'"
+               " or 'coordinate'" << std::endl;
       } break;
       case 8: {
         std::istringstream iss(optarg);
@@ -287,9 +313,11 @@ namespace strumpack {
         else if (s == "ZFP_BLR_HODLR") set_compression(CompressionType::ZFP_BLR_HODLR);
         else if (s == "LOSSY") set_compression(CompressionType::LOSSY);
         else if (s == "LOSSLESS") set_compression(CompressionType::LOSSLESS);
+        else if (s == "AUTO") set_compression(CompressionType::AUTO);
         else std::cerr << "# WARNING: compression type not"
                " recognized, use 'none', 'hss', 'blr', 'hodlr',"
-               " 'blr_hodlr', 'zfp_blr_hodlr', 'lossy' or 'lossless'" << std::endl;
+               " 'blr_hodlr', 'zfp_blr_hodlr', 'lossy', 'lossless'"
+               " or 'auto'" << std::endl;
       } break;
       case 21: {
         std::istringstream iss(optarg);
@@ -422,6 +450,76 @@ namespace strumpack {
       } break;
       case 50: enable_openmp_tree(); break;
       case 51: disable_openmp_tree(); break;
+      case 52: enable_adaptive_precision(); break;
+      case 53: disable_adaptive_precision(); break;
+      case 54: {
+        std::istringstream iss(optarg);
+        iss >> adaptive_precision_tol_;
+        set_adaptive_precision_tol(adaptive_precision_tol_);
+      } break;
+      case 55: {
+        std::istringstream iss(optarg);
+        iss >> adaptive_precision_min_front_size_;
+        set_adaptive_precision_min_front_size
+          (adaptive_precision_min_front_size_);
+      } break;
+      case 56: {
+        std::istringstream iss(optarg);
+        iss >> gmres_sstep_;
+        set_gmres_sstep(gmres_sstep_);
+      } break;
+      case 57: {
+        std::istringstream iss(optarg);
+        iss >> tiled_LU_min_sep_size_;
+        set_tiled_LU_min_sep_size(tiled_LU_min_sep_size_);
+      } break;
+      case 58: {
+        std::istringstream iss(optarg);
+        iss >> tiled_LU_tile_size_;
+        set_tiled_LU_tile_size(tiled_LU_tile_size_);
+      } break;
+      case 59: enable_task_dag(); break;
+      case 60: disable_task_dag(); break;
+      case 61: {
+        std::istringstream iss(optarg);
+        iss >> auto_rank_ratio_;
+        set_auto_compression_rank_ratio(auto_rank_ratio_);
+      } break;
+      case 62: {
+        std::istringstream iss(optarg);
+        iss >> auto_mem_budget_;
+        set_auto_compression_memory_budget(auto_mem_budget_);
+      } break;
+      case 67: {
+        std::istringstream iss(optarg);
+        iss >> front_amalg_fill_;
+        set_front_amalgamation_fill(front_amalg_fill_);
+      } break;
+      case 64: {
+        std::istringstream iss(optarg);
+        iss >> front_amalg_min_size_;
+        set_front_amalgamation_min_size(front_amalg_min_size_);
+      } break;
+      case 65: enable_distributed_tiled_LU(); break;
+      case 66: disable_distributed_tiled_LU(); break;
+      case 68: {
+        std::string s; std::istringstream iss(optarg); iss >> s;
+        if (s == "pca")
+          set_coordinate_ND_clustering(ClusteringAlgorithm::PCA);
+        else if (s == "kdtree")
+          set_coordinate_ND_clustering(ClusteringAlgorithm::KD_TREE);
+        else std::cerr << "# WARNING: coordinate nested dissection"
+               " clustering not recognized, use 'pca' or 'kdtree'"
+                       << std::endl;
+      } break;
+      case 69: set_ordering_cache(optarg); break;
+      case 70: {
+        std::istringstream iss(optarg);
+        iss >> nd_parallel_levels_;
+        set_nd_parallel_levels(nd_parallel_levels_);
+      } break;
+      case 71: enable_permute_in_place(); break;
+      case 72: disable_permute_in_place(); break;
       case 'h': { describe_options(); } break;
       case 'v': set_verbose(true); break;
       case 'q': set_verbose(false); break;
@@ -435,9 +533,7 @@ namespace strumpack {
     //             << std::endl;
     HSS_options().set_from_command_line(argc, cargv);
     BLR_options().set_from_command_line(argc, cargv);
-#if defined(STRUMPACK_USE_BPACK)
     HODLR_options().set_from_command_line(argc, cargv);
-#endif
     // ND_options().set_from_command_line(argc, cargv);
 #else
     std::cerr << "WARNING: no support for getopt.h, "
@@ -462,7 +558,7 @@ namespace strumpack {
     std::cout << "#          Krylov absolute (preconditioned) residual"
               << " stopping tolerance" << std::endl;
     std::cout << "#   --sp_Krylov_solver [auto|direct|refinement|pgmres|"
-              << "gmres|pbicgstab|bicgstab]" << std::endl;
+              << "gmres|pbicgstab|bicgstab|psgmres|pfgmres]" << std::endl;
     std::cout << "#          default: auto (refinement when using compression, pgmres"
               << " (preconditioned) with compression)" << std::endl;
     std::cout << "#   --sp_gmres_restart int (default " << gmres_restart()
@@ -471,15 +567,34 @@ namespace strumpack {
     std::cout << "#   --sp_GramSchmidt_type [modified|classical]"
               << std::endl;
     std::cout << "#          Gram-Schmidt type for GMRES" << std::endl;
+    std::cout << "#   --sp_gmres_sstep int (default " << gmres_sstep()
+              << ")" << std::endl;
+    std::cout << "#          block size for s-step GMRES (psgmres)" << std::endl;
     std::cout << "#   --sp_reordering_method [natural|metis|scotch|parmetis|"
-              << "ptscotch|rcm|geometric|amd|mmd|mlf|and|spectral]" << std::endl;
+              << "ptscotch|rcm|geometric|amd|mmd|mlf|and|spectral|coordinate]"
+              << std::endl;
     std::cout << "#          Select a fill-reducing ordering algorithm." << std::endl;
     std::cout << "#          Geometric only works on regular meshes and you"
               << " need to provide the sizes." << std::endl;
+    std::cout << "#          Coordinate needs the coordinates of the"
+              << " unknowns, see Sp::reorder." << std::endl;
+    std::cout << "#   --sp_coordinate_ND_clustering [pca|kdtree] (default "
+              << get_name(coordinate_ND_clustering()) << ")" << std::endl;
+    std::cout << "#          bisection used in the coordinate ordering"
+              << std::endl;
+    std::cout << "#   --sp_ordering_cache dir (default "
+              << (ordering_cache().empty() ? "disabled" : ordering_cache())
+              << ")" << std::endl;
+    std::cout << "#          store/load the ordering in/from this directory"
+              << std::endl;
     std::cout << "#   --sp_nd_param int (default " << nd_param() << ")"
               << std::endl;
     std::cout << "#   --sp_nd_planar_levels int (default "
               << nd_planar_levels() << ")" << std::endl;
+    std::cout << "#   --sp_nd_parallel_levels int (default "
+              << nd_parallel_levels() << ")" << std::endl;
+    std::cout << "#          order 2^levels subgraphs in parallel,"
+              << " 0 disables" << std::endl;
     std::cout << "#   --sp_nx int (default " << nx() << ")"
               << std::endl;
     std::cout << "#   --sp_ny int (default " << ny() << ")"
@@ -515,6 +630,14 @@ namespace strumpack {
               << std::boolalpha << use_agg_amalg() << ")" << std::endl;
     std::cout << "#   --sp_disable_agg_amalg (default "
               << std::boolalpha << !use_agg_amalg() << ")" << std::endl;
+    std::cout << "#   --sp_front_amalgamation_fill real_t (default "
+              << front_amalgamation_fill() << ")" << std::endl
+              << "#          max fraction of zeros when merging fronts,"
+              << " <= 0 disables" << std::endl;
+    std::cout << "#   --sp_front_amalgamation_min_size int (default "
+              << front_amalgamation_min_size() << ")" << std::endl
+              << "#          always merge fronts with smaller separator,"
+              << " if the fill is > 0" << std::endl;
     std::cout << "#   --sp_matching int [0-6] (default "
               << static_cast<int>(matching()) << ")" << std::endl;
     for (int i=0; i<7; i++)
@@ -522,7 +645,7 @@ namespace strumpack {
         get_description(get_matching(i)) << std::endl;
     std::cout << "#   --sp_compression (default "
               << get_name(comp_) << ")" << std::endl
-              << "#          should be [none|hss|blr|hodlr|lossy|blr_hodlr|zfp_blr_hodlr]" << std::endl
+              << "#          should be [none|hss|blr|hodlr|lossy|blr_hodlr|zfp_blr_hodlr|auto]" << std::endl
               << "#          type of rank-structured compression to use"
               << std::endl;
     std::cout << "#   --sp_compression_min_sep_size (default "
@@ -537,6 +660,14 @@ namespace strumpack {
               << compression_leaf_size() << ")" << std::endl
               << "#          leaf size for rank-structured representation"
               << std::endl;
+    std::cout << "#   --sp_auto_compression_rank_ratio real_t (default "
+              << auto_compression_rank_ratio() << ")" << std::endl
+              << "#          expected BLR tile rank / tile size, for"
+              << " --sp_compression auto" << std::endl;
+    std::cout << "#   --sp_auto_compression_memory_budget double (default "
+              << auto_compression_memory_budget() << ")" << std::endl
+              << "#          factor memory budget in bytes, for"
+              << " --sp_compression auto (<= 0: no budget)" << std::endl;
     std::cout << "#   --sp_separator_ordering_level (default "
               << separator_ordering_level() << ")" << std::endl;
     std::cout << "#   --sp_enable_indirect_sampling" << std::endl;
@@ -563,6 +694,42 @@ namespace strumpack {
               << std::boolalpha << !use_openmp_tree_ << ")" << std::endl
               << "#          uses less more memory, but scales worse with OpenMP threads"
               << std::endl;
+    std::cout << "#   --sp_enable_task_dag (default "
+              << std::boolalpha << use_task_dag_ << ")" << std::endl
+              << "#          dependency driven, critical path prioritized"
+              << " tree traversal" << std::endl;
+    std::cout << "#   --sp_disable_task_dag (default "
+              << std::boolalpha << !use_task_dag_ << ")" << std::endl;
+    std::cout << "#   --sp_enable_permute_in_place (default "
+              << std::boolalpha << permute_in_place_ << ")" << std::endl
+              << "#          no copy of the sparse matrix, but slower"
+              << std::endl;
+    std::cout << "#   --sp_disable_permute_in_place (default "
+              << std::boolalpha << !permute_in_place_ << ")" << std::endl;
+    std::cout << "#   --sp_enable_adaptive_precision (default "
+              << std::boolalpha << adaptive_precision_ << ")" << std::endl
+              << "#          store well conditioned dense fronts in lower precision"
+              << std::endl;
+    std::cout << "#   --sp_disable_adaptive_precision (default "
+              << std::boolalpha << !adaptive_precision_ << ")" << std::endl;
+    std::cout << "#   --sp_adaptive_precision_tol real_t (default "
+              << adaptive_precision_tol() << ")" << std::endl
+              << "#          demote front if eps_low * cond(F11) <= tol"
+              << std::endl;
+    std::cout << "#   --sp_adaptive_precision_min_front_size int (default "
+              << adaptive_precision_min_front_size() << ")" << std::endl;
+    std::cout << "#   --sp_tiled_LU_min_sep_size int (default "
+              << tiled_LU_min_sep_size() << ")" << std::endl
+              << "#          use tiled, task based LU for dense fronts"
+              << " with larger separator" << std::endl;
+    std::cout << "#   --sp_tiled_LU_tile_size int (default "
+              << tiled_LU_tile_size() << ")" << std::endl;
+    std::cout << "#   --sp_enable_distributed_tiled_LU (default "
+              << std::boolalpha << dist_tiled_LU_ << ")" << std::endl
+              << "#          native tiled LU with look-ahead for"
+              << " distributed dense fronts" << std::endl;
+    std::cout << "#   --sp_disable_distributed_tiled_LU (default "
+              << std::boolalpha << !dist_tiled_LU_ << ")" << std::endl;
     std::cout << "#   --sp_lossy_precision [1-64] (default "
               << lossy_precision() << ")" << std::endl
               << "#          lossy compression precision" << std::endl
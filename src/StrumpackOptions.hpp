@@ -70,7 +70,10 @@ namespace strumpack {
     MMD,        /*!< Multiple minimum degree                        */
     AND,        /*!< Nested dissection                              */
     MLF,        /*!< Minimum local fill                             */
-    SPECTRAL    /*!< Spectral nested dissection                     */
+    SPECTRAL,   /*!< Spectral nested dissection                     */
+    COORDINATE  /*!< Nested dissection by recursive bisection of
+                  user supplied coordinates of the unknowns, for
+                  unstructured meshes (see Sp::reorder)             */
   };
 
   /**
@@ -102,7 +105,10 @@ namespace strumpack {
                     fronts and Hierarchically Off-diagonal
                     Low-Rank compression of large fronts  */
     LOSSLESS,  /*!< Lossless cmpresssion                  */
-    LOSSY      /*!< Lossy cmpresssion                     */
+    LOSSY,     /*!< Lossy cmpresssion                     */
+    AUTO       /*!< Dense or BLR, selected per front with
+                    a calibrated performance model, see
+                    SPOptions::set_auto_compression_rank_ratio */
   };
 
   /**
@@ -173,7 +179,13 @@ namespace strumpack {
     GMRES,          /*!< UN-preconditioned GMRes. (for testing mainly)      */
     PREC_BICGSTAB,  /*!< Preconditioned BiCGStab. The preconditioner is the
                       (approx) multifrontal solver.                         */
-    BICGSTAB        /*!< UN-preconditioned BiCGStab. (for testing mainly)   */
+    BICGSTAB,       /*!< UN-preconditioned BiCGStab. (for testing mainly)   */
+    PREC_SSTEP_GMRES, /*!< Preconditioned s-step GMRes, uses fewer global
+                       reductions than PREC_GMRES, see
+                       SPOptions::set_gmres_sstep.                         */
+    PREC_FGMRES     /*!< Flexible GMRes, right preconditioned with the
+                      (approx) multifrontal solver. Allows the
+                      preconditioner to vary between iterations.          */
   };
 
   /**
@@ -309,6 +321,18 @@ namespace strumpack {
      */
     void set_GramSchmidt_type(GramSchmidtType t) { Gram_Schmidt_type_ = t; }
 
+    /**
+     * Set the block size s for s-step GMRES
+     * (KrylovSolver::PREC_SSTEP_GMRES). Each block of s Krylov
+     * vectors is orthogonalized at once. Larger s requires fewer
+     * global reductions, but the Krylov basis gets more
+     * ill-conditioned. s is reduced automatically when the block
+     * orthogonalization breaks down.
+     *
+     * \param s block size, should be >= 1
+     */
+    void set_gmres_sstep(int s) { assert(s >= 1); gmres_sstep_ = s; }
+
     /**
      * Set the sparse fill-reducing reordering. This can greatly
      * affect the memory usage and factorization time. However, note
@@ -341,6 +365,49 @@ namespace strumpack {
     void set_nd_planar_levels(int nd_planar_levels)
     { assert(nd_planar_levels>=0); nd_planar_levels_ = nd_planar_levels; }
 
+    /**
+     * Set the number of levels of the shared memory parallel nested
+     * dissection, 0 (the default) disables it. The top nd_parallel_levels
+     * separators are computed with METIS vertex bisection, which
+     * splits the graph in 2^nd_parallel_levels disjoint subgraphs.
+     * These subgraphs are then ordered concurrently, using OpenMP
+     * tasks, with the selected reordering method. This is only used
+     * with ReorderingStrategy METIS, SCOTCH, AMD, MMD or AND, in the
+     * sequential/multithreaded solver.
+     */
+    void set_nd_parallel_levels(int nd_parallel_levels) {
+      assert(nd_parallel_levels>=0);
+      nd_parallel_levels_ = nd_parallel_levels;
+    }
+
+    /**
+     * Set the algorithm used to bisect the coordinates in the
+     * ReorderingStrategy::COORDINATE nested dissection. Supported are
+     * ClusteringAlgorithm::PCA (split perpendicular to the principal
+     * direction, inertial bisection) and ClusteringAlgorithm::KD_TREE
+     * (split perpendicular to the coordinate axis with the largest
+     * extent). Both split at the median.
+     */
+    void set_coordinate_ND_clustering(ClusteringAlgorithm a) {
+      assert(a == ClusteringAlgorithm::PCA ||
+             a == ClusteringAlgorithm::KD_TREE);
+      coord_ND_clustering_ = a;
+    }
+
+    /**
+     * Set a directory for the on-disk ordering cache, an empty string
+     * (the default) disables the cache. The fill reducing ordering
+     * (permutation and separator tree) is stored in this directory,
+     * in a file named after a hash of the sparsity pattern (after
+     * matching and symmetrization) and of the reordering options. A
+     * later call to reorder, in this or another process, for a matrix
+     * with the same sparsity pattern and options, reads the ordering
+     * from this file, instead of calling the nested dissection
+     * code. Only for the sequential/multithreaded solver.
+     */
+    void set_ordering_cache(const std::string& dir)
+    { ordering_cache_ = dir; }
+
     /**
      * Set the mesh dimensions. This is only useful when the sparse
      * matrix was generated by a stencil on a regular 1d, 2d or 3d
@@ -503,6 +570,40 @@ namespace strumpack {
      */
     void enable_agg_amalg() { use_agg_amalg_ = true; }
 
+    /**
+     * Set the maximum fraction of explicit zeros which can be added
+     * to a front when merging fronts in the supernodal tree. After
+     * the symbolic factorization, two leaf fronts are merged into
+     * their parent if the fraction of zeros in the merged front
+     * stays below this value. This is repeated bottom-up, so small
+     * subtrees (for instance from nested dissection leafs) can be
+     * merged into a single front. This leads to fewer and larger
+     * fronts, at the cost of some additional fill. A value <= 0
+     * disables the amalgamation.
+     *
+     * \param f maximum fraction of zeros in a merged front, < 1
+     * \see set_front_amalgamation_min_size
+     */
+    void set_front_amalgamation_fill(real_t f) {
+      assert(f < 1);
+      front_amalg_fill_ = f;
+    }
+
+    /**
+     * When front amalgamation is enabled, fronts are always merged
+     * if the separator of the merged front is not larger than this,
+     * regardless of the fraction of added zeros. For such small
+     * fronts the overhead per front dominates. This has no effect
+     * when the amalgamation is disabled, i.e., when
+     * front_amalgamation_fill() <= 0.
+     *
+     * \see set_front_amalgamation_fill
+     */
+    void set_front_amalgamation_min_size(int s) {
+      assert(s >= 0);
+      front_amalg_min_size_ = s;
+    }
+
     /**
      * Disbale aggressive amalgamation of nodes into supernodes inside
      * MUMPS_SYMQMAD. This is only relevant when MUMPS_SYMQAMD is
@@ -650,6 +751,35 @@ namespace strumpack {
       lossy_min_front_size_ = s;
     }
 
+    /**
+     * Set the expected rank of the off-diagonal tiles, relative to
+     * the BLR tile size, used by the performance model to select
+     * dense or BLR for each front with CompressionType::AUTO. The
+     * performance model is calibrated, by timing a few small
+     * kernels, the first time it is used.
+     *
+     * \param r expected rank / tile size, 0 < r <= 1
+     * \see set_compression, set_auto_compression_memory_budget
+     */
+    void set_auto_compression_rank_ratio(real_t r) {
+      assert(r > 0 && r <= 1);
+      auto_rank_ratio_ = r;
+    }
+
+    /**
+     * Set a budget (in bytes) for the memory of the factors with
+     * CompressionType::AUTO. As long as the (predicted) memory for
+     * the factors fits in the budget, each front is stored in the
+     * representation with the smallest predicted factorization and
+     * solve time, otherwise the representation with the smallest
+     * memory is selected. A value <= 0 means no budget.
+     *
+     * \see set_compression, set_auto_compression_rank_ratio
+     */
+    void set_auto_compression_memory_budget(double bytes) {
+      auto_mem_budget_ = bytes;
+    }
+
     /**
      * Set the leaf size used by any of the rank-structured formats.
      *
@@ -758,6 +888,129 @@ namespace strumpack {
      */
     void disable_openmp_tree() { use_openmp_tree_ = false; }
 
+    /**
+     * Enable the dependency driven (OpenMP task depend) traversal of
+     * the supernodal tree, instead of the recursive (fork-join)
+     * traversal. A front is factored as soon as its children are
+     * done, and ready fronts are prioritized by the critical path
+     * (in flops) from the front to the root. This only applies to
+     * the (sub)trees of dense fronts, other fronts are factored as a
+     * single task. Requires enable_openmp_tree(). This can increase
+     * the peak memory, since more contribution blocks can be alive at
+     * the same time.
+     */
+    void enable_task_dag() { use_task_dag_ = true; }
+
+    /**
+     * Disable the dependency driven traversal of the supernodal tree,
+     * use the recursive traversal instead.
+     */
+    void disable_task_dag() { use_task_dag_ = false; }
+
+    /**
+     * Permute the sparse matrix in place after the reordering,
+     * instead of building a permuted copy. This avoids a temporary
+     * copy of the matrix, but is several times slower, only use this
+     * when the memory for the copy is not available.
+     */
+    void enable_permute_in_place() { permute_in_place_ = true; }
+
+    /**
+     * Permute the sparse matrix by building a permuted copy, this is
+     * the default.
+     */
+    void disable_permute_in_place() { permute_in_place_ = false; }
+
+    /**
+     * Enable adaptive precision storage of the dense frontal
+     * matrices. After the (full precision) factorization of a front,
+     * the factors are stored in lower precision (float for double,
+     * complex<float> for complex<double>), if the estimated
+     * condition number of the pivot block, times the unit roundoff
+     * of the lower precision, is below
+     * adaptive_precision_tol(). This reduces the memory for the
+     * factors and the memory traffic in the solve. The loss of
+     * accuracy is typically recovered by iterative refinement.
+     *
+     * \see disable_adaptive_precision, set_adaptive_precision_tol,
+     * set_adaptive_precision_min_front_size
+     */
+    void enable_adaptive_precision() { adaptive_precision_ = true; }
+
+    /**
+     * Disable adaptive precision storage of the dense frontal
+     * matrices, all factors will be stored in the working precision.
+     *
+     * \see enable_adaptive_precision
+     */
+    void disable_adaptive_precision() { adaptive_precision_ = false; }
+
+    /**
+     * Set the tolerance for adaptive precision storage of the
+     * frontal matrices. A front is stored in lower precision if
+     * eps_low * cond_1(F11) <= tol, with eps_low the unit roundoff
+     * of the lower precision type.
+     *
+     * \see enable_adaptive_precision
+     */
+    void set_adaptive_precision_tol(real_t tol) {
+      assert(tol >= real_t(0.));
+      adaptive_precision_tol_ = tol;
+    }
+
+    /**
+     * Set the minimum size of a front (dimension of F11 + F22) for
+     * it to be considered for lower precision storage.
+     *
+     * \see enable_adaptive_precision
+     */
+    void set_adaptive_precision_min_front_size(int s) {
+      assert(s >= 0);
+      adaptive_precision_min_front_size_ = s;
+    }
+
+    /**
+     * Set the minimum separator size for which the dense frontal
+     * matrix is factored with a tiled LU, with OpenMP tasks with
+     * dependencies, instead of the recursive (fork-join) LU. The
+     * tiled LU overlaps the panel factorizations with the triangular
+     * solves and the Schur complement update.
+     *
+     * \see set_tiled_LU_tile_size
+     */
+    void set_tiled_LU_min_sep_size(int s) {
+      assert(s >= 0);
+      tiled_LU_min_sep_size_ = s;
+    }
+
+    /**
+     * Set the tile size for the tiled dense LU factorization.
+     *
+     * \see set_tiled_LU_min_sep_size
+     */
+    void set_tiled_LU_tile_size(int nb) {
+      assert(nb >= 1);
+      tiled_LU_tile_size_ = nb;
+    }
+
+    /**
+     * Use a native tiled LU factorization for the distributed dense
+     * frontal matrices, instead of ScaLAPACK pgetrf followed by
+     * ptrsm/pgemm. Each panel is broadcast with nonblocking MPI,
+     * while the trailing update (including the F12/F21 solves and
+     * the F22 Schur complement update) is done with OpenMP tasks,
+     * and the next panel is factored ahead of the trailing update
+     * (look-ahead). The tile size is the block size of the 2D
+     * block-cyclic distribution. Only used for fronts with a
+     * separator of at least tiled_LU_min_sep_size().
+     */
+    void enable_distributed_tiled_LU() { dist_tiled_LU_ = true; }
+
+    /**
+     * Use ScaLAPACK for the distributed dense frontal matrices.
+     */
+    void disable_distributed_tiled_LU() { dist_tiled_LU_ = false; }
+
     /**
      * Set the precision for lossy compression.
      */
@@ -816,6 +1069,12 @@ namespace strumpack {
      */
     GramSchmidtType GramSchmidt_type() const { return Gram_Schmidt_type_; }
 
+    /**
+     * Get the block size for s-step GMRES.
+     * \see set_gmres_sstep()
+     */
+    int gmres_sstep() const { return gmres_sstep_; }
+
     /**
      * Get the currently set fill reducing reordering method.
      * \see set_reordering_method()
@@ -836,6 +1095,28 @@ namespace strumpack {
      */
     int nd_planar_levels() const { return nd_planar_levels_; }
 
+    /**
+     * Return the number of levels of the shared memory parallel
+     * nested dissection, 0 if disabled.
+     * \see set_nd_parallel_levels()
+     */
+    int nd_parallel_levels() const { return nd_parallel_levels_; }
+
+    /**
+     * Get the algorithm used to bisect the coordinates in the
+     * ReorderingStrategy::COORDINATE nested dissection.
+     * \see set_coordinate_ND_clustering()
+     */
+    ClusteringAlgorithm coordinate_ND_clustering() const
+    { return coord_ND_clustering_; }
+
+    /**
+     * Get the directory used for the on-disk ordering cache, empty
+     * if the cache is disabled.
+     * \see set_ordering_cache()
+     */
+    const std::string& ordering_cache() const { return ordering_cache_; }
+
     /**
      * Get the specified nx mesh dimension.
      * \see set_nx()
@@ -892,6 +1173,22 @@ namespace strumpack {
      */
     bool use_agg_amalg() const { return use_agg_amalg_; }
 
+    /**
+     * Maximum fraction of explicit zeros in a front, after merging
+     * fronts in the supernodal tree. <= 0 if front amalgamation is
+     * disabled.
+     * \see set_front_amalgamation_fill
+     */
+    real_t front_amalgamation_fill() const { return front_amalg_fill_; }
+
+    /**
+     * Separator size below which fronts are always merged, if front
+     * amalgamation is enabled. Not used when
+     * front_amalgamation_fill() <= 0.
+     * \see set_front_amalgamation_min_size
+     */
+    int front_amalgamation_min_size() const { return front_amalg_min_size_; }
+
     /**
      * Get the matching job to use for numerical stability reordering.
      * \see set_matching()
@@ -923,6 +1220,7 @@ namespace strumpack {
       case CompressionType::HSS:
         return hss_opts_.rel_tol();
       case CompressionType::BLR:
+      case CompressionType::AUTO:
         return blr_opts_.rel_tol();
       case CompressionType::HODLR:
         return hodlr_opts_.rel_tol();
@@ -952,6 +1250,7 @@ namespace strumpack {
       case CompressionType::HSS:
         return hss_opts_.abs_tol();
       case CompressionType::BLR:
+      case CompressionType::AUTO:
         return blr_opts_.abs_tol();
       case CompressionType::HODLR:
         return hodlr_opts_.abs_tol();
@@ -980,6 +1279,7 @@ namespace strumpack {
       case CompressionType::HSS:
         return hss_min_sep_size_;
       case CompressionType::BLR:
+      case CompressionType::AUTO:
         return blr_min_sep_size_;
       case CompressionType::HODLR:
         return hodlr_min_sep_size_;
@@ -1023,6 +1323,7 @@ namespace strumpack {
       case CompressionType::HSS:
         return hss_min_front_size_;
       case CompressionType::BLR:
+      case CompressionType::AUTO:
         return blr_min_front_size_;
       case CompressionType::HODLR:
         return hodlr_min_front_size_;
@@ -1054,6 +1355,20 @@ namespace strumpack {
       return lossy_min_front_size_;
     }
 
+    /**
+     * Expected rank / tile size of the off-diagonal BLR tiles, used
+     * with CompressionType::AUTO.
+     */
+    real_t auto_compression_rank_ratio() const { return auto_rank_ratio_; }
+
+    /**
+     * Memory budget (bytes) for the factors with
+     * CompressionType::AUTO, <= 0 means no budget.
+     */
+    double auto_compression_memory_budget() const {
+      return auto_mem_budget_;
+    }
+
     /**
      * Get the leaf size used in the rank-structured format used for
      * compression. This will depend on which type of compression is
@@ -1067,6 +1382,7 @@ namespace strumpack {
       case CompressionType::HSS:
         return hss_opts_.leaf_size();
       case CompressionType::BLR:
+      case CompressionType::AUTO:
         return blr_opts_.leaf_size();
       case CompressionType::HODLR:
         return hodlr_opts_.leaf_size();
@@ -1131,6 +1447,51 @@ namespace strumpack {
      */
     bool use_openmp_tree() const { return use_openmp_tree_; }
 
+    /**
+     * Check whether the dependency driven traversal of the
+     * supernodal tree is enabled.
+     */
+    bool use_task_dag() const { return use_task_dag_; }
+
+    /**
+     * Check whether the sparse matrix is permuted in place.
+     */
+    bool permute_in_place() const { return permute_in_place_; }
+
+    /**
+     * Check whether adaptive precision storage of the frontal
+     * matrices is enabled.
+     */
+    bool adaptive_precision() const { return adaptive_precision_; }
+
+    /**
+     * Tolerance for adaptive precision storage of the frontal
+     * matrices.
+     */
+    real_t adaptive_precision_tol() const { return adaptive_precision_tol_; }
+
+    /**
+     * Minimum front size for adaptive precision storage.
+     */
+    int adaptive_precision_min_front_size() const {
+      return adaptive_precision_min_front_size_;
+    }
+
+    /**
+     * Minimum separator size for the tiled dense LU factorization.
+     */
+    int tiled_LU_min_sep_size() const { return tiled_LU_min_sep_size_; }
+
+    /**
+     * Tile size for the tiled dense LU factorization.
+     */
+    int tiled_LU_tile_size() const { return tiled_LU_tile_size_; }
+
+    /**
+     * Use the native tiled LU for the distributed dense fronts?
+     */
+    bool distributed_tiled_LU() const { return dist_tiled_LU_; }
+
     /**
      * Returns the number of GPU streams to use.
      */
@@ -1239,10 +1600,14 @@ namespace strumpack {
     KrylovSolver Krylov_solver_ = KrylovSolver::AUTO;
     int gmres_restart_ = 30;
     GramSchmidtType Gram_Schmidt_type_ = GramSchmidtType::MODIFIED;
+    int gmres_sstep_ = 5;
     /** Reordering options */
     ReorderingStrategy reordering_method_ = ReorderingStrategy::METIS;
     int nd_planar_levels_ = 0;
     int nd_param_ = 8;
+    int nd_parallel_levels_ = 0;
+    ClusteringAlgorithm coord_ND_clustering_ = ClusteringAlgorithm::PCA;
+    std::string ordering_cache_;
     int nx_ = 1;
     int ny_ = 1;
     int nz_ = 1;
@@ -1251,6 +1616,8 @@ namespace strumpack {
     bool use_METIS_NodeNDP_ = false;
     bool use_MUMPS_SYMQAMD_ = false;
     bool use_agg_amalg_ = false;
+    real_t front_amalg_fill_ = 0.;
+    int front_amalg_min_size_ = 16;
     MatchingJob matching_job_ = MatchingJob::MAX_DIAGONAL_PRODUCT_SCALING;
     bool log_assembly_tree_ = false;
     bool replace_tiny_pivots_ = false;
@@ -1259,6 +1626,14 @@ namespace strumpack {
     bool print_comp_front_stats_ = false;
     ProportionalMapping prop_map_ = ProportionalMapping::FLOPS;
     bool use_openmp_tree_ = true;
+    bool use_task_dag_ = false;
+    bool permute_in_place_ = false;
+    bool adaptive_precision_ = false;
+    real_t adaptive_precision_tol_ = 1e-2;
+    int adaptive_precision_min_front_size_ = 500;
+    int tiled_LU_min_sep_size_ = 2000;
+    int tiled_LU_tile_size_ = 256;
+    bool dist_tiled_LU_ = false;
 
     /** GPU options */
 #if defined(STRUMPACK_USE_CUDA) || defined(STRUMPACK_USE_HIP) || defined(STRUMPACK_USE_SYCL)
@@ -1282,6 +1657,8 @@ namespace strumpack {
     BLR::BLROptions<scalar_t> blr_opts_;
     int blr_min_front_size_ = 100000;
     int blr_min_sep_size_ = 512;
+    real_t auto_rank_ratio_ = 0.1;
+    double auto_mem_budget_ = 0.;
 
     /** HODLR options */
     HODLR::HODLROptions<scalar_t> hodlr_opts_;
@@ -47,6 +47,7 @@ namespace strumpack {
     std::atomic<long long int> bytes_moved(0);
     std::atomic<long long int> memory(0);
     std::atomic<long long int> peak_memory(0);
+    std::atomic<long long int> phase_peak_memory(0);
     std::atomic<long long int> device_memory(0);
     std::atomic<long long int> peak_device_memory(0);
 
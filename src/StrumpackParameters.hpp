@@ -33,6 +33,7 @@
 #define STRUMPACK_PARAMETERS_HPP
 #include <atomic>
 #include <string>
+#include <vector>
 #include <cmath>
 #include <iostream>
 #include <fstream>
@@ -68,6 +69,43 @@ namespace strumpack { // these are all global variables
     return os;
   }
 
+  /**
+   * \brief Breakdown of the memory usage of a sparse solver, see
+   * SparseSolverBase::memory_report.
+   *
+   * All values are in bytes. The phase peaks are measured for the
+   * calling process, by tracking all allocations of dense matrices
+   * (this includes BLR tiles, HSS generators and contribution
+   * blocks) and workspace vectors, but only when STRUMPACK is built
+   * with STRUMPACK_COUNT_FLOPS, otherwise these are 0. The other
+   * values are computed from the elimination tree, the factor
+   * memory per front type is only known after the factorization. A
+   * front distributed over several processes is charged in full to
+   * the root of its communicator, so these values add up to the
+   * totals over all processes, but are not the memory per process.
+   */
+  struct MemoryReport {
+    long long reordering = 0; /*!< peak during matching/reordering */
+    long long symbolic = 0;   /*!< peak during symbolic factorization */
+    long long factor = 0;     /*!< peak during numerical factorization */
+    long long solve = 0;      /*!< peak during the (last) solve */
+
+    long long dense = 0;      /*!< factors of dense fronts */
+    long long BLR = 0;        /*!< factors of BLR fronts */
+    long long HSS = 0;        /*!< factors of HSS fronts */
+    long long HODLR = 0;      /*!< factors of HODLR/butterfly fronts */
+    long long lossy = 0;      /*!< factors of lossy/lossless fronts */
+    long long CB = 0;         /*!< contribution blocks, all fronts */
+
+    /** factor memory per level of the elimination tree, root is 0 */
+    std::vector<long long> level_factors;
+    /** contribution blocks of all fronts per level */
+    std::vector<long long> level_CB;
+
+    /** total factor memory */
+    long long factors() const { return dense + BLR + HSS + HODLR + lossy; }
+  };
+
   namespace params {
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -79,6 +117,7 @@ namespace strumpack { // these are all global variables
     extern std::atomic<long long int> bytes_moved;
     extern std::atomic<long long int> memory;
     extern std::atomic<long long int> peak_memory;
+    extern std::atomic<long long int> phase_peak_memory;
     extern std::atomic<long long int> device_memory;
     extern std::atomic<long long int> peak_device_memory;
 
@@ -166,6 +205,11 @@ namespace strumpack { // these are all global variables
     while (new_peak_ > old_peak_ &&                                     \
            !strumpack::params::peak_memory.compare_exchange_weak        \
            (old_peak_, new_peak_)) { }                                  \
+    auto cur_ = strumpack::params::memory.load();                       \
+    auto old_phase_ = strumpack::params::phase_peak_memory.load();      \
+    while (cur_ > old_phase_ &&                                         \
+           !strumpack::params::phase_peak_memory.compare_exchange_weak  \
+           (old_phase_, cur_)) { }                                      \
   }
 #define STRUMPACK_ADD_DEVICE_MEMORY(n) {                                \
     strumpack::params::device_memory += n;                              \
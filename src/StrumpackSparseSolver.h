@@ -79,7 +79,8 @@ typedef enum
    STRUMPACK_BLR_HODLR=4,
    STRUMPACK_ZFP_BLR_HODLR=5,
    STRUMPACK_LOSSLESS=6,
-   STRUMPACK_LOSSY=7
+   STRUMPACK_LOSSY=7,
+   STRUMPACK_AUTO_COMPRESSION=8
   } STRUMPACK_COMPRESSION_TYPE;
 
 typedef enum
@@ -124,7 +125,8 @@ typedef enum
 typedef enum
   {
    STRUMPACK_LINEAR=0,
-   STRUMPACK_MERSENNE=1
+   STRUMPACK_MERSENNE=1,
+   STRUMPACK_PHILOX=2
   } STRUMPACK_RANDOM_ENGINE;
 
 typedef enum
@@ -135,7 +137,9 @@ typedef enum
    STRUMPACK_PREC_GMRES=3,
    STRUMPACK_GMRES=4,
    STRUMPACK_PREC_BICGSTAB=5,
-   STRUMPACK_BICGSTAB=6
+   STRUMPACK_BICGSTAB=6,
+   STRUMPACK_PREC_SSTEP_GMRES=7,
+   STRUMPACK_PREC_FGMRES=8
   } STRUMPACK_KRYLOV_SOLVER;
 
 typedef enum
@@ -148,6 +152,25 @@ typedef enum
    STRUMPACK_INACCURATE_INERTIA=5
   } STRUMPACK_RETURN_CODE;
 
+/**
+ * Memory usage breakdown, in bytes, see
+ * strumpack::MemoryReport. The phase peaks are only measured when
+ * STRUMPACK was built with STRUMPACK_COUNT_FLOPS.
+ */
+typedef struct {
+  long long reordering;   /*!< peak during matching/reordering      */
+  long long symbolic;     /*!< peak during symbolic factorization   */
+  long long factor;       /*!< peak during numerical factorization  */
+  long long solve;        /*!< peak during the (last) solve         */
+  long long dense;        /*!< factors of dense fronts              */
+  long long BLR;          /*!< factors of BLR fronts                */
+  long long HSS;          /*!< factors of HSS fronts                */
+  long long HODLR;        /*!< factors of HODLR/butterfly fronts    */
+  long long lossy;        /*!< factors of lossy/lossless fronts     */
+  long long CB;           /*!< contribution blocks, all fronts      */
+  int levels;             /*!< number of elimination tree levels    */
+} STRUMPACK_MEMORY_REPORT;
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -291,6 +314,9 @@ extern "C" {
   int STRUMPACK_rank(STRUMPACK_SparseSolver S);
   long long STRUMPACK_factor_nonzeros(STRUMPACK_SparseSolver S);
   long long STRUMPACK_factor_memory(STRUMPACK_SparseSolver S);
+  STRUMPACK_MEMORY_REPORT STRUMPACK_memory_report(STRUMPACK_SparseSolver S);
+  void STRUMPACK_memory_report_level(STRUMPACK_SparseSolver S, int level,
+                                     long long* factors, long long* CB);
 
 
 
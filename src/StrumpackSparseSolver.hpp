@@ -49,6 +49,47 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> class MatrixReordering;
   template<typename scalar_t,typename integer_t> class EliminationTree;
   class TaskTimer;
+  template<typename scalar_t,typename integer_t> class SparseSolver;
+  template<typename scalar_t,typename integer_t> class SparseSolverBatched;
+
+  /**
+   * \class SolveContext
+   *
+   * \brief Per-call state of the reentrant (const) solve of a
+   * SparseSolver.
+   *
+   * Holds the work memory, the number of Krylov iterations and the
+   * time of a solve. A context can be reused for many solves, in
+   * which case the work memory is only allocated once (for a fixed
+   * number of right-hand sides). Each thread should use its own
+   * context.
+   *
+   * \tparam scalar_t can be: float, double, std::complex<float> or
+   * std::complex<double>.
+   *
+   * \see SparseSolver::solve(const DenseMatrix<scalar_t>&,
+   * DenseMatrix<scalar_t>&, SolveContext<scalar_t>&, bool) const
+   */
+  template<typename scalar_t> class SolveContext {
+  public:
+    /**
+     * Number of iterations performed by the outer (Krylov) iterative
+     * solver in the last solve with this context.
+     */
+    int Krylov_iterations() const { return Krylov_its_; }
+
+    /**
+     * Time (seconds) of the last solve with this context.
+     */
+    double solve_time() const { return time_; }
+
+  private:
+    int Krylov_its_ = 0;
+    double time_ = 0.;
+    DenseMatrix<scalar_t> bloc_;
+
+    template<typename,typename> friend class SparseSolver;
+  };
 
   /**
    * \class SparseSolver
@@ -79,6 +120,7 @@ namespace strumpack {
     using Reord_t = MatrixReordering<scalar_t,integer_t>;
     using DenseM_t = DenseMatrix<scalar_t>;
     using DenseMW_t = DenseMatrixWrapper<scalar_t>;
+    using real_t = typename RealType<scalar_t>::value_type;
 
   public:
 
@@ -159,7 +201,12 @@ namespace strumpack {
      * values, the permutation vector previously computed will be
      * reused to permute the updated matrix values, instead of
      * recomputing the permutation. The numerical factorization will
-     * automatically be redone.
+     * automatically be redone. On the first call, a map from the
+     * input nonzeros to the internal (permuted, scaled and
+     * symmetrized) matrix is constructed, so that later calls, with
+     * the same sparsity pattern, only require a single pass over the
+     * values (unless compression is enabled, since then the
+     * separator reordering is recomputed).
      *
      * \param N Number of rows in the matrix.
      * \param row_ptr Row pointer array in the typical compressed
@@ -203,6 +250,71 @@ namespace strumpack {
      */
     void update_matrix_values(const CSRMatrix<scalar_t,integer_t>& A);
 
+    /**
+     * Apply the (permuted and scaled) sparse direct solve, without
+     * any outer iterative solver, to the right-hand side(s) w, in
+     * place. The matrix w can be stored in a different precision
+     * than the factors (scalar_t). The conversion to and from
+     * scalar_t is done while applying the permutation and scaling,
+     * so this only requires a single work matrix, in scalar_t. When
+     * work has the correct size, it is reused and no memory is
+     * allocated here. This routine does not print any timing or
+     * statistics, and is meant to be used as the preconditioner in
+     * an outer iterative solver, see SparseSolverMixedPrecision.
+     *
+     * \tparam refine_t precision of the right-hand side and solution
+     * \param w right-hand side(s) on input, solution on output
+     * \param work work space, will be resized if needed
+     */
+    template<typename refine_t> ReturnCode
+    apply_factors(DenseMatrix<refine_t>& w, DenseM_t& work);
+
+    using SparseSolverBase<scalar_t,integer_t>::solve;
+
+    /**
+     * Reentrant solve with a single or multiple right-hand sides,
+     * using the factorization computed earlier with factor(). This
+     * does not modify the solver, so multiple threads can call this
+     * concurrently on the same factors, each with its own
+     * SolveContext. Unlike the non-const solve routines, this does
+     * not (re)compute the reordering or the factorization, does not
+     * print any statistics and does not update the memory or flop
+     * counters of the solver. The number of Krylov iterations and
+     * the solve time are stored in ctx.
+     *
+     * When calling this from threads which are not part of an OpenMP
+     * parallel region, consider calling omp_set_num_threads(1) in
+     * each of those threads, to avoid oversubscription.
+     *
+     * \param b input, will not be modified, the right-hand side(s)
+     * \param x output, the solution(s), should have the same size as b
+     * \param ctx per-call state, work memory and statistics
+     * \param use_initial_guess set to true if x contains an intial
+     * guess to the solution
+     * \return error code, ReturnCode::MATRIX_NOT_SET if no matrix is
+     * set, or if the matrix was not factored
+     * (or reordered for the non-preconditioned Krylov solvers)
+     */
+    ReturnCode solve(const DenseM_t& b, DenseM_t& x,
+                     SolveContext<scalar_t>& ctx,
+                     bool use_initial_guess=false) const;
+
+    /**
+     * Reentrant solve with a single right-hand side, see
+     * solve(const DenseM_t&, DenseM_t&, SolveContext<scalar_t>&,
+     * bool) const.
+     *
+     * \param b input, will not be modified, array of length N
+     * \param x output, array of length N
+     * \param ctx per-call state, work memory and statistics
+     * \param use_initial_guess set to true if x contains an intial
+     * guess to the solution
+     * \return error code
+     */
+    ReturnCode solve(const scalar_t* b, scalar_t* x,
+                     SolveContext<scalar_t>& ctx,
+                     bool use_initial_guess=false) const;
+
   private:
     void setup_tree() override;
     void setup_reordering() override;
@@ -223,6 +335,12 @@ namespace strumpack {
 
     void permute_matrix_values();
 
+    bool setup_value_scatter(integer_t N, const integer_t* row_ptr,
+                             const integer_t* col_ind);
+    bool scatter_matrix_values(integer_t N, const integer_t* row_ptr,
+                               const integer_t* col_ind,
+                               const scalar_t* values);
+
     ReturnCode solve_internal(const scalar_t* b, scalar_t* x,
                               bool use_initial_guess=false) override;
     ReturnCode solve_internal(const DenseM_t& b, DenseM_t& x,
@@ -230,14 +348,25 @@ namespace strumpack {
 
     void delete_factors_internal() override;
 
-    void transform_x0(DenseM_t& x, DenseM_t& xtmp);
-    void transform_b(const DenseM_t& b, DenseM_t& bloc);
-    void transform_x(DenseM_t& x, DenseM_t& xtmp);
+    void transform_x0(DenseM_t& x, DenseM_t& xtmp) const;
+    void transform_b(const DenseM_t& b, DenseM_t& bloc) const;
+    void transform_x(DenseM_t& x, DenseM_t& xtmp) const;
 
     std::unique_ptr<CSRMatrix<scalar_t,integer_t>> mat_;
     std::unique_ptr<MatrixReordering<scalar_t,integer_t>> nd_;
     std::unique_ptr<EliminationTree<scalar_t,integer_t>> tree_;
 
+    /**
+     * Map from each nonzero of the user's input matrix to its
+     * position in the permuted, scaled and symmetrized matrix mat_,
+     * and the row and column scaling (matching + equilibration),
+     * both in the original input ordering. Built on the first call
+     * to update_matrix_values, so that subsequent updates with the
+     * same sparsity pattern only need a single gather/scale pass.
+     */
+    std::vector<integer_t> scatter_;
+    std::vector<real_t> scatter_Dr_, scatter_Dc_;
+
     using SPBase_t = SparseSolverBase<scalar_t,integer_t>;
     using SPBase_t::opts_;
     using SPBase_t::is_root_;
@@ -246,6 +375,11 @@ namespace strumpack {
     using SPBase_t::factored_;
     using SPBase_t::reordered_;
     using SPBase_t::Krylov_its_;
+    using SPBase_t::coords_;
+    using SPBase_t::coords_dim_;
+
+    // uses the reordering and the symbolic factorization
+    template<typename,typename> friend class SparseSolverBatched;
   };
 
   template<typename scalar_t,typename integer_t>
@@ -0,0 +1,247 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+/**
+ * \file StrumpackSparseSolverBatched.hpp
+ * \brief Contains the definition of the batched sparse solver, for
+ * many small sparse systems with the same sparsity pattern.
+ */
+#ifndef STRUMPACK_SPARSE_SOLVER_BATCHED_HPP
+#define STRUMPACK_SPARSE_SOLVER_BATCHED_HPP
+
+#include <vector>
+
+#include "StrumpackOptions.hpp"
+#include "StrumpackSparseSolver.hpp"
+
+namespace strumpack {
+
+  template<typename scalar_t,typename integer_t> class FrontalMatrix;
+
+  /**
+   * \class SparseSolverBatched
+   *
+   * \brief Direct solver for a batch of (small) sparse linear systems
+   * which all have the same sparsity pattern, but different values.
+   *
+   * The fill reducing ordering, the separator tree and the structure
+   * of the frontal matrices (including the maps used for the
+   * assembly and the extend-add) are computed only once, from the
+   * sparsity pattern, in reorder(). factor() then computes the
+   * multifrontal LU factorization of a batch of systems, given as an
+   * array of values for each system, and solve() solves with all
+   * factored systems. Work is distributed over the systems, each
+   * system is handled by a single thread using sequential dense
+   * kernels on its (small) frontal matrices. This is much more
+   * efficient than a SparseSolver per system when the individual
+   * systems are too small to benefit from the tree and node
+   * parallelism within a single factorization.
+   *
+   * Only dense frontal matrices are supported, and no matching or
+   * equilibration is applied, options().compression() and
+   * options().matching() are ignored. The fronts are factored with
+   * partial pivoting within the diagonal block. Tiny pivots are
+   * replaced when options().replace_tiny_pivots() is set, with a
+   * threshold relative to the norm of each system. There is no
+   * iterative refinement.
+   *
+   * \tparam scalar_t can be: float, double, std::complex<float> or
+   * std::complex<double>.
+   *
+   * \tparam integer_t defaults to a regular int. This should be a
+   * __signed__ integer type.
+   *
+   * \see SparseSolver
+   */
+  template<typename scalar_t,typename integer_t=int>
+  class SparseSolverBatched {
+    using real_t = typename RealType<scalar_t>::value_type;
+
+  public:
+    /**
+     * Constructor for the batched solver class.
+     *
+     * \param verbose flag to enable/disable output to cout
+     * \param root flag to denote whether this process is the root
+     * MPI process, only the root will print certain messages
+     */
+    SparseSolverBatched(bool verbose=true, bool root=true);
+
+    /**
+     * Constructor, the command line arguments are passed to the
+     * options, but are only parsed when calling
+     * options().set_from_command_line().
+     */
+    SparseSolverBatched(int argc, char* argv[],
+                        bool verbose=true, bool root=true);
+
+    /**
+     * Destructor.
+     */
+    ~SparseSolverBatched();
+
+    /**
+     * Set the sparsity pattern shared by all systems, in CSR
+     * format. This clears the reordering and the factors.
+     *
+     * \param N number of rows and columns
+     * \param row_ptr indices in col_ind for the start of each row,
+     * array of size N+1
+     * \param col_ind column indices of each nonzero, array of size
+     * row_ptr[N]
+     */
+    void set_csr_pattern(integer_t N, const integer_t* row_ptr,
+                         const integer_t* col_ind);
+
+    /**
+     * Set the sparsity pattern shared by all systems, the values of
+     * A are not used.
+     */
+    void set_pattern(const CSRMatrix<scalar_t,integer_t>& A);
+
+    /**
+     * Compute the fill reducing ordering and the symbolic
+     * factorization, for the pattern set with set_csr_pattern. This
+     * is only done once, and reused by all calls to factor.
+     *
+     * \param nx, ny, nz geometry, only used with
+     * ReorderingStrategy::GEOMETRIC, see SparseSolver::reorder
+     */
+    ReturnCode reorder(int nx=1, int ny=1, int nz=1);
+
+    /**
+     * Compute the LU factorization of a batch of systems. The values
+     * of system i are values[i*nnz() ... (i+1)*nnz()-1], in the same
+     * order as the column indices passed to set_csr_pattern. This
+     * will call reorder() if that was not done yet. Previous factors
+     * are released.
+     *
+     * \param batch the number of systems
+     * \param values the values of all systems, array of size
+     * batch*nnz()
+     * \param info on output, the return code for each system
+     * \return ReturnCode::SUCCESS if all systems were factored
+     * successfully, otherwise the return code of the first system
+     * that failed
+     */
+    ReturnCode factor(int batch, const scalar_t* values,
+                      std::vector<ReturnCode>& info);
+
+    /**
+     * Solve all factored systems, with a single right-hand side per
+     * system. The right-hand side of system i is b[i*size() ...
+     * (i+1)*size()-1], and the solution is stored in x, with the same
+     * layout.
+     *
+     * \param b right-hand sides, array of size batch()*size()
+     * \param x solutions, array of size batch()*size()
+     * \param info on output, the return code for each system
+     * \return ReturnCode::SUCCESS if all systems were solved
+     * successfully, otherwise the return code of the first system
+     * that failed
+     */
+    ReturnCode solve(const scalar_t* b, scalar_t* x,
+                     std::vector<ReturnCode>& info) const;
+
+    /**
+     * Solve with only system i of the factored batch.
+     *
+     * \param i index of the system, 0 <= i < batch()
+     * \param b right-hand side, array of size size()
+     * \param x solution, array of size size()
+     * \return the return code of the factorization of system i, or
+     * ReturnCode::MATRIX_NOT_SET if i is not in [0, batch()), in
+     * which case x is not modified
+     */
+    ReturnCode solve(int i, const scalar_t* b, scalar_t* x) const;
+
+    /**
+     * Number of rows/columns of each system.
+     */
+    integer_t size() const { return N_; }
+
+    /**
+     * Number of nonzeros in the pattern of each system, as set with
+     * set_csr_pattern.
+     */
+    integer_t nnz() const { return integer_t(ind_.size()); }
+
+    /**
+     * The number of systems that were factored in the last call to
+     * factor.
+     */
+    int batch() const { return batch_; }
+
+    /**
+     * Number of nonzeros in the (dense) factors of a single system.
+     */
+    std::size_t factor_nonzeros() const { return fsize_; }
+
+    SPOptions<scalar_t>& options() { return solver_.options(); }
+    const SPOptions<scalar_t>& options() const { return solver_.options(); }
+
+  private:
+    /**
+     * Symbolic information for a single front, F11, F12 and F21 are
+     * stored (column major) at offset f11 in the factors of each
+     * system, one after the other, the pivots at offset piv.
+     */
+    struct Front {
+      integer_t sep_begin, sep_end, lch, rch;
+      std::vector<integer_t> upd;
+      // position of each of the upd indices in the parent front
+      std::vector<integer_t> pmap;
+      std::size_t f11, piv;
+      integer_t dim_sep() const { return sep_end - sep_begin; }
+      integer_t dim_upd() const { return upd.size(); }
+    };
+
+    SparseSolver<scalar_t,integer_t> solver_;
+    bool is_root_;
+    integer_t N_ = 0;
+    std::vector<integer_t> ptr_, ind_;
+    bool reordered_ = false;
+    // fronts in postorder, the root is last
+    std::vector<Front> fronts_;
+    // for every nonzero in the pattern, position in the factors
+    std::vector<std::size_t> amap_;
+    std::size_t fsize_ = 0, psize_ = 0;
+    int batch_ = 0;
+    std::vector<scalar_t> factors_;
+    std::vector<int> piv_;
+    std::vector<ReturnCode> finfo_;
+
+    integer_t add_fronts(const FrontalMatrix<scalar_t,integer_t>* f);
+    ReturnCode factor_system(const scalar_t* values, scalar_t* F,
+                             int* piv) const;
+    void solve_system(const scalar_t* F, const int* piv,
+                      const scalar_t* b, scalar_t* x) const;
+  };
+
+} //end namespace strumpack
+
+#endif // STRUMPACK_SPARSE_SOLVER_BATCHED_HPP
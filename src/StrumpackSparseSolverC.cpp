@@ -93,6 +93,12 @@ using namespace strumpack;
 #define REZ(x) reinterpret_cast<std::complex<double>*>(x)
 #define CREZ(x) reinterpret_cast<const std::complex<double>*>(x)
 
+namespace {
+  MemoryReport report_of(STRUMPACK_SparseSolver S) {
+    switch_precision_return_as(memory_report(), MemoryReport);
+  }
+}
+
 extern "C" {
 
   void STRUMPACK_init_mt(STRUMPACK_SparseSolver* S,
@@ -445,6 +451,23 @@ extern "C" {
   int STRUMPACK_rank(STRUMPACK_SparseSolver S) { switch_precision_return_as(maximum_rank(), int); }
   long long STRUMPACK_factor_nonzeros(STRUMPACK_SparseSolver S) { switch_precision_return_as(factor_nonzeros(), int64_t); }
   long long STRUMPACK_factor_memory(STRUMPACK_SparseSolver S) { switch_precision_return_as(factor_memory(), int64_t); }
+  STRUMPACK_MEMORY_REPORT STRUMPACK_memory_report(STRUMPACK_SparseSolver S) {
+    auto r = report_of(S);
+    STRUMPACK_MEMORY_REPORT c;
+    c.reordering = r.reordering; c.symbolic = r.symbolic;
+    c.factor = r.factor; c.solve = r.solve;
+    c.dense = r.dense; c.BLR = r.BLR; c.HSS = r.HSS;
+    c.HODLR = r.HODLR; c.lossy = r.lossy; c.CB = r.CB;
+    c.levels = r.level_factors.size();
+    return c;
+  }
+  void STRUMPACK_memory_report_level(STRUMPACK_SparseSolver S, int level,
+                                     long long* factors, long long* CB) {
+    auto r = report_of(S);
+    bool valid = level >= 0 && level < int(r.level_factors.size());
+    *factors = valid ? r.level_factors[level] : 0;
+    *CB = valid ? r.level_CB[level] : 0;
+  }
 
 
 
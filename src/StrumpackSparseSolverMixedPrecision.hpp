@@ -152,6 +152,8 @@ namespace strumpack {
     SparseSolver<factor_t,integer_t> solver_;
     SPOptions<refine_t> opts_;
     int Krylov_its_ = 0;
+    // work space for the solve in factor_t precision
+    DenseMatrix<factor_t> work_;
   };
 
   template<typename factor_t,typename refine_t,typename integer_t>
@@ -139,6 +139,13 @@ namespace strumpack {
   }
 
   // explicit template instantiations (only for real!)
+  template void kd_partition
+  (DenseMatrix<float>& p, std::vector<std::size_t>& nc,
+   std::size_t cluster_size, int* perm);
+  template void kd_partition
+  (DenseMatrix<double>& p, std::vector<std::size_t>& nc,
+   std::size_t cluster_size, int* perm);
+
   template structured::ClusterTree recursive_kd
   (DenseMatrix<float>& p, std::size_t cluster_size, int* perm);
   template structured::ClusterTree recursive_kd
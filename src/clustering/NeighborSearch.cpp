@@ -33,6 +33,7 @@
 #include <numeric>
 #include <random>
 #include <chrono>
+#include <cassert>
 
 #include "NeighborSearch.hpp"
 #include "kernel/Metrics.hpp"
@@ -40,23 +41,62 @@
 namespace strumpack {
 
   //--------------DISTANCE MATRIX------------------
+  template<typename real_t> inline real_t squared_norm
+  (std::size_t d, const real_t* x) {
+    real_t r(0.);
+#pragma omp simd reduction(+:r)
+    for (std::size_t i=0; i<d; i++)
+      r += x[i] * x[i];
+    return r;
+  }
+
+  template<typename real_t> void distances_squared
+  (const DenseMatrix<real_t>& X, const DenseMatrix<real_t>& Y,
+   DenseMatrix<real_t>& D) {
+    assert(X.rows() == Y.rows());
+    auto d = X.rows();
+    auto m = X.cols();
+    auto n = Y.cols();
+    D.resize(m, n);
+    if (!m || !n) return;
+    std::vector<real_t> nx(m), ny(n);
+    for (std::size_t i=0; i<m; i++)
+      nx[i] = squared_norm(d, X.ptr(0, i));
+    for (std::size_t j=0; j<n; j++)
+      ny[j] = squared_norm(d, Y.ptr(0, j));
+    gemm(Trans::T, Trans::N, real_t(-2.), X, Y, real_t(0.), D);
+    for (std::size_t j=0; j<n; j++) {
+      auto Dj = D.ptr(0, j);
+#pragma omp simd
+      for (std::size_t i=0; i<m; i++)
+        Dj[i] = std::max(real_t(0.), Dj[i] + nx[i] + ny[j]);
+    }
+  }
+
+  // copy the columns index_subset of data to a new matrix
+  template<typename real_t, typename int_t>
+  DenseMatrix<real_t> gather_columns
+  (const DenseMatrix<real_t>& data,
+   const std::vector<int_t>& index_subset) {
+    auto d = data.rows();
+    DenseMatrix<real_t> S(d, index_subset.size());
+    for (std::size_t j=0; j<index_subset.size(); j++)
+      std::copy(data.ptr(0, index_subset[j]),
+                data.ptr(0, index_subset[j])+d, S.ptr(0, j));
+    return S;
+  }
+
   // finds distances between all data points with indices from
   // index_subset
   template<typename real_t, typename int_t>
   DenseMatrix<real_t> find_distance_matrix
   (const DenseMatrix<real_t>& data,
    const std::vector<int_t>& index_subset) {
-    auto subset_size = index_subset.size();
-    DenseMatrix<real_t> distances(subset_size, subset_size);
-    auto d = data.rows();
-    for (std::size_t i=0; i<subset_size; i++) {
+    auto S = gather_columns(data, index_subset);
+    DenseMatrix<real_t> distances;
+    distances_squared(S, S, distances);
+    for (std::size_t i=0; i<index_subset.size(); i++)
       distances(i, i) = real_t(0);
-      for (std::size_t j=i+1; j<subset_size; j++) {
-        distances(j, i) = Euclidean_distance_squared
-          (d, &data(0, index_subset[i]), &data(0, index_subset[j]));
-        distances(i, j) = distances(j, i);
-      }
-    }
     return distances;
   }
 
@@ -66,14 +106,9 @@ namespace strumpack {
   DenseMatrix<real_t> find_distance_matrix_from_subset
   (const DenseMatrix<real_t>& data,
    const std::vector<int_t>& index_subset) {
-    auto n = data.cols();
-    auto d = data.rows();
-    auto subset_size = index_subset.size();
-    DenseMatrix<real_t> distances(subset_size, n);
-    for (std::size_t j=0; j<n; j++)
-      for (std::size_t i=0; i<subset_size; i++)
-        distances(i, j) = Euclidean_distance_squared
-          (d, &data(0, index_subset[i]), &data(0, j));
+    auto S = gather_columns(data, index_subset);
+    DenseMatrix<real_t> distances;
+    distances_squared(S, data, distances);
     return distances;
   }
 
@@ -347,6 +382,484 @@ namespace strumpack {
               << " after " << iter << " iterations" << std::endl;
   }
 
+  //------------ Reusable k-nearest-neighbor index ----------------
+
+  // insert (dist, idx) in the max-heap heap[0:hs], holding at most k
+  // elements, skipping idx if it is already in the heap
+  template<typename real_t, typename int_t> inline void heap_insert
+  (std::pair<real_t,int_t>* heap, std::size_t& hs, std::size_t k,
+   real_t dist, int_t idx, bool check_duplicates) {
+    if (!k || (hs == k && !(dist < heap[0].first))) return;
+    if (check_duplicates)
+      for (std::size_t i=0; i<hs; i++)
+        if (heap[i].second == idx) return;
+    if (hs < k) {
+      heap[hs++] = std::make_pair(dist, idx);
+      std::push_heap(heap, heap+hs);
+    } else {
+      std::pop_heap(heap, heap+hs);
+      heap[hs-1] = std::make_pair(dist, idx);
+      std::push_heap(heap, heap+hs);
+    }
+  }
+
+  // sort the heaps and write them to the k x m output matrices
+  template<typename real_t, typename int_t> void heaps_to_matrices
+  (std::vector<std::pair<real_t,int_t>>& heaps, std::vector<std::size_t>& hs,
+   std::size_t k, DenseMatrix<int_t>& neighbors,
+   DenseMatrix<real_t>& scores) {
+    auto m = hs.size();
+    neighbors.resize(k, m);
+    scores.resize(k, m);
+#pragma omp parallel for
+    for (std::size_t j=0; j<m; j++) {
+      auto h = heaps.data() + j*k;
+      std::sort_heap(h, h+hs[j]);
+      for (std::size_t i=0; i<hs[j]; i++) {
+        neighbors(i, j) = h[i].second;
+        scores(i, j) = h[i].first;
+      }
+    }
+  }
+
+  template<typename real_t, typename int_t>
+  NeighborIndex<real_t,int_t>::NeighborIndex
+  (const DenseMatrix<real_t>& data, NeighborIndexType type,
+   std::size_t leaf_size, std::size_t trees, unsigned int seed)
+    : type_(type), n_(data.cols()), d_(data.rows()), leaf_size_(leaf_size) {
+    if (type_ == NeighborIndexType::AUTO)
+      type_ = (d_ <= 16) ? NeighborIndexType::KD_TREE :
+        NeighborIndexType::RP_FOREST;
+    switch (type_) {
+    case NeighborIndexType::BRUTE_FORCE: {
+      trees_.resize(1);
+      trees_[0].perm.resize(n_);
+      std::iota(trees_[0].perm.begin(), trees_[0].perm.end(), 0);
+    } break;
+    case NeighborIndexType::KD_TREE: {
+      if (!leaf_size_) leaf_size_ = 32;
+      trees_.resize(1);
+      auto& t = trees_[0];
+      t.perm.resize(n_);
+      std::iota(t.perm.begin(), t.perm.end(), 0);
+      t.nodes.reserve(4 * n_ / leaf_size_ + 1);
+      t.geom.reserve(2 * d_ * (4 * n_ / leaf_size_ + 1));
+      if (n_) split_kd(t, 0, n_, data);
+    } break;
+    case NeighborIndexType::RP_FOREST: {
+      if (!leaf_size_) leaf_size_ = 256;
+      trees_.resize(std::max(std::size_t(1), trees));
+      // the trees are independent, build them in parallel
+#pragma omp parallel for schedule(dynamic)
+      for (std::size_t i=0; i<trees_.size(); i++) {
+        auto& t = trees_[i];
+        t.perm.resize(n_);
+        std::iota(t.perm.begin(), t.perm.end(), 0);
+        t.nodes.reserve(4 * n_ / leaf_size_ + 1);
+        std::vector<real_t> proj(n_);
+        std::mt19937 gen(seed + 7919 * i);
+        if (n_) split_rp(t, 0, n_, data, proj, gen);
+      }
+    } break;
+    default: break;
+    }
+    set_points(data);
+  }
+
+  template<typename real_t, typename int_t> void
+  NeighborIndex<real_t,int_t>::set_points(const DenseMatrix<real_t>& data) {
+    const auto& perm = trees_[0].perm;
+    X_ = DenseMatrix<real_t>(d_, n_);
+    nrm2_.resize(n_);
+    pos_.resize(n_);
+#pragma omp parallel for
+    for (std::size_t i=0; i<n_; i++) {
+      std::copy(data.ptr(0, perm[i]), data.ptr(0, perm[i])+d_, X_.ptr(0, i));
+      nrm2_[i] = squared_norm(d_, X_.ptr(0, i));
+      pos_[perm[i]] = i;
+    }
+  }
+
+  template<typename real_t, typename int_t> std::size_t
+  NeighborIndex<real_t,int_t>::leaves() const {
+    std::size_t nl = 0;
+    for (auto& t : trees_) {
+      if (t.nodes.empty()) nl++;
+      for (auto& nd : t.nodes)
+        if (nd.leaf()) nl++;
+    }
+    return nl;
+  }
+
+  template<typename real_t, typename int_t> std::int64_t
+  NeighborIndex<real_t,int_t>::split_kd
+  (Tree& t, std::size_t lo, std::size_t hi, const DenseMatrix<real_t>& data) {
+    std::int64_t id = t.nodes.size();
+    t.nodes.emplace_back();
+    t.nodes[id].lo = lo;
+    t.nodes[id].hi = hi;
+    // bounding box of the points in this node
+    t.geom.resize(t.geom.size() + 2*d_);
+    auto bmin = &t.geom[2*d_*id];
+    auto bmax = bmin + d_;
+    for (std::size_t j=0; j<d_; j++)
+      bmin[j] = bmax[j] = data(j, t.perm[lo]);
+    for (std::size_t i=lo+1; i<hi; i++)
+      for (std::size_t j=0; j<d_; j++) {
+        bmin[j] = std::min(bmin[j], data(j, t.perm[i]));
+        bmax[j] = std::max(bmax[j], data(j, t.perm[i]));
+      }
+    if (hi - lo <= leaf_size_) return id;
+    // split at the median of the coordinate with the largest spread
+    std::size_t dim = 0;
+    for (std::size_t j=1; j<d_; j++)
+      if (bmax[j] - bmin[j] > bmax[dim] - bmin[dim]) dim = j;
+    if (!(bmax[dim] > bmin[dim])) return id; // all points coincide
+    auto mid = lo + (hi - lo) / 2;
+    std::nth_element
+      (t.perm.begin()+lo, t.perm.begin()+mid, t.perm.begin()+hi,
+       [&](const int_t& a, const int_t& b) {
+         return data(dim, a) < data(dim, b); });
+    t.nodes[id].dim = dim;
+    t.nodes[id].split = data(dim, t.perm[mid]);
+    auto l = split_kd(t, lo, mid, data);
+    auto r = split_kd(t, mid, hi, data);
+    t.nodes[id].left = l;
+    t.nodes[id].right = r;
+    return id;
+  }
+
+  template<typename real_t, typename int_t> std::int64_t
+  NeighborIndex<real_t,int_t>::split_rp
+  (Tree& t, std::size_t lo, std::size_t hi, const DenseMatrix<real_t>& data,
+   std::vector<real_t>& proj, std::mt19937& gen) {
+    std::int64_t id = t.nodes.size();
+    t.nodes.emplace_back();
+    t.nodes[id].lo = lo;
+    t.nodes[id].hi = hi;
+    if (hi - lo <= leaf_size_) return id;
+    // random direction, split at the median of the projections
+    auto dir_offset = t.geom.size();
+    t.geom.resize(dir_offset + d_);
+    auto dir = &t.geom[dir_offset];
+    std::normal_distribution<real_t> normal_distr(0.0, 1.0);
+    for (std::size_t j=0; j<d_; j++)
+      dir[j] = normal_distr(gen);
+    auto nrm = std::sqrt(squared_norm(d_, dir));
+    for (std::size_t j=0; j<d_; j++)
+      dir[j] /= nrm;
+    for (std::size_t i=lo; i<hi; i++) {
+      auto x = data.ptr(0, t.perm[i]);
+      real_t p(0.);
+#pragma omp simd reduction(+:p)
+      for (std::size_t j=0; j<d_; j++)
+        p += dir[j] * x[j];
+      proj[t.perm[i]] = p;
+    }
+    auto mid = lo + (hi - lo) / 2;
+    std::nth_element
+      (t.perm.begin()+lo, t.perm.begin()+mid, t.perm.begin()+hi,
+       [&](const int_t& a, const int_t& b) {
+         return (proj[a] < proj[b]) || ((proj[a] == proj[b]) && (a < b)); });
+    t.nodes[id].dim = dir_offset;
+    t.nodes[id].split = proj[t.perm[mid]];
+    auto l = split_rp(t, lo, mid, data, proj, gen);
+    auto r = split_rp(t, mid, hi, data, proj, gen);
+    t.nodes[id].left = l;
+    t.nodes[id].right = r;
+    return id;
+  }
+
+  // copy the points of a leaf to L (the leaves of the first tree are
+  // already contiguous in X_)
+  template<typename real_t, typename int_t> void
+  NeighborIndex<real_t,int_t>::leaf_points
+  (const Tree& t, const Node& leaf, DenseMatrix<real_t>& L) const {
+    auto m = leaf.hi - leaf.lo;
+    L.resize(d_, m);
+    for (std::size_t i=0; i<m; i++) {
+      auto x = X_.ptr(0, pos_[t.perm[leaf.lo+i]]);
+      std::copy(x, x+d_, L.ptr(0, i));
+    }
+  }
+
+  template<typename real_t, typename int_t> void
+  NeighborIndex<real_t,int_t>::search_kd
+  (const real_t* q, std::size_t k, std::size_t node,
+   std::pair<real_t,int_t>* heap, std::size_t& hs) const {
+    const auto& t = trees_[0];
+    const auto& nd = t.nodes[node];
+    if (nd.leaf()) {
+      // points of the leaf are stored contiguously in X_
+      for (std::size_t i=nd.lo; i<nd.hi; i++) {
+        auto x = X_.ptr(0, i);
+        real_t dist(0.);
+#pragma omp simd reduction(+:dist)
+        for (std::size_t j=0; j<d_; j++)
+          dist += (x[j] - q[j]) * (x[j] - q[j]);
+        heap_insert(heap, hs, k, dist, t.perm[i], false);
+      }
+      return;
+    }
+    std::size_t near = nd.left, far = nd.right;
+    if (q[nd.dim] >= nd.split) std::swap(near, far);
+    search_kd(q, k, near, heap, hs);
+    // distance from q to the bounding box of the far child
+    auto bmin = &t.geom[2*d_*far];
+    auto bmax = bmin + d_;
+    real_t bdist(0.);
+    for (std::size_t j=0; j<d_; j++) {
+      auto e = std::max(real_t(0.), std::max(bmin[j] - q[j], q[j] - bmax[j]));
+      bdist += e * e;
+    }
+    if (hs < k || bdist < heap[0].first)
+      search_kd(q, k, far, heap, hs);
+  }
+
+  template<typename real_t, typename int_t> void
+  NeighborIndex<real_t,int_t>::search_rp
+  (const real_t* q, std::size_t k,
+   std::pair<real_t,int_t>* heap, std::size_t& hs) const {
+    // path from the root to the leaf of q in the first tree
+    std::vector<std::size_t> path;
+    for (const auto& t : trees_) {
+      std::size_t node = 0;
+      while (!t.nodes[node].leaf()) {
+        if (&t == &trees_[0]) path.push_back(node);
+        const auto& nd = t.nodes[node];
+        auto dir = &t.geom[nd.dim];
+        real_t p(0.);
+#pragma omp simd reduction(+:p)
+        for (std::size_t j=0; j<d_; j++)
+          p += dir[j] * q[j];
+        node = (p < nd.split) ? nd.left : nd.right;
+      }
+      if (&t == &trees_[0]) path.push_back(node);
+      const auto& nd = t.nodes[node];
+      for (std::size_t i=nd.lo; i<nd.hi; i++) {
+        auto x = X_.ptr(0, pos_[t.perm[i]]);
+        real_t dist(0.);
+#pragma omp simd reduction(+:dist)
+        for (std::size_t j=0; j<d_; j++)
+          dist += (x[j] - q[j]) * (x[j] - q[j]);
+        heap_insert(heap, hs, k, dist, t.perm[i], true);
+      }
+    }
+    if (hs == k) return;
+    // the leaves of q hold fewer than k distinct points, complete
+    // the list with an exhaustive search over the smallest subtree of
+    // the first tree on the path of q with at least k points, as in
+    // query_all_rp
+    const auto& t0 = trees_[0];
+    std::size_t node = 0;
+    for (auto it=path.rbegin(); it!=path.rend(); it++)
+      if (t0.nodes[*it].hi - t0.nodes[*it].lo >= k) {
+        node = *it;
+        break;
+      }
+    for (std::size_t i=t0.nodes[node].lo; i<t0.nodes[node].hi; i++) {
+      auto x = X_.ptr(0, i);
+      real_t dist(0.);
+#pragma omp simd reduction(+:dist)
+      for (std::size_t j=0; j<d_; j++)
+        dist += (x[j] - q[j]) * (x[j] - q[j]);
+      heap_insert(heap, hs, k, dist, t0.perm[i], true);
+    }
+  }
+
+  template<typename real_t, typename int_t> void
+  NeighborIndex<real_t,int_t>::search_brute
+  (const DenseMatrix<real_t>& Q, std::size_t k,
+   std::vector<std::pair<real_t,int_t>>& heaps,
+   std::vector<std::size_t>& hs) const {
+    // blocks of queries against blocks of points, with GEMM
+    const std::size_t B = 512;
+    auto m = Q.cols();
+    auto nb = (m + B - 1) / B;
+#pragma omp parallel for schedule(dynamic)
+    for (std::size_t b=0; b<nb; b++) {
+      auto mb = std::min(B, m - b*B);
+      auto Qb = ConstDenseMatrixWrapperPtr(d_, mb, Q, 0, b*B);
+      // norms of the queries are computed once per block, the norms
+      // of the indexed points are stored in nrm2_
+      std::vector<real_t> nq(mb);
+      for (std::size_t i=0; i<mb; i++)
+        nq[i] = squared_norm(d_, Qb->ptr(0, i));
+      DenseMatrix<real_t> D(mb, B);
+      for (std::size_t c=0; c<n_; c+=B) {
+        auto nc = std::min(B, n_ - c);
+        auto Xc = ConstDenseMatrixWrapperPtr(d_, nc, X_, 0, c);
+        DenseMatrixWrapper<real_t> Dc(mb, nc, D, 0, 0);
+        gemm(Trans::T, Trans::N, real_t(-2.), *Qb, *Xc, real_t(0.), Dc);
+        for (std::size_t i=0; i<mb; i++) {
+          auto qi = b*B + i;
+          for (std::size_t j=0; j<nc; j++)
+            heap_insert(heaps.data()+qi*k, hs[qi], k,
+                        std::max(real_t(0.), Dc(i, j) + nq[i] + nrm2_[c+j]),
+                        trees_[0].perm[c+j], false);
+        }
+      }
+    }
+  }
+
+  template<typename real_t, typename int_t> void
+  NeighborIndex<real_t,int_t>::query
+  (const DenseMatrix<real_t>& Q, std::size_t k,
+   DenseMatrix<int_t>& neighbors, DenseMatrix<real_t>& scores) const {
+    assert(Q.rows() == d_);
+    k = std::min(k, n_);
+    auto m = Q.cols();
+    if (!k) {
+      neighbors.resize(0, m);
+      scores.resize(0, m);
+      return;
+    }
+    std::vector<std::pair<real_t,int_t>> heaps(m*k);
+    std::vector<std::size_t> hs(m, 0);
+    if (type_ == NeighborIndexType::BRUTE_FORCE)
+      search_brute(Q, k, heaps, hs);
+    else {
+#pragma omp parallel for schedule(dynamic, 64)
+      for (std::size_t i=0; i<m; i++) {
+        if (type_ == NeighborIndexType::KD_TREE)
+          search_kd(Q.ptr(0, i), k, 0, heaps.data()+i*k, hs[i]);
+        else search_rp(Q.ptr(0, i), k, heaps.data()+i*k, hs[i]);
+      }
+    }
+    heaps_to_matrices(heaps, hs, k, neighbors, scores);
+  }
+
+  template<typename real_t, typename int_t> void
+  NeighborIndex<real_t,int_t>::query_all
+  (std::size_t k, DenseMatrix<int_t>& neighbors,
+   DenseMatrix<real_t>& scores, int refine_iterations) const {
+    k = std::min(k, n_);
+    if (!k) {
+      neighbors.resize(0, n_);
+      scores.resize(0, n_);
+      return;
+    }
+    if (type_ != NeighborIndexType::RP_FOREST) {
+      // X_ holds the points ordered by perm, query in that order for
+      // locality, then scatter the results back
+      std::vector<std::pair<real_t,int_t>> heaps(n_*k);
+      std::vector<std::size_t> hs(n_, 0);
+      if (type_ == NeighborIndexType::BRUTE_FORCE)
+        search_brute(X_, k, heaps, hs);
+      else {
+#pragma omp parallel for schedule(dynamic, 64)
+        for (std::size_t i=0; i<n_; i++)
+          search_kd(X_.ptr(0, i), k, 0, heaps.data()+i*k, hs[i]);
+      }
+      std::vector<std::pair<real_t,int_t>> oheaps(n_*k);
+      std::vector<std::size_t> ohs(n_);
+      const auto& perm = trees_[0].perm;
+#pragma omp parallel for
+      for (std::size_t i=0; i<n_; i++) {
+        std::copy(heaps.begin()+i*k, heaps.begin()+i*k+hs[i],
+                  oheaps.begin()+perm[i]*k);
+        ohs[perm[i]] = hs[i];
+      }
+      heaps_to_matrices(oheaps, ohs, k, neighbors, scores);
+      return;
+    }
+    std::vector<std::pair<real_t,int_t>> heaps(n_*k);
+    std::vector<std::size_t> hs(n_, 0);
+    query_all_rp(k, heaps, hs, refine_iterations);
+    heaps_to_matrices(heaps, hs, k, neighbors, scores);
+  }
+
+  template<typename real_t, typename int_t> void
+  NeighborIndex<real_t,int_t>::query_all_rp
+  (std::size_t k, std::vector<std::pair<real_t,int_t>>& heaps,
+   std::vector<std::size_t>& hs, int refine_iterations) const {
+    // every point is in exactly one leaf per tree, so the leaves of
+    // a tree can be processed concurrently
+    for (const auto& t : trees_) {
+      std::vector<std::size_t> leaves;
+      for (std::size_t i=0; i<t.nodes.size(); i++)
+        if (t.nodes[i].leaf()) leaves.push_back(i);
+#pragma omp parallel for schedule(dynamic)
+      for (std::size_t l=0; l<leaves.size(); l++) {
+        const auto& nd = t.nodes[leaves[l]];
+        auto m = nd.hi - nd.lo;
+        DenseMatrix<real_t> L, D;
+        if (&t == &trees_[0]) {
+          auto Lw = ConstDenseMatrixWrapperPtr(d_, m, X_, 0, nd.lo);
+          distances_squared(*Lw, *Lw, D);
+        } else {
+          leaf_points(t, nd, L);
+          distances_squared(L, L, D);
+        }
+        for (std::size_t i=0; i<m; i++) {
+          auto p = t.perm[nd.lo+i];
+          D(i, i) = real_t(0.);
+          for (std::size_t j=0; j<m; j++)
+            heap_insert(heaps.data()+p*k, hs[p], k, D(i, j),
+                        t.perm[nd.lo+j], true);
+        }
+      }
+    }
+    // neighbors of neighbors are likely neighbors, only the closest
+    // few of each are explored
+    const std::size_t kk = std::min(k, std::size_t(10));
+    for (int it=0; it<refine_iterations; it++) {
+      std::vector<int_t> nbrs(n_*kk);
+#pragma omp parallel for
+      for (std::size_t p=0; p<n_; p++) {
+        std::vector<std::pair<real_t,int_t>> h
+          (heaps.begin()+p*k, heaps.begin()+p*k+hs[p]);
+        std::sort(h.begin(), h.end());
+        for (std::size_t i=0; i<kk; i++)
+          nbrs[p*kk+i] = h[std::min(i, h.size()-1)].second;
+      }
+#pragma omp parallel for schedule(dynamic, 64)
+      for (std::size_t p=0; p<n_; p++) {
+        auto x = X_.ptr(0, pos_[p]);
+        for (std::size_t i=0; i<kk; i++) {
+          auto q = nbrs[p*kk+i];
+          for (std::size_t j=0; j<kk; j++) {
+            auto r = nbrs[q*kk+j];
+            if (r == p) continue;
+            auto y = X_.ptr(0, pos_[r]);
+            real_t dist(0.);
+#pragma omp simd reduction(+:dist)
+            for (std::size_t jj=0; jj<d_; jj++)
+              dist += (x[jj] - y[jj]) * (x[jj] - y[jj]);
+            heap_insert(heaps.data()+p*k, hs[p], k, dist, r, true);
+          }
+        }
+      }
+    }
+    // leaves with fewer than k points can leave some lists
+    // incomplete. Complete those with an exhaustive search over the
+    // smallest subtree of the first tree that contains p and at least
+    // k points. Since the splits are at the median, this subtree has
+    // less than 2k+1 points (or is a leaf), so the cost is O(k d) per
+    // point.
+    const auto& t0 = trees_[0];
+#pragma omp parallel for schedule(dynamic, 64)
+    for (std::size_t p=0; p<n_; p++) {
+      if (hs[p] == k) continue;
+      std::size_t pp = pos_[p], node = 0;
+      while (!t0.nodes[node].leaf()) {
+        const auto& nd = t0.nodes[node];
+        std::size_t c = (pp < t0.nodes[nd.left].hi) ? nd.left : nd.right;
+        if (t0.nodes[c].hi - t0.nodes[c].lo < k) break;
+        node = c;
+      }
+      auto x = X_.ptr(0, pp);
+      for (std::size_t i=t0.nodes[node].lo; i<t0.nodes[node].hi; i++) {
+        auto y = X_.ptr(0, i);
+        real_t dist(0.);
+#pragma omp simd reduction(+:dist)
+        for (std::size_t j=0; j<d_; j++)
+          dist += (x[j] - y[j]) * (x[j] - y[j]);
+        heap_insert(heaps.data()+p*k, hs[p], k, dist, t0.perm[i], true);
+      }
+    }
+  }
+
   // explicit template instantiations
   template void find_approximate_neighbors
   (const DenseMatrix<float>& data, std::size_t num_iters,
@@ -357,4 +870,14 @@ namespace strumpack {
    std::size_t ann_number, DenseMatrix<unsigned int>& neighbors,
    DenseMatrix<double>& scores);
 
+  template void distances_squared
+  (const DenseMatrix<float>& X, const DenseMatrix<float>& Y,
+   DenseMatrix<float>& D);
+  template void distances_squared
+  (const DenseMatrix<double>& X, const DenseMatrix<double>& Y,
+   DenseMatrix<double>& D);
+
+  template class NeighborIndex<float,unsigned int>;
+  template class NeighborIndex<double,unsigned int>;
+
 } // end namespace strumpack
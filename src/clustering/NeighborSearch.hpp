@@ -29,6 +29,11 @@
 #ifndef NEIGHBOR_SEARCH_HPP
 #define NEIGHBOR_SEARCH_HPP
 
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "dense/DenseMatrix.hpp"
 
 
@@ -40,6 +45,184 @@ namespace strumpack {
    std::size_t ann_number, DenseMatrix<int_t>& neighbors,
    DenseMatrix<real_t>& scores);
 
+  /**
+   * Compute the squared Euclidean distances between all columns of
+   * X (d x m) and all columns of Y (d x n), as D(i,j) = |x_i|^2 +
+   * |y_j|^2 - 2 x_i^T y_j. The cross terms are computed with a single
+   * GEMM call. Small negative values, due to cancellation, are
+   * clipped to zero.
+   *
+   * \param X first set of points, d x m, one point per column
+   * \param Y second set of points, d x n, one point per column
+   * \param D output, will be resized to m x n
+   */
+  template<typename real_t> void distances_squared
+  (const DenseMatrix<real_t>& X, const DenseMatrix<real_t>& Y,
+   DenseMatrix<real_t>& D);
+
+  /**
+   * Type of search structure used by a NeighborIndex.
+   * \ingroup Enumerations
+   */
+  enum class NeighborIndexType {
+    AUTO,        /*!< KD_TREE for low dimension, else RP_FOREST      */
+    BRUTE_FORCE, /*!< Exact, blocked GEMM over all points            */
+    KD_TREE,     /*!< Exact, kd-tree with bounding box pruning       */
+    RP_FOREST    /*!< Approximate, forest of random projection trees */
+  };
+
+  /**
+   * Return a short string with the name of the neighbor index type.
+   */
+  inline std::string get_name(NeighborIndexType t) {
+    switch (t) {
+    case NeighborIndexType::AUTO: return "auto";
+    case NeighborIndexType::BRUTE_FORCE: return "brute_force";
+    case NeighborIndexType::KD_TREE: return "kdtree";
+    case NeighborIndexType::RP_FOREST: return "rpforest";
+    default: return "unknown";
+    }
+  }
+
+  /**
+   * \class NeighborIndex
+   * \brief Reusable index for k-nearest-neighbor queries.
+   *
+   * The index is built once for a set of n points in d dimensions,
+   * and can then be queried for the k nearest neighbors (in the
+   * Euclidean metric) of the points themselves, see query_all(), or
+   * of a batch of new points, see query(). Queries are processed in
+   * parallel using OpenMP.
+   *
+   * The index keeps its own copy of the points, reordered so that
+   * the points in each leaf are stored contiguously. Distances are
+   * evaluated with vectorizable loops, or, for the all-pairs leaf
+   * computations of the random projection forest, with GEMM.
+   *
+   * Neighbors are returned as a k x m matrix of point indices, and a
+   * k x m matrix of squared distances, with the neighbors of each
+   * point sorted by increasing distance. A point is its own nearest
+   * neighbor. This is the same format as used by
+   * find_approximate_neighbors.
+   *
+   * \tparam real_t real type of the coordinates, float or double
+   * \tparam int_t integer type for the neighbor indices
+   */
+  template<typename real_t, typename int_t=std::uint32_t>
+  class NeighborIndex {
+  public:
+    /**
+     * Build the index.
+     *
+     * \param data the points, d x n, one point per column. This is
+     * copied, the matrix can be destroyed after construction.
+     * \param type type of search structure, AUTO selects a kd-tree
+     * for d <= 16 and a random projection forest otherwise
+     * \param leaf_size maximum number of points in a leaf, 0 selects
+     * a default (32 for the kd-tree, 256 for the forest)
+     * \param trees number of random projection trees, only used
+     * for RP_FOREST
+     * \param seed seed for the random projection directions
+     */
+    NeighborIndex(const DenseMatrix<real_t>& data,
+                  NeighborIndexType type=NeighborIndexType::AUTO,
+                  std::size_t leaf_size=0, std::size_t trees=4,
+                  unsigned int seed=1);
+
+    /**
+     * Find the k nearest neighbors of each column of Q, among the
+     * indexed points. Exact for BRUTE_FORCE and KD_TREE,
+     * approximate for RP_FOREST. For RP_FOREST, if the leaves of a
+     * query hold fewer than k points, the list is completed with a
+     * search over a subtree of the first tree with at least k points.
+     *
+     * \param Q query points, d x m
+     * \param k number of neighbors, larger values are clipped to
+     * points(), for k == 0 the outputs are empty (0 x m)
+     * \param neighbors output, k x m, indices of the neighbors
+     * \param scores output, k x m, squared distances
+     */
+    void query(const DenseMatrix<real_t>& Q, std::size_t k,
+               DenseMatrix<int_t>& neighbors,
+               DenseMatrix<real_t>& scores) const;
+
+    /**
+     * Find the k nearest neighbors of all indexed points, ie, the
+     * k-nearest-neighbor graph. For RP_FOREST, the leaf distances
+     * are computed with GEMM, followed by refine_iterations sweeps
+     * over the neighbors of neighbors.
+     *
+     * \param k number of neighbors, larger values are clipped to
+     * points(), for k == 0 the outputs are empty (0 x n)
+     * \param neighbors output, k x n, indices of the neighbors
+     * \param scores output, k x n, squared distances
+     * \param refine_iterations neighbors-of-neighbors sweeps, only
+     * used for RP_FOREST
+     */
+    void query_all(std::size_t k, DenseMatrix<int_t>& neighbors,
+                   DenseMatrix<real_t>& scores,
+                   int refine_iterations=1) const;
+
+    /** Type of search structure actually used (never AUTO). */
+    NeighborIndexType type() const { return type_; }
+    /** Number of indexed points. */
+    std::size_t points() const { return n_; }
+    /** Dimension of the indexed points. */
+    std::size_t dimension() const { return d_; }
+    /** Number of leaves over all trees. */
+    std::size_t leaves() const;
+
+  private:
+    struct Node {
+      // node contains the points perm[lo:hi] of its tree
+      std::size_t lo, hi;
+      // children, or -1 for a leaf
+      std::int64_t left = -1, right = -1;
+      // kd-tree: split dimension, RP-tree: offset of the direction
+      std::size_t dim = 0;
+      real_t split = 0;
+      bool leaf() const { return left < 0; }
+    };
+    struct Tree {
+      std::vector<Node> nodes;
+      std::vector<int_t> perm;
+      // kd-tree: per node bounding box, 2*d values
+      // RP-tree: per internal node direction, d values
+      std::vector<real_t> geom;
+    };
+
+    NeighborIndexType type_;
+    std::size_t n_ = 0, d_ = 0, leaf_size_ = 0;
+    std::vector<Tree> trees_;
+    // copy of the points, ordered as trees_[0].perm, so the leaves of
+    // the first tree are contiguous. Point p is stored in column
+    // pos_[p] of X_, and nrm2_[i] = |X_(:,i)|^2
+    DenseMatrix<real_t> X_;
+    std::vector<real_t> nrm2_;
+    std::vector<int_t> pos_;
+
+    std::int64_t split_kd(Tree& t, std::size_t lo, std::size_t hi,
+                          const DenseMatrix<real_t>& data);
+    std::int64_t split_rp(Tree& t, std::size_t lo, std::size_t hi,
+                          const DenseMatrix<real_t>& data,
+                          std::vector<real_t>& proj,
+                          std::mt19937& gen);
+    void set_points(const DenseMatrix<real_t>& data);
+    void leaf_points(const Tree& t, const Node& leaf,
+                     DenseMatrix<real_t>& L) const;
+    void search_kd(const real_t* q, std::size_t k, std::size_t node,
+                   std::pair<real_t,int_t>* heap, std::size_t& hs) const;
+    void search_rp(const real_t* q, std::size_t k,
+                   std::pair<real_t,int_t>* heap, std::size_t& hs) const;
+    void search_brute(const DenseMatrix<real_t>& Q, std::size_t k,
+                      std::vector<std::pair<real_t,int_t>>& heaps,
+                      std::vector<std::size_t>& hs) const;
+    void query_all_rp(std::size_t k,
+                      std::vector<std::pair<real_t,int_t>>& heaps,
+                      std::vector<std::size_t>& hs,
+                      int refine_iterations) const;
+  };
+
 } // end namespace strumpack
 
 #endif // NEIGHBOR_SEARCH_HPP
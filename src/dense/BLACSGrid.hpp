@@ -162,6 +162,8 @@ namespace strumpack {
       //std::cout << "WARNING copying a BLACS grid is expensive!!" << std::endl;
       comm_ = grid.Comm();
       P_ = grid.P();
+      row_comm_.reset();
+      col_comm_.reset();
       setup();
       return *this;
     }
@@ -182,6 +184,8 @@ namespace strumpack {
       npcols_ = grid.npcols_;
       prow_ = grid.prow_;
       pcol_ = grid.pcol_;
+      row_comm_ = std::move(grid.row_comm_);
+      col_comm_ = std::move(grid.col_comm_);
       // make sure that grid's context is not destroyed in its
       // destructor
       grid.ctxt_ = -1;
@@ -263,6 +267,28 @@ namespace strumpack {
      */
     bool active() const { return prow_ != -1; }
 
+    /**
+     * Communicator with the active processes in this rank's process
+     * row, the rank in this communicator is pcol(). This is created
+     * on the first call, and then reused, so the first call is
+     * collective on Comm_active(). Should only be called on active
+     * ranks.
+     */
+    const MPIComm& row_comm() const {
+      if (!row_comm_) split_rows_cols();
+      return *row_comm_;
+    }
+
+    /**
+     * Communicator with the active processes in this rank's process
+     * column, the rank in this communicator is prow(). See
+     * row_comm().
+     */
+    const MPIComm& col_comm() const {
+      if (!col_comm_) split_rows_cols();
+      return *col_comm_;
+    }
+
     /**
      * For a given number of processes procs, find a 2D layout. This
      * will try to find a 2D layout using P, or as close to P as
@@ -311,6 +337,7 @@ namespace strumpack {
     int prow_ = -1;
     int pcol_ = -1;
     std::unique_ptr<MPIComm> active_comm_;
+    mutable std::unique_ptr<MPIComm> row_comm_, col_comm_;
 
     void setup() {
       layout(P_, nprows_, npcols_);
@@ -340,10 +367,18 @@ namespace strumpack {
       }
     }
 
+    void split_rows_cols() const {
+      assert(active());
+      const auto& c = Comm_active();
+      row_comm_.reset(new MPIComm(c.split(prow_, pcol_)));
+      col_comm_.reset(new MPIComm(c.split(pcol_, prow_)));
+    }
+
     void transpose_inplace() {
       std::swap(ctxt_, ctxt_T_);
       std::swap(nprows_, npcols_);
       std::swap(prow_, pcol_);
+      std::swap(row_comm_, col_comm_);
     }
 
     friend std::ostream& operator<<(std::ostream& os, const BLACSGrid* g);
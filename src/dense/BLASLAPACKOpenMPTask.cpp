@@ -26,6 +26,9 @@
  *             Division).
  *
  */
+#include <memory>
+#include <algorithm>
+
 #include "BLASLAPACKOpenMPTask.hpp"
 #include "StrumpackFortranCInterface.h"
 
@@ -531,6 +534,112 @@ namespace strumpack {
   }
 
 
+  template<typename scalar> int
+  getrf_tiled_omp_task(int n1, int n2, scalar* A11, int lda11,
+                       scalar* A12, int lda12, scalar* A21, int lda21,
+                       scalar* A22, int lda22, int* ipiv, int nb,
+                       typename RealType<scalar>::value_type thresh) {
+    using real_t = typename RealType<scalar>::value_type;
+    int info = 0;
+    auto replace_tiny = [&](int i0, int n) {
+      for (int i=i0; i<i0+n; i++) {
+        auto& d = A11[i+i*lda11];
+        if (std::abs(d) < thresh)
+          d = (std::real(d) < 0) ? -thresh : thresh;
+      }
+    };
+#if defined(STRUMPACK_USE_OPENMP_TASK_DEPEND)
+    const int nt1 = (n1 + nb - 1) / nb, nt2 = (n2 + nb - 1) / nb,
+      nt = nt1 + nt2;
+    // offset and size of tile t, within A11/A12 or A21/A22
+    auto off = [&](int t) { return (t < nt1) ? t*nb : (t-nt1)*nb; };
+    auto sz = [&](int t) {
+      return (t < nt1) ? std::min(nb, n1-t*nb) : std::min(nb, n2-(t-nt1)*nb);
+    };
+    auto ld = [&](int i, int j) {
+      return (i < nt1) ? ((j < nt1) ? lda11 : lda12) :
+        ((j < nt1) ? lda21 : lda22);
+    };
+    auto tile = [&](int i, int j) {
+      scalar* A = (i < nt1) ? ((j < nt1) ? A11 : A12) :
+        ((j < nt1) ? A21 : A22);
+      return A + off(i) + off(j)*ld(i, j);
+    };
+    // dummies for task dependencies: C for the first n1 rows of a
+    // tile column, R for tile (k,j) in the first n1 rows (after
+    // step k), U for tiles in the last n2 rows
+    std::unique_ptr<int[]> C_(new int[nt]()), R_(new int[nt1*nt]()),
+      U_(new int[std::max(1, nt2*nt)]());
+    auto C = C_.get(); auto R = R_.get(); auto U = U_.get();
+    for (int k=0; k<nt1; k++) {
+      const int kb = sz(k), k0 = k*nb;
+#pragma omp task default(shared) firstprivate(k,kb,k0)  \
+  depend(inout:C[k]) priority(2)
+      {
+        int ierr = blas::getrf(n1-k0, kb, tile(k, k), lda11, ipiv+k0);
+        if (ierr) {
+#pragma omp critical
+          if (!info || ierr+k0 < info) info = ierr + k0;
+        }
+        for (int i=k0; i<k0+kb; i++) ipiv[i] += k0;
+        if (thresh > real_t(0.)) replace_tiny(k0, kb);
+      }
+      for (int j=k+1; j<nt; j++) {
+        // pivoting, triangular solve and update of the first n1 rows
+        // of tile column j
+#pragma omp task default(shared) firstprivate(k,kb,k0,j)        \
+  depend(in:C[k]) depend(inout:C[j]) depend(out:R[k+nt1*j])     \
+  priority(j == k+1 ? 1 : 0)
+        {
+          scalar* Aj = tile(0, j);
+          const int ldj = ld(0, j), nc = sz(j);
+          blas::laswp(nc, Aj, ldj, k0+1, k0+kb, ipiv, 1);
+          blas::trsm('L', 'L', 'N', 'U', kb, nc, scalar(1.),
+                     tile(k, k), lda11, Aj+k0, ldj);
+          if (n1 > k0+kb)
+            blas::gemm('N', 'N', n1-k0-kb, nc, kb, scalar(-1.),
+                       tile(k, k)+kb, lda11, Aj+k0, ldj,
+                       scalar(1.), Aj+k0+kb, ldj);
+        }
+      }
+      for (int i=nt1; i<nt; i++) {
+        const int ik = (i-nt1)+nt2*k;
+#pragma omp task default(shared) firstprivate(i,k,kb,ik)        \
+  depend(in:C[k]) depend(inout:U[ik])
+        blas::trsm('R', 'U', 'N', 'N', sz(i), kb, scalar(1.),
+                   tile(k, k), lda11, tile(i, k), lda21);
+        for (int j=k+1; j<nt; j++) {
+          const int ij = (i-nt1)+nt2*j, kj = k+nt1*j;
+#pragma omp task default(shared) firstprivate(i,j,k,kb,ik,ij,kj)        \
+  depend(in:U[ik],R[kj]) depend(inout:U[ij])
+          blas::gemm('N', 'N', sz(i), sz(j), kb, scalar(-1.),
+                     tile(i, k), lda21, tile(k, j), ld(k, j),
+                     scalar(1.), tile(i, j), ld(i, j));
+        }
+      }
+    }
+#pragma omp taskwait
+    // apply the row interchanges from later panels to the columns of L
+    for (int c=0; c<nt1-1; c++)
+#pragma omp task default(shared) firstprivate(c)
+      blas::laswp(sz(c), tile(0, c), lda11, (c+1)*nb+1, n1, ipiv, 1);
+#pragma omp taskwait
+#else
+    info = blas::getrf(n1, n1, A11, lda11, ipiv);
+    if (thresh > real_t(0.)) replace_tiny(0, n1);
+    if (n2) {
+      blas::laswp(n2, A12, lda12, 1, n1, ipiv, 1);
+      blas::trsm('L', 'L', 'N', 'U', n1, n2, scalar(1.),
+                 A11, lda11, A12, lda12);
+      blas::trsm('R', 'U', 'N', 'N', n2, n1, scalar(1.),
+                 A11, lda11, A21, lda21);
+      blas::gemm('N', 'N', n2, n2, n1, scalar(-1.), A21, lda21,
+                 A12, lda12, scalar(1.), A22, lda22);
+    }
+#endif
+    return info;
+  }
+
   template<typename scalar>
   int getrs_omp_task(char t, int m, int n, const scalar *a, int lda,
                      const int* piv, scalar *b, int ldb,
@@ -597,6 +706,11 @@ namespace strumpack {
   template int getrf_omp_task(int m, int n, std::complex<float>* a, int lda, int* ipiv, int depth);
   template int getrf_omp_task(int m, int n, std::complex<double>* a, int lda, int* ipiv, int depth);
 
+  template int getrf_tiled_omp_task(int n1, int n2, float* A11, int lda11, float* A12, int lda12, float* A21, int lda21, float* A22, int lda22, int* ipiv, int nb, float thresh);
+  template int getrf_tiled_omp_task(int n1, int n2, double* A11, int lda11, double* A12, int lda12, double* A21, int lda21, double* A22, int lda22, int* ipiv, int nb, double thresh);
+  template int getrf_tiled_omp_task(int n1, int n2, std::complex<float>* A11, int lda11, std::complex<float>* A12, int lda12, std::complex<float>* A21, int lda21, std::complex<float>* A22, int lda22, int* ipiv, int nb, float thresh);
+  template int getrf_tiled_omp_task(int n1, int n2, std::complex<double>* A11, int lda11, std::complex<double>* A12, int lda12, std::complex<double>* A21, int lda21, std::complex<double>* A22, int lda22, int* ipiv, int nb, double thresh);
+
   template int getrs_omp_task(char t, int m, int n, const float *a, int lda, const int* piv, float *b, int ldb, int depth);
   template int getrs_omp_task(char t, int m, int n, const double *a, int lda, const int* piv, double *b, int ldb, int depth);
   template int getrs_omp_task(char t, int m, int n, const std::complex<float> *a, int lda, const int* piv, std::complex<float> *b, int ldb, int depth);
@@ -43,6 +43,22 @@ namespace strumpack {
   template<typename scalar> void trsm_omp_task(char s, char ul, char ta, char d, int m, int n, scalar alpha, const scalar* a, int lda, scalar* b, int ldb, int depth);
   template<typename scalar> void laswp_omp_task(int n, scalar* a, int lda, int k1, int k2, const int* ipiv, int incx, int depth);
   template<typename scalar> int getrf_omp_task(int m, int n, scalar* a, int lda, int* ipiv, int depth);
+
+  /**
+   * Partial LU factorization of the 2x2 block matrix [A11 A12; A21
+   * A22], with A11 n1 x n1 and A22 n2 x n2. Computes A11 = P L U,
+   * A12 <- L^{-1} P^T A12, A21 <- A21 U^{-1} and the Schur complement
+   * A22 <- A22 - A21 A12. Rows are only interchanged within A11 (and
+   * A12). The matrix is split in nb x nb tiles, and the panel
+   * factorizations (with partial pivoting within the panel column),
+   * triangular solves and Schur complement updates are all OpenMP
+   * tasks with dependencies, so that the next panel can be factored
+   * while the trailing update is still in progress (look-ahead).
+   * Should be called from within an OpenMP parallel region. Diagonal
+   * elements of U smaller than thresh (if > 0) are replaced by
+   * thresh. Returns the LAPACK getrf info for A11.
+   */
+  template<typename scalar> int getrf_tiled_omp_task(int n1, int n2, scalar* A11, int lda11, scalar* A12, int lda12, scalar* A21, int lda21, scalar* A22, int lda22, int* ipiv, int nb, typename RealType<scalar>::value_type thresh);
   template<typename scalar> int getrs_omp_task(char t, int m, int n, const scalar *a, int lda, const int* piv, scalar *b, int ldb, int depth);
 
 } // end namespace strumpack
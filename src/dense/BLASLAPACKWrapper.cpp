@@ -516,6 +516,23 @@ namespace strumpack {
         (char* norm, strumpack_blas_int* m, strumpack_blas_int* n,
          const std::complex<double>* a, strumpack_blas_int* lda, double* work);
 
+      void STRUMPACK_FC_GLOBAL(sgecon,SGECON)
+        (char* norm, strumpack_blas_int* n, const float* a, strumpack_blas_int* lda,
+         float* anorm, float* rcond, float* work, strumpack_blas_int* iwork,
+         strumpack_blas_int* info);
+      void STRUMPACK_FC_GLOBAL(dgecon,DGECON)
+        (char* norm, strumpack_blas_int* n, const double* a, strumpack_blas_int* lda,
+         double* anorm, double* rcond, double* work, strumpack_blas_int* iwork,
+         strumpack_blas_int* info);
+      void STRUMPACK_FC_GLOBAL(cgecon,CGECON)
+        (char* norm, strumpack_blas_int* n, const std::complex<float>* a,
+         strumpack_blas_int* lda, float* anorm, float* rcond,
+         std::complex<float>* work, float* rwork, strumpack_blas_int* info);
+      void STRUMPACK_FC_GLOBAL(zgecon,ZGECON)
+        (char* norm, strumpack_blas_int* n, const std::complex<double>* a,
+         strumpack_blas_int* lda, double* anorm, double* rcond,
+         std::complex<double>* work, double* rwork, strumpack_blas_int* info);
+
       void STRUMPACK_FC_GLOBAL(sgesvd,SGESVD)
         (char* jobu, char* jobvt, strumpack_blas_int* m, strumpack_blas_int* n, float* a, strumpack_blas_int* lda,
          float* s, float* u, strumpack_blas_int* ldu, float* vt, strumpack_blas_int* ldvt,
@@ -1745,6 +1762,47 @@ namespace strumpack {
       } else return STRUMPACK_FC_GLOBAL(zlange,ZLANGE)(&norm, &m_, &n_, a, &lda_, nullptr);
     }
 
+    int gecon(char norm, int n, const float* a, int lda,
+              float anorm, float* rcond) {
+      strumpack_blas_int n_ = n, lda_ = lda, info;
+      std::unique_ptr<float[]> work(new float[std::max(1, 4*n)]);
+      std::unique_ptr<strumpack_blas_int[]> iwork
+        (new strumpack_blas_int[std::max(1, n)]);
+      STRUMPACK_FC_GLOBAL(sgecon,SGECON)
+        (&norm, &n_, a, &lda_, &anorm, rcond, work.get(), iwork.get(), &info);
+      return info;
+    }
+    int gecon(char norm, int n, const double* a, int lda,
+              double anorm, double* rcond) {
+      strumpack_blas_int n_ = n, lda_ = lda, info;
+      std::unique_ptr<double[]> work(new double[std::max(1, 4*n)]);
+      std::unique_ptr<strumpack_blas_int[]> iwork
+        (new strumpack_blas_int[std::max(1, n)]);
+      STRUMPACK_FC_GLOBAL(dgecon,DGECON)
+        (&norm, &n_, a, &lda_, &anorm, rcond, work.get(), iwork.get(), &info);
+      return info;
+    }
+    int gecon(char norm, int n, const std::complex<float>* a, int lda,
+              float anorm, float* rcond) {
+      strumpack_blas_int n_ = n, lda_ = lda, info;
+      std::unique_ptr<std::complex<float>[]> work
+        (new std::complex<float>[std::max(1, 2*n)]);
+      std::unique_ptr<float[]> rwork(new float[std::max(1, 2*n)]);
+      STRUMPACK_FC_GLOBAL(cgecon,CGECON)
+        (&norm, &n_, a, &lda_, &anorm, rcond, work.get(), rwork.get(), &info);
+      return info;
+    }
+    int gecon(char norm, int n, const std::complex<double>* a, int lda,
+              double anorm, double* rcond) {
+      strumpack_blas_int n_ = n, lda_ = lda, info;
+      std::unique_ptr<std::complex<double>[]> work
+        (new std::complex<double>[std::max(1, 2*n)]);
+      std::unique_ptr<double[]> rwork(new double[std::max(1, 2*n)]);
+      STRUMPACK_FC_GLOBAL(zgecon,ZGECON)
+        (&norm, &n_, a, &lda_, &anorm, rcond, work.get(), rwork.get(), &info);
+      return info;
+    }
+
     int gesvd(char jobu, char jobvt, int m, int n, float* a, int lda,
               float* s, float* u, int ldu, float* vt, int ldvt) {
       strumpack_blas_int info, lwork = -1, m_ = m, n_ = n, lda_ = lda, ldu_ = ldu, ldvt_ = ldvt;
@@ -45,6 +45,16 @@ namespace strumpack {
   template<class T> struct RealType { typedef T value_type; };
   template<class T> struct RealType<std::complex<T>> { typedef T value_type; };
 
+  /**
+   * Type with the next lower precision, used to store data in
+   * reduced precision. This is float for double, std::complex<float>
+   * for std::complex<double>, and T itself otherwise.
+   */
+  template<class T> struct LowerPrecision { typedef T value_type; };
+  template<> struct LowerPrecision<double> { typedef float value_type; };
+  template<> struct LowerPrecision<std::complex<double>>
+  { typedef std::complex<float> value_type; };
+
   namespace blas {
 
     inline bool my_conj(bool a) { return a; }
@@ -758,6 +768,20 @@ namespace strumpack {
     double lange(char norm, int m, int n,
                  const std::complex<double> *a, int lda);
 
+    /**
+     * Estimate the reciprocal condition number of a general matrix,
+     * given its LU factorization (from getrf) and the norm of the
+     * original matrix, computed with lange. norm is '1' or 'I'.
+     */
+    int gecon(char norm, int n, const float* a, int lda,
+              float anorm, float* rcond);
+    int gecon(char norm, int n, const double* a, int lda,
+              double anorm, double* rcond);
+    int gecon(char norm, int n, const std::complex<float>* a, int lda,
+              float anorm, float* rcond);
+    int gecon(char norm, int n, const std::complex<double>* a, int lda,
+              double anorm, double* rcond);
+
     int gesvd(char jobu, char jobvt, int m, int n, float* a, int lda,
               float* s, float* u, int ldu, float* vt, int ldvt);
     int gesvd(char jobu, char jobvt, int m, int n, double* a, int lda,
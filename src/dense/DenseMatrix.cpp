@@ -174,9 +174,15 @@ namespace strumpack {
   (random::RandomGeneratorBase<typename RealType<scalar_t>::
    value_type>& rgen) {
     TIMER_TIME(TaskType::RANDOM_GENERATE, 1, t_gen);
-    for (std::size_t j=0; j<cols(); j++)
-      for (std::size_t i=0; i<rows(); i++)
-        operator()(i,j) = rgen.get();
+    if (is_complex<scalar_t>()) {
+      // only the real part is random
+      std::vector<real_t> R(rows()*cols());
+      rgen.fill(rows(), cols(), R.data(), rows());
+      for (std::size_t j=0; j<cols(); j++)
+        for (std::size_t i=0; i<rows(); i++)
+          operator()(i,j) = R[i+j*rows()];
+    } else
+      rgen.fill(rows(), cols(), reinterpret_cast<real_t*>(data()), ld());
     STRUMPACK_FLOPS(rgen.flops_per_prng()*cols()*rows());
   }
 
@@ -458,13 +458,29 @@ namespace strumpack {
   template<typename scalar_t> void DistributedMatrix<scalar_t>::random
   (random::RandomGeneratorBase<typename RealType<scalar_t>::
    value_type>& rgen) {
-    if (!active()) return;
+    // with a counter based generator, every process generates its
+    // part of the same global matrix, independent of the process grid
+    auto cb = dynamic_cast<random::PhiloxGenerator<real_t>*>(&rgen);
+    if (!active()) {
+      // keep the generator in sync with the active processes
+      if (cb) cb->next_block();
+      return;
+    }
     TIMER_TIME(TaskType::RANDOM_GENERATE, 1, t_gen);
     int rlo, rhi, clo, chi;
     lranges(rlo, rhi, clo, chi);
-    for (int c=clo; c<chi; ++c)
-      for (int r=rlo; r<rhi; ++r)
-        operator()(r,c) = rgen.get();
+    if (cb) {
+#pragma omp parallel for
+      for (int c=clo; c<chi; ++c) {
+        auto gc = coll2g(c);
+        for (int r=rlo; r<rhi; ++r)
+          operator()(r,c) = (*cb)(rowl2g(r), gc);
+      }
+      cb->next_block();
+    } else
+      for (int c=clo; c<chi; ++c)
+        for (int r=rlo; r<rhi; ++r)
+          operator()(r,c) = rgen.get();
     STRUMPACK_FLOPS(rgen.flops_per_prng()*(chi-clo)*(rhi-rlo));
   }
 
@@ -912,6 +912,29 @@ namespace strumpack {
   (const BLACSGrid* subg, int master, DistributedMatrix<scalar_t>& b,
    std::vector<scalar_t*>& pbuf);
 
+  /**
+   * Partial LU factorization of the distributed 2x2 block matrix
+   * [F11 F12; F21 F22], the distributed counterpart of
+   * getrf_tiled_omp_task. Computes F11 = P L U, F12 <- L^{-1} P^T
+   * F12, F21 <- F21 U^{-1} and F22 <- F22 - F21 F12, with rows only
+   * interchanged within F11 (and F12). All matrices should be on the
+   * same process grid, with square MB x MB blocks.
+   *
+   * The tiles are the blocks of the 2D block-cyclic distribution.
+   * Each panel is gathered and factored (redundantly) in its process
+   * column, and broadcast along the process rows with nonblocking
+   * collectives. The next panel is updated and factored first, so
+   * that its broadcast overlaps with the trailing update, which is
+   * done with OpenMP tasks. Diagonal elements of U smaller than
+   * thresh (if > 0) are replaced by thresh. The pivots are returned
+   * in piv, in the ScaLAPACK format, see DistributedMatrix::LU.
+   * Returns 0, or the (1-based) index of a zero pivot.
+   */
+  template<typename scalar_t> int getrf_tiled_mpi
+  (DistributedMatrix<scalar_t>& F11, DistributedMatrix<scalar_t>& F12,
+   DistributedMatrix<scalar_t>& F21, DistributedMatrix<scalar_t>& F22,
+   std::vector<int>& piv, typename RealType<scalar_t>::value_type thresh);
+
 } // end namespace strumpack
 
 #endif // DISTRIBUTED_MATRIX_HPP
@@ -0,0 +1,317 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#include "DistributedMatrix.hpp"
+#include "ScaLAPACKWrapper.hpp"
+
+namespace strumpack {
+
+  template<typename scalar_t> int getrf_tiled_mpi
+  (DistributedMatrix<scalar_t>& F11, DistributedMatrix<scalar_t>& F12,
+   DistributedMatrix<scalar_t>& F21, DistributedMatrix<scalar_t>& F22,
+   std::vector<int>& piv, typename RealType<scalar_t>::value_type thresh) {
+    using real_t = typename RealType<scalar_t>::value_type;
+    if (!F11.active() || !F11.rows()) return 0;
+    const int n1 = F11.rows(), nb = F11.MB(),
+      npr = F11.nprows(), npc = F11.npcols(),
+      pr = F11.prow(), pc = F11.pcol(),
+      lr1 = F11.lrows(), lc1 = F11.lcols(),
+      lr2 = F21.lrows(), lc2 = F12.lcols(),
+      nt = (n1 + nb - 1) / nb;
+    assert(F11.NB() == nb);
+    assert(!F12.cols() || (F12.MB() == nb && F12.NB() == nb));
+    assert(!F21.rows() || (F21.MB() == nb && F21.NB() == nb));
+    auto A11 = [&](int r, int c) { return F11.data() + r + c*F11.ld(); };
+    auto A12 = [&](int r, int c) { return F12.data() + r + c*F12.ld(); };
+    auto A21 = [&](int r, int c) { return F21.data() + r + c*F21.ld(); };
+    auto A22 = [&](int r, int c) { return F22.data() + r + c*F22.ld(); };
+    // number of local rows/columns with global index < g
+    auto lrow = [&](int g, int q) {
+      return scalapack::numroc(g, nb, q, 0, npr); };
+    auto lcol = [&](int g) { return scalapack::numroc(g, nb, pc, 0, npc); };
+
+    // rank in rcomm is pcol, rank in ccomm is prow
+    const auto& rcomm = F11.grid()->row_comm();
+    const auto& ccomm = F11.grid()->col_comm();
+
+    piv.assign(lr1 + nb, 0);
+    int info = 0;
+
+    // Panel k, as broadcast along the process rows: the kb x kb
+    // diagonal block L\U, followed by the local rows of L below the
+    // diagonal block (first from F11, then from F21, leading
+    // dimension lda), and the pivots (relative to the panel).
+    struct Panel {
+      std::vector<scalar_t> buf;
+      std::vector<int> ipiv;
+      MPI_Request req[2];
+      int kb = 0, lda = 0;
+    } P[2];
+
+    auto resize_panel = [&](int k, Panel& p) {
+      const int k0 = k*nb;
+      p.kb = std::min(nb, n1-k0);
+      p.lda = lr1 - lrow(k0+p.kb, pr) + lr2;
+      p.buf.resize(p.kb*p.kb + p.lda*p.kb);
+      p.ipiv.resize(p.kb);
+    };
+
+    // Factor panel k, redundantly on all processes in process column
+    // k % npc, after gathering the panel in that process column.
+    auto factor_panel = [&](int k, Panel& p) {
+      resize_panel(k, p);
+      const int k0 = k*nb, kb = p.kb, m = n1-k0,
+        lrk = lrow(k0, pr), lck = lcol(k0), r = lr1 - lrk;
+      std::vector<int> cnt(npr), displ(npr);
+      for (int q=0; q<npr; q++) {
+        cnt[q] = (lrow(n1, q) - lrow(k0, q)) * kb;
+        displ[q] = q ? displ[q-1] + cnt[q-1] : 0;
+      }
+      std::vector<scalar_t> gbuf(m*kb), D(m*kb);
+      for (int j=0; j<kb; j++)
+        std::copy(A11(lrk, lck+j), A11(lrk, lck+j)+r,
+                  gbuf.data()+displ[pr]+j*r);
+      ccomm.all_gather_v(gbuf.data(), cnt.data(), displ.data());
+      // block-cyclic local to global row index, for process row q
+      auto l2g = [&](int l, int q) {
+        return (l / nb * npr + q) * nb + l % nb; };
+      for (int q=0; q<npr; q++) {
+        const int rq = cnt[q] / kb, l0 = lrow(k0, q);
+        for (int j=0; j<kb; j++)
+          for (int i=0; i<rq; i++)
+            D[l2g(l0+i, q)-k0+j*m] = gbuf[displ[q]+i+j*rq];
+      }
+      int ierr = blas::getrf(m, kb, D.data(), m, p.ipiv.data());
+      if (ierr && !info) info = ierr + k0;
+      if (thresh > real_t(0.))
+        for (int i=0; i<kb; i++) {
+          auto& d = D[i+i*m];
+          if (std::abs(d) < thresh)
+            d = (std::real(d) < 0) ? -thresh : thresh;
+        }
+      for (int j=0; j<kb; j++) {
+        for (int i=0; i<r; i++)
+          *A11(lrk+i, lck+j) = D[l2g(lrk+i, pr)-k0+j*m];
+        std::copy(&D[j*m], &D[j*m]+kb, &p.buf[j*kb]);
+      }
+      if (lr2)
+        blas::trsm('R', 'U', 'N', 'N', lr2, kb, scalar_t(1.),
+                   D.data(), m, A21(0, lck), F21.ld());
+      const int a = p.lda - lr2, lrk1 = lr1 - a;
+      auto L = p.buf.data() + kb*kb;
+      for (int j=0; j<kb; j++) {
+        std::copy(A11(lrk1, lck+j), A11(lrk1, lck+j)+a, L+j*p.lda);
+        if (lr2)
+          std::copy(A21(0, lck+j), A21(0, lck+j)+lr2, L+a+j*p.lda);
+      }
+    };
+
+    auto bcast_panel = [&](int k, Panel& p) {
+      resize_panel(k, p);
+      rcomm.ibroadcast_from(p.buf.data(), p.buf.size(), k % npc, &p.req[0]);
+      rcomm.ibroadcast_from(p.ipiv.data(), p.kb, k % npc, &p.req[1]);
+    };
+
+    // Apply the row interchanges of panel k to all local columns of
+    // F11 and F12, except to panel k itself, with point-to-point
+    // messages within the process columns.
+    auto swap_rows = [&](int k, const Panel& p) {
+      const int k0 = k*nb, lck = lcol(k0);
+      std::vector<scalar_t*> cols;
+      for (int c=0; c<lc1; c++)
+        if (pc != k % npc || c < lck || c >= lck+p.kb)
+          cols.push_back(A11(0, c));
+      for (int c=0; c<lc2; c++)
+        cols.push_back(A12(0, c));
+      const std::size_t nc = cols.size();
+      // rows pos[i] will get the original row src[i]
+      std::vector<int> pos, src;
+      auto find = [&](int g) {
+        auto i = std::find(pos.begin(), pos.end(), g) - pos.begin();
+        if (i == int(pos.size())) { pos.push_back(g); src.push_back(g); }
+        return i;
+      };
+      for (int i=0; i<p.kb; i++) {
+        auto a = find(k0+i), b = find(k0+p.ipiv[i]-1);
+        std::swap(src[a], src[b]);
+      }
+      auto owner = [&](int g) { return (g / nb) % npr; };
+      auto g2l = [&](int g) { return (g / nb) / npr * nb + g % nb; };
+      std::vector<std::vector<scalar_t>> sbuf(npr), rbuf(npr);
+      for (std::size_t i=0; i<pos.size(); i++) {
+        if (pos[i] == src[i]) continue;
+        if (owner(src[i]) == pr) {
+          auto& s = sbuf[owner(pos[i])];
+          auto l = g2l(src[i]);
+          for (std::size_t j=0; j<nc; j++) s.push_back(cols[j][l]);
+        }
+        if (owner(pos[i]) == pr) {
+          auto& r = rbuf[owner(src[i])];
+          r.resize(r.size() + nc);
+        }
+      }
+      std::vector<MPI_Request> reqs;
+      reqs.reserve(2*npr);
+      for (int q=0; q<npr; q++) {
+        if (q == pr) continue;
+        if (!sbuf[q].empty()) {
+          reqs.emplace_back();
+          ccomm.isend(sbuf[q], q, 0, &reqs.back());
+        }
+        if (!rbuf[q].empty()) {
+          reqs.emplace_back();
+          ccomm.irecv(rbuf[q].data(), rbuf[q].size(), q, 0, &reqs.back());
+        }
+      }
+      rbuf[pr] = std::move(sbuf[pr]);
+      wait_all(reqs);
+      std::vector<std::size_t> off(npr, 0);
+      for (std::size_t i=0; i<pos.size(); i++) {
+        if (pos[i] == src[i] || owner(pos[i]) != pr) continue;
+        auto q = owner(src[i]);
+        auto l = g2l(pos[i]);
+        for (std::size_t j=0; j<nc; j++) cols[j][l] = rbuf[q][off[q]++];
+      }
+    };
+
+    // Block row k of U, to the right of panel k, in F11 and F12,
+    // broadcast along the process columns.
+    std::vector<scalar_t> U;
+    auto solve_U_row = [&](int k, const Panel& p) {
+      const int k0 = k*nb, kb = p.kb, lrk = lrow(k0, pr),
+        lck1 = lcol(k0+kb), n11 = lc1 - lck1;
+      U.resize(kb*(n11 + lc2));
+      if (pr == k % npr) {
+        if (n11)
+          blas::trsm('L', 'L', 'N', 'U', kb, n11, scalar_t(1.),
+                     p.buf.data(), kb, A11(lrk, lck1), F11.ld());
+        if (lc2)
+          blas::trsm('L', 'L', 'N', 'U', kb, lc2, scalar_t(1.),
+                     p.buf.data(), kb, A12(lrk, 0), F12.ld());
+        for (int j=0; j<n11; j++)
+          std::copy(A11(lrk, lck1+j), A11(lrk, lck1+j)+kb, &U[j*kb]);
+        for (int j=0; j<lc2; j++)
+          std::copy(A12(lrk, j), A12(lrk, j)+kb, &U[(n11+j)*kb]);
+      }
+      if (!U.empty()) ccomm.broadcast_from(U.data(), U.size(), k % npr);
+    };
+
+    // Trailing update with panel k, of the local F11/F21 columns
+    // [c0, c1), and if upd2, of F12/F22. OpenMP task per tile column.
+    auto update = [&](int k, const Panel& p, int c0, int c1, bool upd2) {
+      const int k0 = k*nb, kb = p.kb, a = p.lda - lr2,
+        lrk1 = lr1 - a, lck1 = lcol(k0+kb), n11 = lc1 - lck1;
+      const scalar_t* L = p.buf.data() + kb*kb;
+      auto upd = [&](int n, const scalar_t* Uj, scalar_t* Ct, int ldt,
+                     scalar_t* Cb, int ldb) {
+        if (a)
+          blas::gemm('N', 'N', a, n, kb, scalar_t(-1.), L, p.lda,
+                     Uj, kb, scalar_t(1.), Ct, ldt);
+        if (lr2)
+          blas::gemm('N', 'N', lr2, n, kb, scalar_t(-1.), L+a, p.lda,
+                     Uj, kb, scalar_t(1.), Cb, ldb);
+      };
+#pragma omp parallel if(!omp_in_parallel()) default(shared)
+#pragma omp single nowait
+      {
+        for (int c=c0; c<c1; c+=nb) {
+#pragma omp task default(shared) firstprivate(c)
+          upd(std::min(nb, c1-c), &U[(c-lck1)*kb],
+              A11(lrk1, c), F11.ld(), A21(0, c), F21.ld());
+        }
+        if (upd2)
+          for (int c=0; c<lc2; c+=nb) {
+#pragma omp task default(shared) firstprivate(c)
+            upd(std::min(nb, lc2-c), &U[(n11+c)*kb],
+                A12(lrk1, c), F12.ld(), A22(0, c), F22.ld());
+          }
+#pragma omp taskwait
+      }
+    };
+
+    if (pc == 0) factor_panel(0, P[0]);
+    bcast_panel(0, P[0]);
+    for (int k=0; k<nt; k++) {
+      auto& p = P[k % 2];
+      MPI_Waitall(2, p.req, MPI_STATUSES_IGNORE);
+      const int k0 = k*nb, lrk = lrow(k0, pr), lck1 = lcol(k0+p.kb);
+      if (pr == k % npr)
+        for (int i=0; i<p.kb; i++)
+          piv[lrk+i] = k0 + p.ipiv[i];
+      swap_rows(k, p);
+      solve_U_row(k, p);
+      if (k+1 < nt) {
+        // look-ahead: update and factor panel k+1 first, its
+        // broadcast overlaps with the remaining trailing update
+        const bool next = pc == (k+1) % npc;
+        const int kb1 = std::min(nb, n1-(k+1)*nb);
+        if (next) {
+          update(k, p, lck1, lck1+kb1, false);
+          factor_panel(k+1, P[(k+1) % 2]);
+        }
+        bcast_panel(k+1, P[(k+1) % 2]);
+        update(k, p, next ? lck1+kb1 : lck1, lc1, true);
+      } else update(k, p, lck1, lc1, true);
+    }
+    // report the first zero pivot, over all process columns
+    if (!info) info = std::numeric_limits<int>::max();
+    info = F11.grid()->Comm_active().all_reduce(info, MPI_MIN);
+    return info == std::numeric_limits<int>::max() ? 0 : info;
+  }
+
+  // explicit template instantiations
+  template int getrf_tiled_mpi
+  (DistributedMatrix<float>& F11, DistributedMatrix<float>& F12,
+   DistributedMatrix<float>& F21, DistributedMatrix<float>& F22,
+   std::vector<int>& piv, float thresh);
+  template int getrf_tiled_mpi
+  (DistributedMatrix<double>& F11, DistributedMatrix<double>& F12,
+   DistributedMatrix<double>& F21, DistributedMatrix<double>& F22,
+   std::vector<int>& piv, double thresh);
+  template int getrf_tiled_mpi
+  (DistributedMatrix<std::complex<float>>& F11,
+   DistributedMatrix<std::complex<float>>& F12,
+   DistributedMatrix<std::complex<float>>& F21,
+   DistributedMatrix<std::complex<float>>& F22,
+   std::vector<int>& piv, float thresh);
+  template int getrf_tiled_mpi
+  (DistributedMatrix<std::complex<double>>& F11,
+   DistributedMatrix<std::complex<double>>& F12,
+   DistributedMatrix<std::complex<double>>& F21,
+   DistributedMatrix<std::complex<double>>& F22,
+   std::vector<int>& piv, double thresh);
+
+} // end namespace strumpack
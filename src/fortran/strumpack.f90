@@ -74,10 +74,11 @@ module strumpack
   enumerator :: STRUMPACK_ZFP_BLR_HODLR = 5
   enumerator :: STRUMPACK_LOSSLESS = 6
   enumerator :: STRUMPACK_LOSSY = 7
+  enumerator :: STRUMPACK_AUTO_COMPRESSION = 8
  end enum
  integer, parameter, public :: STRUMPACK_COMPRESSION_TYPE = kind(STRUMPACK_NONE)
  public :: STRUMPACK_NONE, STRUMPACK_HSS, STRUMPACK_BLR, STRUMPACK_HODLR, STRUMPACK_BLR_HODLR, STRUMPACK_ZFP_BLR_HODLR, &
-    STRUMPACK_LOSSLESS, STRUMPACK_LOSSY
+    STRUMPACK_LOSSLESS, STRUMPACK_LOSSY, STRUMPACK_AUTO_COMPRESSION
  ! typedef enum STRUMPACK_MATCHING_JOB
  enum, bind(c)
   enumerator :: STRUMPACK_MATCHING_NONE = 0
@@ -128,9 +129,10 @@ module strumpack
  enum, bind(c)
   enumerator :: STRUMPACK_LINEAR = 0
   enumerator :: STRUMPACK_MERSENNE = 1
+  enumerator :: STRUMPACK_PHILOX = 2
  end enum
  integer, parameter, public :: STRUMPACK_RANDOM_ENGINE = kind(STRUMPACK_LINEAR)
- public :: STRUMPACK_LINEAR, STRUMPACK_MERSENNE
+ public :: STRUMPACK_LINEAR, STRUMPACK_MERSENNE, STRUMPACK_PHILOX
  ! typedef enum STRUMPACK_KRYLOV_SOLVER
  enum, bind(c)
   enumerator :: STRUMPACK_AUTO = 0
@@ -140,10 +142,12 @@ module strumpack
   enumerator :: STRUMPACK_GMRES = 4
   enumerator :: STRUMPACK_PREC_BICGSTAB = 5
   enumerator :: STRUMPACK_BICGSTAB = 6
+  enumerator :: STRUMPACK_PREC_SSTEP_GMRES = 7
+  enumerator :: STRUMPACK_PREC_FGMRES = 8
  end enum
  integer, parameter, public :: STRUMPACK_KRYLOV_SOLVER = kind(STRUMPACK_AUTO)
  public :: STRUMPACK_AUTO, STRUMPACK_DIRECT, STRUMPACK_REFINE, STRUMPACK_PREC_GMRES, STRUMPACK_GMRES, STRUMPACK_PREC_BICGSTAB, &
-    STRUMPACK_BICGSTAB
+    STRUMPACK_BICGSTAB, STRUMPACK_PREC_SSTEP_GMRES, STRUMPACK_PREC_FGMRES
  ! typedef enum STRUMPACK_RETURN_CODE
  enum, bind(c)
   enumerator :: STRUMPACK_SUCCESS = 0
@@ -156,6 +160,20 @@ module strumpack
  integer, parameter, public :: STRUMPACK_RETURN_CODE = kind(STRUMPACK_SUCCESS)
  public :: STRUMPACK_SUCCESS, STRUMPACK_MATRIX_NOT_SET, STRUMPACK_REORDERING_ERROR, STRUMPACK_ZERO_PIVOT, &
     STRUMPACK_NO_CONVERGENCE, STRUMPACK_INACCURATE_INERTIA
+ ! struct STRUMPACK_MEMORY_REPORT
+ type, bind(C), public :: STRUMPACK_MEMORY_REPORT
+  integer(C_LONG_LONG), public :: reordering
+  integer(C_LONG_LONG), public :: symbolic
+  integer(C_LONG_LONG), public :: factor
+  integer(C_LONG_LONG), public :: solve
+  integer(C_LONG_LONG), public :: dense
+  integer(C_LONG_LONG), public :: BLR
+  integer(C_LONG_LONG), public :: HSS
+  integer(C_LONG_LONG), public :: HODLR
+  integer(C_LONG_LONG), public :: lossy
+  integer(C_LONG_LONG), public :: CB
+  integer(C_INT), public :: levels
+ end type STRUMPACK_MEMORY_REPORT
  public :: STRUMPACK_init_mt
  public :: STRUMPACK_set_distributed_csr_matrix
  public :: STRUMPACK_update_distributed_csr_matrix_values
@@ -225,6 +243,8 @@ module strumpack
  public :: STRUMPACK_rank
  public :: STRUMPACK_factor_nonzeros
  public :: STRUMPACK_factor_memory
+ public :: get_STRUMPACK_memory_report
+ public :: STRUMPACK_memory_report_level
  public :: STRUMPACK_set_mc64job
  public :: STRUMPACK_mc64job
  public :: STRUMPACK_enable_HSS
@@ -884,6 +904,25 @@ type(STRUMPACK_SparseSolver), intent(in), value :: s
 integer(C_LONG_LONG) :: fresult
 end function
 
+function get_STRUMPACK_memory_report(s) &
+bind(C, name="STRUMPACK_memory_report") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+import :: strumpack_sparsesolver, strumpack_memory_report
+type(STRUMPACK_SparseSolver), intent(in), value :: s
+type(STRUMPACK_MEMORY_REPORT) :: fresult
+end function
+
+subroutine STRUMPACK_memory_report_level(s, level, factors, cb) &
+bind(C, name="STRUMPACK_memory_report_level")
+use, intrinsic :: ISO_C_BINDING
+import :: strumpack_sparsesolver
+type(STRUMPACK_SparseSolver), intent(in), value :: s
+integer(C_INT), intent(in), value :: level
+integer(C_LONG_LONG) :: factors
+integer(C_LONG_LONG) :: cb
+end subroutine
+
 subroutine STRUMPACK_set_mc64job(s, job) &
 bind(C, name="STRUMPACK_set_mc64job")
 use, intrinsic :: ISO_C_BINDING
@@ -37,10 +37,13 @@
 
 // Allow this struct to be passed natively between C and Fortran
 %fortran_struct(STRUMPACK_SparseSolver)
+%fortran_struct(STRUMPACK_MEMORY_REPORT)
 
-// The STRUMPACK_Krylov_solver accessor is the same fortran identifier as the
-// enum STRUMPACK_KRYLOV_SOLVER (since fortran is case insensitive)
+// The STRUMPACK_Krylov_solver and STRUMPACK_memory_report accessors are the
+// same fortran identifiers as the enum STRUMPACK_KRYLOV_SOLVER and the struct
+// STRUMPACK_MEMORY_REPORT (since fortran is case insensitive)
 %rename("get_%s") STRUMPACK_Krylov_solver;
+%rename("get_%s") STRUMPACK_memory_report;
 
 %rename("STRUMPACK_init") STRUMPACK_init_f;
 
@@ -63,6 +63,49 @@ namespace strumpack {
                  bool non_zero_guess, bool verbose);
 
 
+    /**
+     * This is flexible restarted GMRes (FGMRes), using right
+     * preconditioning. The preconditioned basis vectors are stored
+     * (this requires restart*n extra memory compared to GMRes), so
+     * the preconditioner M is allowed to change from one iteration
+     * to the next, for instance when M is an inexact solver with
+     * randomization, lossy compression or lower precision.
+     *
+     * Note that, unlike GMRes, the residual norms used for the
+     * stopping criterion are the true (unpreconditioned) residuals.
+     *
+     *  Input vectors x and b have stride 1, length n
+     */
+    template<typename scalar_t,
+             typename real_t = typename RealType<scalar_t>::value_type>
+    real_t FGMRes(const SPMV<scalar_t>& A,
+                  const PREC<scalar_t>& M,
+                  std::size_t n, scalar_t* x, const scalar_t* b,
+                  real_t rtol, real_t atol, int& totit, int maxit,
+                  int restart, GramSchmidtType GStype,
+                  bool non_zero_guess, bool verbose);
+
+    /**
+     * This is left preconditioned restarted s-step GMRes. Blocks of
+     * s Krylov vectors are generated and then orthonormalized at
+     * once, using block Gram-Schmidt and Cholesky QR (twice). This
+     * replaces the many inner products of classical/modified
+     * Gram-Schmidt by a few matrix-matrix products, and reduces the
+     * number of global reductions in the MPI version, see
+     * SStepGMResMPI. The block size s is reduced automatically if
+     * the Krylov basis becomes too ill-conditioned.
+     *
+     *  Input vectors x and b have stride 1, length n
+     */
+    template<typename scalar_t,
+             typename real_t = typename RealType<scalar_t>::value_type>
+    real_t SStepGMRes(const SPMV<scalar_t>& A,
+                      const PREC<scalar_t>& M,
+                      std::size_t n, scalar_t* x, const scalar_t* b,
+                      real_t rtol, real_t atol, int& totit, int maxit,
+                      int restart, int s,
+                      bool non_zero_guess, bool verbose);
+
     /**
      * http://www.netlib.org/templates/matlab/bicgstab.m
      */
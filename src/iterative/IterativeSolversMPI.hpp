@@ -95,6 +95,51 @@ namespace strumpack {
     }
 
 
+    /**
+     * This is flexible restarted GMRes (FGMRes), with right
+     * preconditioning. Collective operation on comm.
+     *
+     * Input vectors x and b have stride 1 and (local) length n
+     *
+     * \see FGMRes
+     */
+    template<typename scalar_t,
+             typename real_t = typename RealType<scalar_t>::value_type>
+    real_t FGMResMPI(const MPIComm& comm,
+                     const std::function
+                     <void(const scalar_t*,scalar_t*)>& spmv,
+                     const std::function
+                     <void(scalar_t*)>& prec,
+                     std::size_t n, scalar_t* x, const scalar_t* b,
+                     real_t rtol, real_t atol, int& totit, int maxit,
+                     int restart, GramSchmidtType GStype,
+                     bool non_zero_guess, bool verbose);
+
+    /**
+     * This is left preconditioned restarted s-step GMRes.
+     * Collective operation on comm.
+     *
+     * Each block of s Krylov vectors is orthonormalized with only 2
+     * global reductions (all_reduce), instead of one or more
+     * reductions per Krylov vector as in GMResMPI. This reduces the
+     * latency cost when running on many processes.
+     *
+     * Input vectors x and b have stride 1 and (local) length n
+     *
+     * \see SStepGMRes
+     */
+    template<typename scalar_t,
+             typename real_t = typename RealType<scalar_t>::value_type>
+    real_t SStepGMResMPI(const MPIComm& comm,
+                         const std::function
+                         <void(const scalar_t*,scalar_t*)>& spmv,
+                         const std::function
+                         <void(scalar_t*)>& prec,
+                         std::size_t n, scalar_t* x, const scalar_t* b,
+                         real_t rtol, real_t atol, int& totit, int maxit,
+                         int restart, int s,
+                         bool non_zero_guess, bool verbose);
+
     /**
      * http://www.netlib.org/templates/matlab/bicgstab.m
      */
@@ -0,0 +1,260 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+/*!
+ * \file SStepGMRes.hpp
+ * \brief Implementation of s-step GMRes, shared by the sequential
+ * and the MPI versions. Not installed.
+ */
+#ifndef STRUMPACK_SSTEP_GMRES_HPP
+#define STRUMPACK_SSTEP_GMRES_HPP
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+
+#include "IterativeSolvers.hpp"
+
+namespace strumpack {
+  namespace iterative {
+
+    /**
+     * Left preconditioned restarted s-step GMRes.
+     *
+     * Blocks of s Krylov vectors w_i = M A w_{i-1}, w_0 = v_j (the
+     * last orthonormal basis vector), are generated without any
+     * inner products. Each block is then orthogonalized against the
+     * previous basis vectors and orthonormalized in one go, with two
+     * passes of block classical Gram-Schmidt with Pythagorean inner
+     * products, combined with Cholesky QR (BCGS-PIP2 + CholQR2). This
+     * requires only 2 global reductions per block of s vectors,
+     * instead of (at least) j+1 reductions per Krylov vector with
+     * classical/modified Gram-Schmidt. The Hessenberg matrix is
+     * recovered from the change of basis, using only small local
+     * computations.
+     *
+     * When the Cholesky factorization of a block breaks down, the
+     * block size is halved and the block is recomputed. With s=1
+     * this is standard GMRes with (reorthogonalized) classical
+     * Gram-Schmidt.
+     *
+     * \param allreduce sums an array of scalars over all processes
+     * (in place), does nothing for the sequential solver
+     */
+    template<typename scalar_t, typename real_t> real_t
+    sstep_gmres(const std::function<void(scalar_t*,int)>& allreduce,
+                const SPMV<scalar_t>& A, const PREC<scalar_t>& M,
+                std::size_t n, scalar_t* x, const scalar_t* b,
+                real_t rtol, real_t atol, int& totit, int maxit,
+                int restart, int s, bool non_zero_guess, bool verbose) {
+      if (restart > maxit) restart = maxit;
+      if (s < 1) s = 1;
+      if (s > restart) s = restart;
+      const int m = restart, ldh = m+1, ldn = std::max(std::size_t(1), n);
+      std::vector<scalar_t> givens_c(m), givens_s(m), b_(m+1),
+        hess(ldh*m), Hu(ldh*m), V(n*(m+1)), b_prec(n),
+        T((m+1)*s), C((m+1)*s), C2((m+1)*s), G(s*s), R(s*s), Rb((m+1)*(s+1));
+      int ldt = m+1;
+
+      auto norm = [&](const scalar_t* v) {
+        scalar_t nrm = blas::dotc(n, v, 1, v, 1);
+        allreduce(&nrm, 1);
+        return std::sqrt(std::real(nrm));
+      };
+
+      // One pass of block classical Gram-Schmidt of W = V(:,j0+1:j0+sb)
+      // against Q = V(:,0:j0), with Pythagorean inner products and
+      // Cholesky QR: W = Q Cp + W_new Rp. Single global reduction,
+      // T = [Q W]^H W is stored with leading dimension j0+1+sb, so it
+      // is contiguous.
+      auto bcgs_pip = [&](int j0, int sb, scalar_t* Cp, scalar_t* Rp) {
+        auto W = &V[(j0+1)*n];
+        const int ldtb = j0+1+sb;
+        blas::gemm('C', 'N', ldtb, sb, n, scalar_t(1.), V.data(), ldn,
+                   W, ldn, scalar_t(0.), T.data(), ldtb);
+        allreduce(T.data(), ldtb*sb);
+        for (int j=0; j<sb; j++)
+          for (int i=0; i<=j0; i++)
+            Cp[i+j*ldt] = T[i+j*ldtb];
+        for (int j=0; j<sb; j++)
+          for (int i=0; i<sb; i++)
+            Rp[i+j*s] = T[j0+1+i+j*ldtb];
+        // G = W^H W - Cp^H Cp
+        blas::gemm('C', 'N', sb, sb, j0+1, scalar_t(-1.), Cp, ldt,
+                   Cp, ldt, scalar_t(1.), Rp, s);
+        if (blas::potrf('U', sb, Rp, s)) return false;
+        for (int j=0; j<sb; j++)
+          for (int i=j+1; i<sb; i++)
+            Rp[i+j*s] = scalar_t(0.);
+        blas::gemm('N', 'N', n, sb, j0+1, scalar_t(-1.), V.data(), ldn,
+                   Cp, ldt, scalar_t(1.), W, ldn);
+        blas::trsm('R', 'U', 'N', 'N', n, sb, scalar_t(1.), Rp, s, W, ldn);
+        return true;
+      };
+
+      real_t rho, rho0 = real_t(0.);
+      blas::copy(n, b, 1, b_prec.data(), 1);
+      M(b_prec.data());
+
+      bool no_conv = true;
+      totit = 0;
+      while (no_conv) {
+        if (non_zero_guess || totit > 0) {
+          A(x, V.data());
+          M(V.data());
+          blas::axpby(n, scalar_t(1.), b_prec.data(), 1,
+                      scalar_t(-1.), V.data(), 1);
+        } else {
+          std::copy(b_prec.begin(), b_prec.end(), V.begin());
+          std::fill(x, x+n, scalar_t(0.));
+        }
+        rho = norm(V.data());
+        if (totit == 0) rho0 = rho;
+        if (rho < atol || rho/rho0 < rtol) {
+          no_conv = false;
+          break;
+        }
+        blas::scal(n, scalar_t(1./rho), V.data(), 1);
+        b_[0] = rho;
+        for (int i=1; i<=m; i++) b_[i] = scalar_t(0.);
+        std::fill(Hu.begin(), Hu.end(), scalar_t(0.));
+        int nrit = m-1;
+        if (verbose)
+          std::cout << "GMRES it. " << totit
+                    << "\tres = " << std::setw(12) << rho
+                    << "\trel.res = " << std::setw(12)
+                    << rho/rho0 << "\t restart!" << std::endl;
+        int j0 = 0;
+        while (j0 < m) {
+          const int sb = std::min(s, m - j0);
+          // monomial basis, w_i = M A w_{i-1}
+          for (int i=1; i<=sb; i++) {
+            A(&V[(j0+i-1)*n], &V[(j0+i)*n]);
+            M(&V[(j0+i)*n]);
+          }
+          // two passes: W = Q (C1 + C2 R1) + W_new (R2 R1)
+          bool ok1 = bcgs_pip(j0, sb, C.data(), R.data());
+          bool ok2 = ok1 && bcgs_pip(j0, sb, C2.data(), G.data());
+          bool lucky = false;
+          if (ok2) {
+            blas::gemm('N', 'N', j0+1, sb, sb, scalar_t(1.), C2.data(), ldt,
+                       R.data(), s, scalar_t(1.), C.data(), ldt);
+            blas::trmm('L', 'U', 'N', 'N', sb, sb, scalar_t(1.),
+                       G.data(), s, R.data(), s);
+          } else if (sb > 1) {
+            s = std::max(1, s/2);
+            if (verbose)
+              std::cout << "# s-step GMRES: Cholesky QR breakdown,"
+                        << " reducing s to " << s << std::endl;
+            continue;
+          } else if (!ok1) {
+            // w is (numerically) in span(Q), lucky breakdown,
+            // h(j0+1,j0) = 0
+            R[0] = scalar_t(0.);
+            lucky = true;
+          }
+          // Rb = [e_j0, [C; R]], size (j0+sb+1) x (sb+1)
+          const int ldr = m+1;
+          std::fill(Rb.begin(), Rb.end(), scalar_t(0.));
+          Rb[j0] = scalar_t(1.);
+          for (int j=0; j<sb; j++) {
+            for (int i=0; i<=j0; i++)
+              Rb[i+(j+1)*ldr] = C[i+j*ldt];
+            for (int i=0; i<=j; i++)
+              Rb[j0+1+i+(j+1)*ldr] = R[i+j*s];
+          }
+          // M A V(:,j0:j0+sb-1) Rn = V(:,0:j0+sb) (Rb(:,1:sb) - [Hu Ro; 0])
+          // with Ro = Rb(0:j0-1,0:sb-1), Rn = Rb(j0:j0+sb-1,0:sb-1)
+          auto Hn = &Hu[j0*ldh];
+          for (int j=0; j<sb; j++)
+            for (int i=0; i<=j0+sb; i++)
+              Hn[i+j*ldh] = Rb[i+(j+1)*ldr];
+          if (j0 > 0)
+            blas::gemm('N', 'N', j0+1, sb, j0, scalar_t(-1.), Hu.data(),
+                       ldh, Rb.data(), ldr, scalar_t(1.), Hn, ldh);
+          blas::trsm('R', 'U', 'N', 'N', j0+sb+1, sb, scalar_t(1.),
+                     &Rb[j0], ldr, Hn, ldh);
+          for (int j=0; j<sb; j++)
+            for (int i=j0+j+2; i<=m; i++)
+              Hn[i+j*ldh] = scalar_t(0.);
+          // Givens rotations on the new columns
+          bool conv = false;
+          for (int it=j0; it<j0+sb; it++) {
+            totit++;
+            std::copy(&Hu[it*ldh], &Hu[it*ldh]+ldh, &hess[it*ldh]);
+            for (int k=1; k<it+1; k++) {
+              scalar_t gamma = blas::my_conj(givens_c[k-1])*hess[k-1+it*ldh]
+                + blas::my_conj(givens_s[k-1])*hess[k+it*ldh];
+              hess[k+it*ldh] = -givens_s[k-1]*hess[k-1+it*ldh] +
+                givens_c[k-1]*hess[k+it*ldh];
+              hess[k-1+it*ldh] = gamma;
+            }
+            scalar_t delta =
+              std::sqrt(std::pow(std::abs(hess[it+it*ldh]),scalar_t(2))
+                        + std::pow(std::abs(hess[it+1+it*ldh]),scalar_t(2)));
+            givens_c[it] = hess[it+it*ldh] / delta;
+            givens_s[it] = hess[it+1+it*ldh] / delta;
+            hess[it+it*ldh] = blas::my_conj(givens_c[it])*hess[it+it*ldh] +
+              blas::my_conj(givens_s[it])*hess[it+1+it*ldh];
+            b_[it+1] = -givens_s[it]*b_[it];
+            b_[it] = blas::my_conj(givens_c[it])*b_[it];
+            rho = std::abs(b_[it+1]);
+            if (verbose)
+              std::cout << "GMRES it. " << totit
+                        << "\tres = " << std::setw(12) << rho
+                        << "\trel.res = " << std::setw(12)
+                        << rho/rho0 << std::endl;
+            if ((rho < atol) || (rho/rho0 < rtol) || (totit >= maxit)) {
+              no_conv = false;
+              conv = true;
+              nrit = it;
+              break;
+            }
+          }
+          if (conv) break;
+          if (lucky) {
+            // basis cannot be extended, update x and restart
+            nrit = j0;
+            break;
+          }
+          j0 += sb;
+        }
+        if (nrit >= 0) {
+          blas::trsv('U', 'N', 'N', nrit+1, hess.data(), ldh, b_.data(), 1);
+          blas::gemv('N', n, nrit+1, scalar_t(1.), V.data(), ldn,
+                     b_.data(), 1, scalar_t(1.), x, 1);
+        }
+      }
+      return rho;
+    }
+
+  } // end namespace iterative
+} // end namespace strumpack
+
+#endif // STRUMPACK_SSTEP_GMRES_HPP
@@ -307,6 +307,21 @@ namespace strumpack {
       MPI_Bcast(sbuf, ssize, mpi_type<T>(), src, comm_);
     }
 
+    /**
+     * Nonblocking broadcast of ssize elements from process src. The
+     * buffer should not be accessed before the request completes.
+     *
+     * \param sbuf buffer, input on process src, output on the others
+     * \param ssize number of elements
+     * \param src rank of the root process
+     * \param req MPI request object
+     */
+    template<typename T> void
+    ibroadcast_from(T* sbuf, std::size_t ssize, int src,
+                    MPI_Request* req) const {
+      MPI_Ibcast(sbuf, ssize, mpi_type<T>(), src, comm_, req);
+    }
+
     template<typename T>
     void all_gather(T* buf, std::size_t rsize) const {
       MPI_Allgather
@@ -780,6 +795,22 @@ namespace strumpack {
       return sub_comm;
     }
 
+    /**
+     * Split this communicator with MPI_Comm_split. This is
+     * collective on the current communicator.
+     *
+     * \param color ranks with the same color go in the same new
+     * communicator
+     * \param key determines the rank in the new communicator
+     * \return new communicator containing all ranks with this color
+     */
+    MPIComm split(int color, int key) const {
+      if (is_null()) return MPIComm(MPI_COMM_NULL);
+      MPIComm c;
+      MPI_Comm_split(comm_, color, key, &c.comm_);
+      return c;
+    }
+
     /**
      * Returns a communicator with only rank p, or an MPIComm wrapping
      * MPI_COMM_NULL if my rank in the current MPIComm != p. This is
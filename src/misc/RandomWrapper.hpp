@@ -36,6 +36,11 @@
 #include <memory>
 #include <random>
 #include <iostream>
+#include <cstdint>
+#include <cmath>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 namespace strumpack {
 
@@ -51,7 +56,9 @@ namespace strumpack {
      */
     enum class RandomEngine {
       LINEAR,   /*!< The C++11 std::minstd_rand random number generator. */
-      MERSENNE  /*!< The C++11 std::mt19937 random number generator.     */
+      MERSENNE, /*!< The C++11 std::mt19937 random number generator.     */
+      PHILOX    /*!< Counter based Philox4x32-10 generator, see
+                  PhiloxGenerator.                                   */
     };
 
     /**
@@ -63,6 +70,7 @@ namespace strumpack {
       switch (e) {
       case RandomEngine::LINEAR: return "minstd_rand";
       case RandomEngine::MERSENNE: return "mt19937";
+      case RandomEngine::PHILOX: return "philox4x32-10";
       }
       return "unknown";
     }
@@ -111,6 +119,18 @@ namespace strumpack {
       virtual real_t get() = 0;
       virtual real_t get(std::uint32_t i, std::uint32_t j) = 0;
       virtual int flops_per_prng() = 0;
+
+      /**
+       * Fill an m x n column major array A, with leading dimension
+       * ld, with random numbers. By default this calls get() for
+       * each element, column by column.
+       */
+      virtual void fill(std::size_t m, std::size_t n,
+                        real_t* A, std::size_t ld) {
+        for (std::size_t j=0; j<n; j++)
+          for (std::size_t i=0; i<m; i++)
+            A[i+j*ld] = get();
+      }
     };
 
     /**
@@ -190,6 +210,150 @@ namespace strumpack {
       D d;
     };
 
+    /**
+     * \class PhiloxGenerator
+     * \brief Counter based random number generator
+     *
+     * Uses the Philox4x32-10 block cipher (Salmon et al., "Parallel
+     * random numbers: as easy as 1, 2, 3", SC11). The random number
+     * for element (i,j) of block b is computed directly from the
+     * counter (i,j,b,0) and the key (the seed), so any element can
+     * be generated independently, without reseeding, and a matrix can
+     * be filled in parallel, or by different processes, with
+     * bit-identical results.
+     *
+     * fill() fills the next block (starting at block 0, with the
+     * elements of the array at coordinates (i,j)) in parallel with
+     * OpenMP. The normal distribution uses the Box-Muller transform,
+     * with one Philox call per element, so the inner loop can be
+     * vectorized.
+     *
+     * get() returns consecutive elements of a row of the current
+     * block, starting from (0,0) or from the position set with
+     * seed(i,j), so seed(i,j) followed by k calls to get() gives the
+     * same elements as get(i,j), .., get(i,j+k-1).
+     *
+     * \tparam real_t float or double
+     */
+    template<typename real_t>
+    class PhiloxGenerator : public RandomGeneratorBase<real_t> {
+    public:
+      /**
+       * Constructor using seed s and distribution d.
+       */
+      PhiloxGenerator(std::size_t s=0,
+                      RandomDistribution d=RandomDistribution::NORMAL)
+        : normal_(d == RandomDistribution::NORMAL) { seed(s); }
+
+      /**
+       * Seed with value s, and go back to block 0, element (0,0).
+       */
+      void seed(std::size_t s) override {
+        k0_ = std::uint32_t(s);
+        k1_ = std::uint32_t(std::uint64_t(s) >> 32);
+        i_ = j_ = b_ = 0;
+      }
+
+      /**
+       * Seed with a seed sequence, and go back to block 0, element
+       * (0,0).
+       */
+      void seed(std::seed_seq& s) override {
+        std::uint32_t k[2];
+        s.generate(k, k+2);
+        k0_ = k[0];
+        k1_ = k[1];
+        i_ = j_ = b_ = 0;
+      }
+
+      /**
+       * Set the position of the next call to get() to element (i,j)
+       * of the current block. This does not change the key.
+       */
+      void seed(std::uint32_t i, std::uint32_t j) override {
+        i_ = i;
+        j_ = j;
+      }
+
+      real_t get() override { return element(i_, j_++, b_); }
+
+      /**
+       * Get element (i,j) of the current block. This does not change
+       * the state of the generator, and is thread safe.
+       */
+      real_t get(std::uint32_t i, std::uint32_t j) override {
+        return element(i, j, b_);
+      }
+
+      /**
+       * Element (i,j) of the current block, thread safe.
+       */
+      real_t operator()(std::uint32_t i, std::uint32_t j) const {
+        return element(i, j, b_);
+      }
+
+      /**
+       * Move on to the next block.
+       */
+      void next_block() { b_++; i_ = j_ = 0; }
+
+      int flops_per_prng() override { return normal_ ? 23 : 7; }
+
+      /**
+       * Fill A(i,j) with element (i,j) of the current block, and move
+       * on to the next block.
+       */
+      void fill(std::size_t m, std::size_t n,
+                real_t* A, std::size_t ld) override {
+        const auto b = b_;
+#pragma omp parallel for if(!omp_in_parallel() && m*n > 10000)
+        for (std::size_t j=0; j<n; j++) {
+#pragma omp simd
+          for (std::size_t i=0; i<m; i++)
+            A[i+j*ld] = element(i, j, b);
+        }
+        next_block();
+      }
+
+    private:
+      std::uint32_t k0_ = 0, k1_ = 0; // key
+      std::uint32_t i_ = 0, j_ = 0;   // position of get()
+      std::uint32_t b_ = 0;           // block
+      bool normal_ = true;
+
+      static inline void mulhilo(std::uint32_t a, std::uint32_t b,
+                                 std::uint32_t& hi, std::uint32_t& lo) {
+        std::uint64_t p = std::uint64_t(a) * std::uint64_t(b);
+        hi = std::uint32_t(p >> 32);
+        lo = std::uint32_t(p);
+      }
+
+      real_t element(std::uint32_t i, std::uint32_t j,
+                     std::uint32_t b) const {
+        std::uint32_t c0 = i, c1 = j, c2 = b, c3 = 0,
+          k0 = k0_, k1 = k1_, hi0, lo0, hi1, lo1;
+        for (int r=0; r<10; r++) {
+          mulhilo(0xD2511F53, c0, hi0, lo0);
+          mulhilo(0xCD9E8D57, c2, hi1, lo1);
+          c0 = hi1 ^ c1 ^ k0;
+          c1 = lo1;
+          c2 = hi0 ^ c3 ^ k1;
+          c3 = lo0;
+          k0 += 0x9E3779B9;
+          k1 += 0xBB67AE85;
+        }
+        // 53 random bits from (c0,c1), in [0,1)
+        const double u0 = ((std::uint64_t(c0) >> 5) * 67108864. +
+                           (c1 >> 6)) * (1. / 9007199254740992.);
+        if (!normal_) return real_t(u0);
+        // Box-Muller, with u1 in (0,1] from (c2,c3)
+        const double u1 = ((std::uint64_t(c2) >> 5) * 67108864. +
+                           (c3 >> 6) + 1.) * (1. / 9007199254740992.);
+        return real_t(std::sqrt(-2. * std::log(u1)) *
+                      std::cos(6.283185307179586 * u0));
+      }
+    };
+
     /**
      * Factory method to construct a RandomGeneratorBase with a
      * specified random engine and random distribution, with seed s.
@@ -221,7 +385,9 @@ namespace strumpack {
           return std::unique_ptr<RandomGeneratorBase<real_t>>
             (new RandomGenerator<real_t,std::mt19937,
              std::uniform_real_distribution<real_t>>(seed));
-      }
+      } else if (e == RandomEngine::PHILOX)
+        return std::unique_ptr<RandomGeneratorBase<real_t>>
+          (new PhiloxGenerator<real_t>(seed, d));
       return NULL;
     }
 
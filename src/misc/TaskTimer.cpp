@@ -29,7 +29,12 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <cassert>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <limits>
 #if defined(_OPENMP)
 #include <omp.h>
 #endif
@@ -44,6 +49,103 @@ using namespace strumpack;
 tpoint TaskTimer::t_begin = GET_TIME_NOW();
 TimerList TaskTimer::time_log_list = TimerList();
 
+namespace {
+
+  double seconds_since_begin(const tpoint& t) {
+#if defined(USE_OPENMP_TIMER)
+    return t - TaskTimer::t_begin;
+#else
+    return duration_cast<duration<double>>(t - TaskTimer::t_begin).count();
+#endif
+  }
+
+  struct TraceBuffer {
+    TraceBuffer(int id)
+      : tid(id), events(new TraceEvent[TraceRecorder::capacity]) {}
+    int tid;
+    std::unique_ptr<TraceEvent[]> events;
+    // only written by the owning thread
+    std::atomic<std::size_t> head{0};
+  };
+
+  std::mutex& trace_mutex() {
+    static std::mutex m;
+    return m;
+  }
+
+  std::vector<std::unique_ptr<TraceBuffer>>& trace_buffers() {
+    static std::vector<std::unique_ptr<TraceBuffer>> buffers;
+    return buffers;
+  }
+
+  TraceBuffer& thread_trace_buffer() {
+    // the lock is only taken the first time a thread records an event
+    thread_local TraceBuffer* buf = nullptr;
+    if (!buf) {
+      std::lock_guard<std::mutex> lock(trace_mutex());
+      auto& buffers = trace_buffers();
+      buffers.emplace_back(new TraceBuffer(buffers.size()));
+      buf = buffers.back().get();
+    }
+    return *buf;
+  }
+
+  void write_trace_event(std::ostream& os, bool& first, const char* name,
+                         const char* cat, int pid, int tid,
+                         double t_start, double t_stop) {
+    if (!first) os << ",\n";
+    first = false;
+    os << "{\"name\":\"";
+    for (auto c=name; *c; c++) {
+      if (*c == '"' || *c == '\\') os << '\\';
+      os << *c;
+    }
+    os << "\",\"cat\":\"" << cat << "\",\"ph\":\"X\",\"pid\":" << pid
+       << ",\"tid\":" << tid << std::fixed << std::setprecision(3)
+       << ",\"ts\":" << t_start * 1e6
+       << ",\"dur\":" << (t_stop - t_start) * 1e6;
+  }
+
+} // end anonymous namespace
+
+double TraceRecorder::now() {
+  return seconds_since_begin(GET_TIME_NOW());
+}
+
+void TraceRecorder::record(const TraceEvent& e) {
+  auto& b = thread_trace_buffer();
+  auto h = b.head.load(std::memory_order_relaxed);
+  b.events[h % capacity] = e;
+  b.head.store(h+1, std::memory_order_release);
+}
+
+std::size_t TraceRecorder::dropped() {
+  std::lock_guard<std::mutex> lock(trace_mutex());
+  std::size_t d = 0;
+  for (auto& b : trace_buffers()) {
+    auto h = b->head.load(std::memory_order_acquire);
+    if (h > capacity) d += h - capacity;
+  }
+  return d;
+}
+
+void TraceRecorder::write_events
+(std::ostream& os, int pid, double offset, bool& first) {
+  std::lock_guard<std::mutex> lock(trace_mutex());
+  for (auto& b : trace_buffers()) {
+    auto h = b->head.load(std::memory_order_acquire);
+    for (auto i=(h > capacity ? h - capacity : 0); i<h; i++) {
+      const auto& e = b->events[i % capacity];
+      write_trace_event(os, first, e.name, "front", pid, b->tid,
+                        e.t_start + offset, e.t_stop + offset);
+      os << ",\"args\":{\"front\":" << e.front
+         << ",\"level\":" << e.level << ",\"dim_sep\":" << e.dim_sep
+         << ",\"dim_upd\":" << e.dim_upd << std::setprecision(0)
+         << ",\"flops\":" << e.flops << "}}";
+    }
+  }
+}
+
 TaskTimer::TaskTimer(std::string name, int depth)
   : t_name(name), started(false), stopped(false),
     type(TaskType::EXPLICITLY_NAMED_TASK), number(depth) {
@@ -225,6 +327,25 @@ void TimerList::Finalize() {
   TaskTimer::time_log_list.finalize();
 }
 
+void TimerList::write_trace_events
+(std::ostream& os, int pid, double offset, bool& first) {
+  for (unsigned int thread=0; thread<list.size(); thread++)
+    for (auto& timing : list[thread]) {
+      if (!timing.started || !timing.stopped) continue;
+      std::ostringstream name;
+      timing.print_name(name);
+      write_trace_event(os, first, name.str().c_str(), "timer", pid,
+                        timing.tid,
+                        seconds_since_begin(timing.t_start) + offset,
+                        seconds_since_begin(timing.t_stop) + offset);
+      os << ",\"args\":{\"depth\":" << timing.number << "}}";
+    }
+  TraceRecorder::write_events(os, pid, offset, first);
+  if (auto d = TraceRecorder::dropped())
+    std::cerr << "# Warning, " << d << " trace events were overwritten,"
+              << " TraceRecorder::capacity is too small." << std::endl;
+}
+
 void TimerList::finalize() {
 #if defined(STRUMPACK_TASK_TIMERS)
 #if !defined(STRUMPACK_USE_MPI)
@@ -233,6 +354,11 @@ void TimerList::finalize() {
   for (unsigned int thread=0; thread<list.size(); thread++)
     for (auto timing : list[thread]) //log << timing;
       timing.print(log);
+  std::ofstream trace("trace.json", std::ofstream::out);
+  bool first = true;
+  trace << "{\"traceEvents\":[\n";
+  write_trace_events(trace, 0, 0., first);
+  trace << "\n]}\n";
   return;
 #else
   if (is_finalized) return;
@@ -253,6 +379,11 @@ void TimerList::finalize() {
     for (unsigned int thread=0; thread<list.size(); thread++)
       for (auto timing : list[thread]) //log << timing;
         timing.print(log);
+    std::ofstream trace("trace.json", std::ofstream::out);
+    bool first = true;
+    trace << "{\"traceEvents\":[\n";
+    write_trace_events(trace, 0, 0., first);
+    trace << "\n]}\n";
     return;
   }
 
@@ -372,6 +503,47 @@ void TimerList::finalize() {
               << "======================+";
     std::cout << std::endl;
   }
+
+  // Align the clocks: all ranks leave the barrier at (about) the
+  // same time, shift the local times so they match those of rank 0.
+  c.barrier();
+  double t_sync = TraceRecorder::now(), t_sync0 = t_sync;
+  c.broadcast(t_sync0);
+  std::ostringstream events;
+  bool first = true;
+  write_trace_events(events, rank, t_sync0 - t_sync, first);
+  auto str = events.str();
+  // MPI counts are int, a trace that does not fit is not written
+  if (str.size() > std::size_t(std::numeric_limits<int>::max())) {
+    std::cerr << "# Warning, trace on rank " << rank
+              << " is too large, not writing it." << std::endl;
+    str.clear();
+  }
+  int len = str.size();
+  std::vector<int> lens(rank ? 0 : P);
+  MPI_Gather(&len, 1, MPI_INT, lens.data(), 1, MPI_INT, 0, c.comm());
+  // receive the traces one rank at a time, the total size can exceed
+  // the int displacements of MPI_Gatherv
+  if (!rank) {
+    std::ofstream trace("trace.json", std::ofstream::out);
+    trace << "{\"traceEvents\":[\n";
+    bool first_rank = true;
+    std::vector<char> buf;
+    for (int p=0; p<P; p++) {
+      if (!lens[p]) continue;
+      if (!first_rank) trace << ",\n";
+      first_rank = false;
+      if (p == 0) trace.write(str.data(), len);
+      else {
+        buf.resize(lens[p]);
+        MPI_Recv(buf.data(), lens[p], MPI_CHAR, p, 0, c.comm(),
+                 MPI_STATUS_IGNORE);
+        trace.write(buf.data(), lens[p]);
+      }
+    }
+    trace << "\n]}\n";
+  } else if (len)
+    MPI_Send(str.data(), len, MPI_CHAR, 0, 0, c.comm());
 #endif
 #endif
 }
@@ -33,6 +33,7 @@
 #include <vector>
 #include <string>
 #include <chrono>
+#include <iostream>
 #include <functional>
 #include "StrumpackConfig.hpp"
 
@@ -112,6 +113,77 @@ namespace strumpack {
     void finalize();
     bool is_finalized;
     std::vector<std::list<TaskTimer>> list;
+
+  private:
+    void write_trace_events(std::ostream& os, int pid, double offset,
+                            bool& first);
+  };
+
+  /**
+   * A single event recorded with TraceRegion: the front (separator)
+   * it belongs to, its level in the elimination tree, the front
+   * dimensions and the number of flops. Times are in seconds since
+   * TaskTimer::t_begin.
+   */
+  struct TraceEvent {
+    const char* name; // not copied, should be a string literal
+    double t_start, t_stop;
+    int front, level, dim_sep, dim_upd;
+    double flops;
+  };
+
+  /**
+   * Low overhead event recorder. Every thread records into its own
+   * fixed size ring buffer, so recording an event does not take a
+   * lock, and when a buffer is full the oldest events are
+   * overwritten. The recorded events, together with the TaskTimer
+   * timings, are written to trace.json, in the Chrome trace event
+   * format (chrome://tracing or ui.perfetto.dev), by
+   * TimerList::finalize. With MPI, the events of all ranks are
+   * gathered in a single file, one process per rank, with the clocks
+   * aligned to rank 0.
+   */
+  class TraceRecorder {
+  public:
+    /** number of events kept per thread */
+    static const std::size_t capacity = 1 << 16;
+
+    /** seconds since TaskTimer::t_begin */
+    static double now();
+    static void record(const TraceEvent& e);
+
+    /**
+     * Number of events that were overwritten because a ring buffer
+     * was full.
+     */
+    static std::size_t dropped();
+
+    /**
+     * Write the recorded events, comma separated, as Chrome trace
+     * events for process pid, adding offset (seconds) to all times.
+     */
+    static void write_events(std::ostream& os, int pid, double offset,
+                             bool& first);
+  };
+
+  /**
+   * Scoped event, recorded (with TraceRecorder) when it goes out of
+   * scope.
+   */
+  class TraceRegion {
+  public:
+    TraceRegion(const char* name, int front, int level,
+                int dsep, int dupd)
+      : e_{name, TraceRecorder::now(), 0., front, level, dsep, dupd, 0.} {}
+    TraceRegion(const TraceRegion&) = delete;
+    TraceRegion& operator=(const TraceRegion&) = delete;
+    ~TraceRegion() {
+      e_.t_stop = TraceRecorder::now();
+      TraceRecorder::record(e_);
+    }
+    void add_flops(double f) { e_.flops += f; }
+  private:
+    TraceEvent e_;
   };
 
 #if !defined(STRUMPACK_TASK_TIMERS)
@@ -120,6 +192,8 @@ namespace strumpack {
 #define TIMER_DEFINE(name, nr, timer) (void)0
 #define TIMER_START(timer) (void)0
 #define TIMER_STOP(timer) (void)0
+#define TRACE_REGION(name, front, level, dsep, dupd, region) (void)0
+#define TRACE_FLOPS(region, f) (void)0
 
 #else // STRUMPACK_TASK_TIMERS
 
@@ -130,6 +204,9 @@ namespace strumpack {
   TaskTimer timer(type, depth);
 #define TIMER_START(timer) timer.start();
 #define TIMER_STOP(timer) timer.stop();
+#define TRACE_REGION(name, front, level, dsep, dupd, region)     \
+  TraceRegion region(name, front, level, dsep, dupd);
+#define TRACE_FLOPS(region, f) region.add_flops(f);
 
 #endif // STRUMPACK_TASK_TIMERS
 
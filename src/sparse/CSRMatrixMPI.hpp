@@ -114,6 +114,10 @@ namespace strumpack {
     void spmv(const scalar_t* x, scalar_t* y) const override;
 
     void permute(const integer_t* iorder, const integer_t* order) override;
+    void permute_in_place(const integer_t* iorder,
+                          const integer_t* order) override {
+      permute(iorder, order);
+    }
 
     std::unique_ptr<CSRMatrix<scalar_t,integer_t>> gather() const;
     std::unique_ptr<CSRGraph<integer_t>> gather_graph() const;
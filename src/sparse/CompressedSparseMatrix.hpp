@@ -324,8 +324,8 @@ namespace strumpack {
     virtual void spmv(const scalar_t* x, scalar_t* y) const = 0;
 
     /**
-     * TODO Obtain reordering Anew = A(iorder,iorder). In addition,
-     * entries of IND, VAL are sorted in increasing order
+     * Obtain reordering Anew = A(iorder,iorder). In addition, entries
+     * of IND, VAL are sorted in increasing order.
      */
     virtual void permute(const integer_t* iorder, const integer_t* order);
 
@@ -334,6 +334,20 @@ namespace strumpack {
       permute(iorder.data(), order.data());
     }
 
+    /**
+     * Same as permute, but the nonzeros are permuted in place, no
+     * (temporary) copy of the matrix is made, only nnz + 2n
+     * temporary integers are used. This is several times slower than
+     * permute, only use it when memory is the bottleneck.
+     */
+    virtual void permute_in_place(const integer_t* iorder,
+                                  const integer_t* order);
+
+    void permute_in_place(const std::vector<integer_t>& iorder,
+                          const std::vector<integer_t>& order) {
+      permute_in_place(iorder.data(), order.data());
+    }
+
     virtual void permute_columns(const std::vector<integer_t>& perm) = 0;
 
     virtual Equil_t equilibration() const { return Equil_t(this->size()); }
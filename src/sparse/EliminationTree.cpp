@@ -43,6 +43,18 @@ namespace strumpack {
 #pragma omp parallel default(shared)
 #pragma omp single
     symbolic_factorization(A, sep_tree, sep_tree.root(), upd);
+    if (opts.front_amalgamation_fill() > 0)
+      amalgamate(opts, sep_tree, upd);
+    if (opts.compression() == CompressionType::AUTO) {
+      // factor memory if all fronts are dense, reduced for every
+      // front selected for compression
+      for (integer_t sep=0; sep<sep_tree.separators(); sep++) {
+        double dsep = sep_tree.sizes[sep+1] - sep_tree.sizes[sep],
+          dupd = upd[sep].size();
+        nr_fronts_.auto_mem +=
+          (dsep*dsep + 2.*dsep*dupd) * sizeof(scalar_t);
+      }
+    }
     root_ = setup_tree(opts, A, sep_tree, upd, sep_tree.root(), true, 0);
   }
 
@@ -121,6 +133,76 @@ namespace strumpack {
     }
   }
 
+  /**
+   * Relaxed amalgamation: bottom-up, merge two leaf children into
+   * their parent, if the fraction of explicit zeros in the merged
+   * front (including zeros from earlier merges) stays below
+   * opts.front_amalgamation_fill(), or if the merged separator is
+   * not larger than opts.front_amalgamation_min_size(). This is
+   * only called when opts.front_amalgamation_fill() > 0. The
+   * separators of two leaf siblings and their parent are
+   * contiguous, so the permutation does not change, and the update
+   * indices of the merged front are those of the parent. The
+   * separator tree is replaced by the amalgamated tree, and upd is
+   * renumbered accordingly.
+   */
+  template<typename scalar_t,typename integer_t> void
+  EliminationTree<scalar_t,integer_t>::amalgamate
+  (const SPOptions<scalar_t>& opts, SeparatorTree<integer_t>& sep_tree,
+   std::vector<std::vector<integer_t>>& upd) {
+    const integer_t nsep = sep_tree.separators();
+    const double fill = opts.front_amalgamation_fill();
+    const integer_t min_size = opts.front_amalgamation_min_size();
+    auto entries = [](double ds, double du) { return ds*ds + 2.*ds*du; };
+    // first row/column of each (merged) front, its number of
+    // entries and the explicit zeros in it
+    std::vector<integer_t> begin(sep_tree.sizes, sep_tree.sizes+nsep);
+    std::vector<double> ent(nsep), zeros(nsep, 0.);
+    std::vector<bool> leaf(nsep), merged(nsep, false);
+    for (integer_t i=0; i<nsep; i++) {
+      double du = upd[i].size();
+      ent[i] = entries(sep_tree.sizes[i+1] - begin[i], du);
+      auto l = sep_tree.lch[i], r = sep_tree.rch[i];
+      leaf[i] = l == -1 && r == -1;
+      if (l == -1 || r == -1 || !leaf[l] || !leaf[r] ||
+          sep_tree.sizes[l+1] != begin[r] ||
+          sep_tree.sizes[r+1] != begin[i])
+        continue;
+      auto dsm = sep_tree.sizes[i+1] - begin[l];
+      double em = entries(dsm, du),
+        zm = em - (ent[i] + ent[l] - zeros[l] + ent[r] - zeros[r]);
+      if (zm > fill * em && dsm > min_size) continue;
+      begin[i] = begin[l];
+      ent[i] = em;
+      zeros[i] = zm;
+      leaf[i] = true;
+      merged[l] = merged[r] = true;
+      amalg_fronts_ += 2;
+    }
+    if (!amalg_fronts_) return;
+    std::vector<integer_t> map(nsep, -1);
+    integer_t n = 0;
+    for (integer_t i=0; i<nsep; i++)
+      if (!merged[i]) map[i] = n++;
+    std::vector<Separator<integer_t>> seps;
+    std::vector<std::vector<integer_t>> new_upd(n);
+    seps.reserve(n);
+    for (integer_t i=0; i<nsep; i++) {
+      if (merged[i]) continue;
+      auto pa = sep_tree.parent[i];
+      if (leaf[i])
+        seps.emplace_back(sep_tree.sizes[i+1], pa == -1 ? -1 : map[pa],
+                          -1, -1);
+      else
+        seps.emplace_back(sep_tree.sizes[i+1], pa == -1 ? -1 : map[pa],
+                          map[sep_tree.lch[i]], map[sep_tree.rch[i]]);
+      new_upd[map[i]] = std::move(upd[i]);
+      amalg_zeros_ += zeros[i];
+    }
+    sep_tree = SeparatorTree<integer_t>(seps);
+    upd = std::move(new_upd);
+  }
+
   template<typename scalar_t,typename integer_t>
   std::unique_ptr<FrontalMatrix<scalar_t,integer_t>>
   EliminationTree<scalar_t,integer_t>::setup_tree
@@ -196,6 +278,12 @@ namespace strumpack {
     return nonzeros;
   }
 
+  template<typename scalar_t,typename integer_t> void
+  EliminationTree<scalar_t,integer_t>::memory_report
+  (MemoryReport& r) const {
+    if (root_) root_->memory_report(r);
+  }
+
   template<typename scalar_t,typename integer_t> ReturnCode
   EliminationTree<scalar_t,integer_t>::inertia
   (integer_t& neg, integer_t& zero, integer_t& pos) const {
@@ -73,6 +73,7 @@ namespace strumpack {
     virtual integer_t maximum_rank() const;
     virtual long long factor_nonzeros() const;
     virtual long long dense_factor_nonzeros() const;
+    void memory_report(MemoryReport& r) const;
 
     virtual ReturnCode inertia(integer_t& neg,
                                integer_t& zero,
@@ -84,6 +85,18 @@ namespace strumpack {
 
     virtual FrontCounter front_counter() const { return nr_fronts_; }
 
+    /**
+     * Number of fronts merged into their parent by the front
+     * amalgamation, see SPOptions::set_front_amalgamation_fill.
+     */
+    integer_t amalgamated_fronts() const { return amalg_fronts_; }
+
+    /**
+     * Number of explicit zeros added to the factors by the front
+     * amalgamation.
+     */
+    long long amalgamation_zeros() const { return amalg_zeros_; }
+
     void draw(const SpMat_t& A, const std::string& name) const;
 
     F_t* root() const;
@@ -91,6 +104,8 @@ namespace strumpack {
   protected:
     FrontCounter nr_fronts_;
     std::unique_ptr<F_t> root_;
+    integer_t amalg_fronts_ = 0;
+    long long amalg_zeros_ = 0;
 
   private:
     std::unique_ptr<F_t>
@@ -105,6 +120,10 @@ namespace strumpack {
                            integer_t sep,
                            std::vector<std::vector<integer_t>>& upd,
                            int depth=0) const;
+
+    void amalgamate(const SPOptions<scalar_t>& opts,
+                    SeparatorTree<integer_t>& sep_tree,
+                    std::vector<std::vector<integer_t>>& upd);
   };
 
 } // end namespace strumpack
@@ -176,6 +176,10 @@ namespace strumpack {
     };
 
     void permute(const integer_t* iorder, const integer_t* order) override;
+    void permute_in_place(const integer_t* iorder,
+                          const integer_t* order) override {
+      permute(iorder, order);
+    }
 
   protected:
     integer_t local_cols_;  // number of columns stored on this proces
@@ -66,6 +66,80 @@ namespace strumpack {
   }
 #endif
 
+  template<typename integer_t> void
+  SeparatorTree<integer_t>::write(std::ofstream& os) const {
+    os.write((const char*)&nr_seps_, sizeof(nr_seps_));
+    if (nr_seps_)
+      os.write((const char*)sizes, sizeof(integer_t)*size());
+  }
+
+  template<typename integer_t> void
+  SeparatorTree<integer_t>::read(std::ifstream& is) {
+    integer_t nseps = 0;
+    is.read((char*)&nseps, sizeof(nseps));
+    if (!is.good() || nseps < 0) {
+      is.setstate(std::ios::failbit);
+      return;
+    }
+    if (!nseps) {
+      *this = SeparatorTree<integer_t>();
+      return;
+    }
+    {
+      // do not allocate more than what is left in the file
+      auto pos = is.tellg();
+      is.seekg(0, std::ios::end);
+      auto left = is.tellg() - pos;
+      is.seekg(pos);
+      if (left < std::streamoff(sizeof(integer_t)) * (4*nseps+1)) {
+        is.setstate(std::ios::failbit);
+        return;
+      }
+    }
+    allocate(nseps);
+    is.read((char*)sizes, sizeof(integer_t)*size());
+    root_ = -1;
+    if (is.good() && !valid()) {
+      *this = SeparatorTree<integer_t>();
+      is.setstate(std::ios::failbit);
+    }
+  }
+
+  template<typename integer_t> bool
+  SeparatorTree<integer_t>::valid() const {
+    if (!nr_seps_) return true;
+    if (sizes[0] != 0) return false;
+    for (integer_t i=0; i<nr_seps_; i++)
+      if (sizes[i+1] < sizes[i]) return false;
+    auto in_range = [&](integer_t j) { return j >= -1 && j < nr_seps_; };
+    integer_t roots = 0;
+    for (integer_t i=0; i<nr_seps_; i++) {
+      if (!in_range(parent[i]) || !in_range(lch[i]) || !in_range(rch[i]) ||
+          (lch[i] == -1) != (rch[i] == -1))
+        return false;
+      if (parent[i] == -1) roots++;
+      else if (lch[parent[i]] != i && rch[parent[i]] != i) return false;
+      if (lch[i] != -1 &&
+          (lch[i] == rch[i] || parent[lch[i]] != i || parent[rch[i]] != i))
+        return false;
+    }
+    if (roots != 1) return false;
+    // every separator should be reached exactly once from the root
+    std::vector<bool> mark(nr_seps_, false);
+    std::stack<integer_t> s;
+    s.push(std::find(parent, parent+nr_seps_, -1) - parent);
+    integer_t visited = 0;
+    while (!s.empty()) {
+      auto i = s.top();
+      s.pop();
+      if (mark[i]) return false;
+      mark[i] = true;
+      visited++;
+      if (lch[i] != -1) { s.push(lch[i]); s.push(rch[i]); }
+    }
+    return visited == nr_seps_;
+  }
+
   template<typename integer_t> integer_t
   SeparatorTree<integer_t>::levels() const {
     if (nr_seps_) return level(root());
@@ -529,6 +603,26 @@ namespace strumpack {
     return SeparatorTree<integer_t>(seps);
   }
 
+  template<typename integer_t>
+  std::vector<Separator<integer_t>>
+  combine_separator_subtrees(std::vector<Separator<integer_t>>&& lt,
+                             const std::vector<Separator<integer_t>>& rt,
+                             integer_t nsep) {
+    integer_t nl = lt.size(), nr = rt.size(),
+      n0 = lt.back().sep_end, n1 = rt.back().sep_end;
+    lt.reserve(nl + nr + 1);
+    for (auto s : rt) {
+      s.sep_end += n0;
+      if (s.pa != -1) s.pa += nl;
+      if (s.lch != -1) s.lch += nl;
+      if (s.rch != -1) s.rch += nl;
+      lt.push_back(s);
+    }
+    lt[nl-1].pa = lt[nl+nr-1].pa = nl + nr;
+    lt.emplace_back(n0+n1+nsep, -1, nl-1, nl+nr-1);
+    return std::move(lt);
+  }
+
   /** path halving */
   template<typename integer_t> inline integer_t
   find(integer_t i, std::vector<integer_t>& pp) {
@@ -618,4 +712,17 @@ namespace strumpack {
   separators_from_etree(std::vector<long long int>& etree,
                         std::vector<long long int>& post);
 
+  template std::vector<Separator<int>>
+  combine_separator_subtrees(std::vector<Separator<int>>&& lt,
+                             const std::vector<Separator<int>>& rt,
+                             int nsep);
+  template std::vector<Separator<long int>>
+  combine_separator_subtrees(std::vector<Separator<long int>>&& lt,
+                             const std::vector<Separator<long int>>& rt,
+                             long int nsep);
+  template std::vector<Separator<long long int>>
+  combine_separator_subtrees(std::vector<Separator<long long int>>&& lt,
+                             const std::vector<Separator<long long int>>& rt,
+                             long long int nsep);
+
 } // end namespace strumpack
@@ -31,6 +31,7 @@
 
 #include <vector>
 #include <memory>
+#include <fstream>
 #if defined(STRUMPACK_USE_MPI)
 #include "misc/MPIWrapper.hpp"
 #endif
@@ -80,6 +81,27 @@ namespace strumpack {
     void broadcast(const MPIComm& c);
 #endif
 
+    /**
+     * Write the tree to a binary file stream, can be read back with
+     * read(std::ifstream&).
+     */
+    void write(std::ofstream& os) const;
+
+    /**
+     * Read a tree written with write(std::ofstream&). Check
+     * is.good() afterwards, the failbit is also set if the tree is
+     * not valid, see valid().
+     */
+    void read(std::ifstream& is);
+
+    /**
+     * Check that this is a proper binary tree, with a single root,
+     * consistent parent and child indices, and nondecreasing sizes
+     * starting at 0. Unlike check(), this does not assert, and is
+     * also done in release builds.
+     */
+    bool valid() const;
+
     integer_t *sizes = nullptr,
       *parent = nullptr,
       *lch = nullptr,
@@ -162,6 +184,21 @@ namespace strumpack {
   separators_from_etree(std::vector<integer_t>& etree,
                         std::vector<integer_t>& post);
 
+  /**
+   * Combine two separator subtrees, each in postorder and with
+   * sep_end relative to the first vertex of the subtree, with a root
+   * separator of nsep vertices. The result is in postorder: the left
+   * subtree, the right subtree (shifted) and the root, so the
+   * vertices are numbered as left, right, separator. This is used by
+   * nested dissection codes which order the two halves
+   * independently.
+   */
+  template<typename integer_t>
+  std::vector<Separator<integer_t>>
+  combine_separator_subtrees(std::vector<Separator<integer_t>>&& lt,
+                             const std::vector<Separator<integer_t>>& rt,
+                             integer_t nsep);
+
 } // end namespace strumpack
 
 #endif
@@ -0,0 +1,138 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <chrono>
+#include <limits>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+
+#include "FrontCostModel.hpp"
+#include "dense/DenseMatrix.hpp"
+#include "StrumpackParameters.hpp"
+
+namespace strumpack {
+
+  template<typename scalar_t> const FrontCostModel<scalar_t>&
+  FrontCostModel<scalar_t>::instance() {
+    static const FrontCostModel<scalar_t> model;
+    return model;
+  }
+
+  template<typename scalar_t>
+  FrontCostModel<scalar_t>::FrontCostModel() {
+    using DenseM_t = DenseMatrix<scalar_t>;
+    using real_t = typename RealType<scalar_t>::value_type;
+    // best of a few runs
+    auto time = [](const std::function<void()>& f) {
+      double t = std::numeric_limits<double>::max();
+      for (int i=0; i<3; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        t = std::min(t, std::chrono::duration<double>(t1 - t0).count());
+      }
+      return t;
+    };
+    const int n = 256, k = 16;
+    DenseM_t A(n, n), B(n, n), C(n, n), U(n, k), V(k, n);
+    A.random(); B.random(); U.random(); V.random();
+    t_gemm_ = time([&]() {
+        blas::gemm('N', 'N', n, n, n, scalar_t(1.), A.data(), A.ld(),
+                   B.data(), B.ld(), scalar_t(0.), C.data(), C.ld());
+      }) / (double(n) * n * n);
+    t_lr_ = time([&]() {
+        blas::gemm('N', 'N', n, n, k, scalar_t(1.), U.data(), U.ld(),
+                   V.data(), V.ld(), scalar_t(0.), C.data(), C.ld());
+      }) / (double(n) * n * k);
+    // C = U*V has rank k
+    const real_t rtol = std::sqrt(blas::lamch<real_t>('E'));
+    t_comp_ = time([&]() {
+        DenseM_t Uc, Vc;
+        C.low_rank(Uc, Vc, rtol, real_t(0.), n,
+                   params::task_recursion_cutoff_level);
+      }) / (double(n) * n * k);
+    std::vector<scalar_t> x(1 << 22, scalar_t(1.)), y(x.size());
+    t_mem_ = time([&]() { std::copy(x.begin(), x.end(), y.begin()); })
+      / (2. * x.size());
+  }
+
+  template<typename scalar_t> double
+  FrontCostModel<scalar_t>::dense
+  (double dsep, double dupd, double& mem) const {
+    // LU of F11, solves with F12/F21 and the Schur complement update
+    double ops = dsep*dsep*dsep/3. + dsep*dsep*dupd + dsep*dupd*dupd;
+    double words = dsep*dsep + 2.*dsep*dupd;
+    mem = words * sizeof(scalar_t);
+    // the forward and backward solve each read the factors once
+    return ops * t_gemm_ + 2. * words * t_mem_;
+  }
+
+  template<typename scalar_t> double
+  FrontCostModel<scalar_t>::BLR
+  (double dsep, double dupd, double b, double r, double& mem) const {
+    double ts = std::ceil(dsep / b), tu = std::ceil(dupd / b);
+    // off-diagonal tiles in F11, F12 and F21, stored as U*V
+    double nlr = ts*(ts-1.) + 2.*ts*tu;
+    double words = std::min
+      (ts*b*b + nlr*2.*b*r, dsep*dsep + 2.*dsep*dupd);
+    mem = words * sizeof(scalar_t);
+    double ops = dsep*dsep*dsep/3. + dsep*dsep*dupd + dsep*dupd*dupd,
+      diag = ts*b*b*b/3.;
+    // a low-rank times low-rank update of a tile costs b^2 r + 2 b r^2
+    // instead of b^3
+    double rb = r / b, upd = std::max(0., ops - diag) * (rb + 2.*rb*rb);
+    return nlr*b*b*r * t_comp_ + diag * t_gemm_ + upd * t_lr_
+      + 2. * words * t_mem_;
+  }
+
+  template<typename scalar_t> CompressionType
+  FrontCostModel<scalar_t>::select
+  (int dsep, int dupd, const SPOptions<scalar_t>& opts,
+   double& mem) const {
+    double b = opts.BLR_options().leaf_size();
+    if (dsep < b) return CompressionType::NONE;
+    double r = std::max(1., opts.auto_compression_rank_ratio() * b);
+    double mem_d, mem_b;
+    double t_d = dense(dsep, dupd, mem_d),
+      t_b = BLR(dsep, dupd, b, r, mem_b);
+    auto budget = opts.auto_compression_memory_budget();
+    bool use_blr = (budget > 0 && mem > budget) ?
+      mem_b < mem_d : t_b < t_d;
+    if (use_blr) mem -= mem_d - mem_b;
+    return use_blr ? CompressionType::BLR : CompressionType::NONE;
+  }
+
+  // explicit template instantiations
+  template class FrontCostModel<float>;
+  template class FrontCostModel<double>;
+  template class FrontCostModel<std::complex<float>>;
+  template class FrontCostModel<std::complex<double>>;
+
+} // end namespace strumpack
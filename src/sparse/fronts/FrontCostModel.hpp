@@ -0,0 +1,94 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#ifndef FRONT_COST_MODEL_HPP
+#define FRONT_COST_MODEL_HPP
+
+#include "StrumpackOptions.hpp"
+
+namespace strumpack {
+
+  /**
+   * Performance model for the factorization and solve of a single
+   * frontal matrix, used to select the representation of each front
+   * with CompressionType::AUTO.
+   *
+   * The machine parameters (time per multiply-add for large and for
+   * low-rank GEMM, time per multiply-add for low-rank compression,
+   * and time to stream one scalar from memory) are measured once per
+   * process, the first time the model is used.
+   */
+  template<typename scalar_t> class FrontCostModel {
+  public:
+    /**
+     * Get the (calibrated) model. Thread safe, the calibration is
+     * done only once.
+     */
+    static const FrontCostModel<scalar_t>& instance();
+
+    /**
+     * Predicted time (seconds) of the factorization and of one solve
+     * with a dense front, and the memory (bytes) for its factors.
+     */
+    double dense(double dsep, double dupd, double& mem) const;
+
+    /**
+     * Predicted time (seconds) of the factorization and of one solve
+     * with a BLR front, with tiles of size b and an estimated rank r
+     * for the off-diagonal tiles, and the memory (bytes) for its
+     * factors.
+     */
+    double BLR(double dsep, double dupd, double b, double r,
+               double& mem) const;
+
+    /**
+     * Select NONE (dense) or BLR for a front with the given
+     * dimensions, based on the predicted factor+solve time. If the
+     * predicted factor memory mem (for the entire tree, with all
+     * fronts which have not been selected yet counted as dense)
+     * exceeds SPOptions::auto_compression_memory_budget, the
+     * representation with the least memory is selected. mem is
+     * reduced when a front is compressed. Fronts are selected top
+     * down, so the larger fronts are compressed first.
+     */
+    CompressionType select(int dsep, int dupd,
+                           const SPOptions<scalar_t>& opts,
+                           double& mem) const;
+
+  private:
+    double t_gemm_ = 0.; // time per multiply-add, large GEMM
+    double t_lr_ = 0.;   // time per multiply-add, low-rank GEMM
+    double t_comp_ = 0.; // time per multiply-add, compression
+    double t_mem_ = 0.;  // time to read one scalar from memory
+
+    FrontCostModel();
+  };
+
+} // end namespace strumpack
+
+#endif // FRONT_COST_MODEL_HPP
@@ -30,6 +30,7 @@
 #include <algorithm>
 
 #include "FrontFactory.hpp"
+#include "FrontCostModel.hpp"
 
 #include "sparse/CSRGraph.hpp"
 #include "FrontalMatrixDense.hpp"
@@ -37,6 +38,8 @@
 #include "FrontalMatrixBLR.hpp"
 #if defined(STRUMPACK_USE_BPACK)
 #include "FrontalMatrixHODLR.hpp"
+#else
+#include "FrontalMatrixHODLRNative.hpp"
 #endif
 #if defined(STRUMPACK_USE_MPI)
 #include "FrontalMatrixDenseMPI.hpp"
@@ -102,13 +105,25 @@ namespace strumpack {
         if (root) fc.BLR++;
       }
     } break;
+    case CompressionType::AUTO: {
+      if (FrontCostModel<scalar_t>::instance().select
+          (dsep, dupd, opts, fc.auto_mem) == CompressionType::BLR) {
+        front.reset
+          (new FrontalMatrixBLR<scalar_t,integer_t>(s, sbegin, send, upd));
+        if (root) fc.BLR++;
+      }
+    } break;
     case CompressionType::HODLR: {
       if (is_HODLR(dsep, dupd, compressed_parent, opts)) {
 #if defined(STRUMPACK_USE_BPACK)
         front.reset
           (new FrontalMatrixHODLR<scalar_t,integer_t>(s, sbegin, send, upd));
-        if (root) fc.HODLR++;
+#else
+        front.reset
+          (new FrontalMatrixHODLRNative<scalar_t,integer_t>
+           (s, sbegin, send, upd));
 #endif
+        if (root) fc.HODLR++;
       }
     } break;
     case CompressionType::BLR_HODLR: {
@@ -116,8 +131,12 @@ namespace strumpack {
 #if defined(STRUMPACK_USE_BPACK)
         front.reset
           (new FrontalMatrixHODLR<scalar_t,integer_t>(s, sbegin, send, upd));
-        if (root) fc.HODLR++;
+#else
+        front.reset
+          (new FrontalMatrixHODLRNative<scalar_t,integer_t>
+           (s, sbegin, send, upd));
 #endif
+        if (root) fc.HODLR++;
       } else if (is_BLR(dsep, dupd, compressed_parent, opts, 1)) {
         front.reset
           (new FrontalMatrixBLR<scalar_t,integer_t>(s, sbegin, send, upd));
@@ -129,8 +148,12 @@ namespace strumpack {
 #if defined(STRUMPACK_USE_BPACK)
         front.reset
           (new FrontalMatrixHODLR<scalar_t,integer_t>(s, sbegin, send, upd));
-        if (root) fc.HODLR++;
+#else
+        front.reset
+          (new FrontalMatrixHODLRNative<scalar_t,integer_t>
+           (s, sbegin, send, upd));
 #endif
+        if (root) fc.HODLR++;
       } else if (is_BLR(dsep, dupd, compressed_parent, opts, 1)) {
         front.reset
           (new FrontalMatrixBLR<scalar_t,integer_t>(s, sbegin, send, upd));
@@ -247,6 +270,7 @@ namespace strumpack {
         if (root) fc.HSS++;
       }
     } break;
+    case CompressionType::AUTO: // the model is not used for distributed fronts
     case CompressionType::BLR: {
       if (is_BLR(dsep, dupd, compressed_parent, opts)) {
         front.reset
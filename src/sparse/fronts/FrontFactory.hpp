@@ -42,6 +42,9 @@ namespace strumpack {
 
   struct FrontCounter {
     int dense, HSS, BLR, HODLR, lossy;
+    // predicted factor memory (bytes) for CompressionType::AUTO,
+    // fronts not created yet are counted as dense
+    double auto_mem = 0.;
     FrontCounter() : dense(0), HSS(0), BLR(0), HODLR(0), lossy(0) {}
     FrontCounter(int* c) :
       dense(c[0]), HSS(c[1]), BLR(c[2]), HODLR(c[3]), lossy(c[4]) {}
@@ -73,6 +76,7 @@ namespace strumpack {
   (int dsep, int dupd, bool compressed_parent,
    const SPOptions<scalar_t>& opts, int l=0) {
     return (opts.compression() == CompressionType::BLR ||
+            opts.compression() == CompressionType::AUTO ||
             opts.compression() == CompressionType::BLR_HODLR ||
             opts.compression() == CompressionType::ZFP_BLR_HODLR) &&
       (dsep >= opts.compression_min_sep_size(l) ||
@@ -81,15 +85,12 @@ namespace strumpack {
   template<typename scalar_t> bool is_HODLR
   (int dsep, int dupd, bool compressed_parent,
    const SPOptions<scalar_t>& opts, int l=0) {
-#if defined(STRUMPACK_USE_BPACK)
+    // without ButterflyPACK, HODLR::HODLRMatrixNative is used
     return (opts.compression() == CompressionType::HODLR ||
             opts.compression() == CompressionType::BLR_HODLR ||
             opts.compression() == CompressionType::ZFP_BLR_HODLR) &&
       (dsep >= opts.compression_min_sep_size(l) ||
        dsep + dupd >= opts.compression_min_front_size(l));
-#else
-    return false;
-#endif
   }
   template<typename scalar_t> bool is_lossy
   (int dsep, int dupd, bool, const SPOptions<scalar_t>& opts, int l=0) {
@@ -386,6 +386,35 @@ namespace strumpack {
     return nnz + nnzl + nnzr;
   }
 
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrix<scalar_t,integer_t>::memory_report
+  (MemoryReport& r, int etree_level) const {
+    node_memory_report(r, etree_level, true);
+    if (lchild_) lchild_->memory_report(r, etree_level+1);
+    if (rchild_) rchild_->memory_report(r, etree_level+1);
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrix<scalar_t,integer_t>::node_memory_report
+  (MemoryReport& r, int etree_level, bool count_CB) const {
+    long long f = node_factor_nonzeros() * sizeof(scalar_t),
+      cb = count_CB ? (long long)(dim_upd()) * dim_upd() * sizeof(scalar_t) : 0;
+    switch (compression_kind()) {
+    case CompressionType::BLR: r.BLR += f; break;
+    case CompressionType::HSS: r.HSS += f; break;
+    case CompressionType::HODLR: r.HODLR += f; break;
+    case CompressionType::LOSSY: r.lossy += f; break;
+    default: r.dense += f;
+    }
+    r.CB += cb;
+    if (int(r.level_factors.size()) <= etree_level) {
+      r.level_factors.resize(etree_level+1, 0);
+      r.level_CB.resize(etree_level+1, 0);
+    }
+    r.level_factors[etree_level] += f;
+    r.level_CB[etree_level] += cb;
+  }
+
   template<typename scalar_t,typename integer_t> ReturnCode
   FrontalMatrix<scalar_t,integer_t>::inertia
   (integer_t& neg, integer_t& zero, integer_t& pos) const {
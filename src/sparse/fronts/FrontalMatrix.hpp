@@ -211,10 +211,18 @@ namespace strumpack {
 
     virtual long long factor_nonzeros(int task_depth=0) const;
     virtual long long dense_factor_nonzeros(int task_depth=0) const;
+    virtual void memory_report(MemoryReport& r, int etree_level=0) const;
     virtual bool isHSS() const { return false; }
     virtual bool isMPI() const { return false; }
     virtual void print_rank_statistics(std::ostream &out) const {}
     virtual std::string type() const { return "FrontalMatrix"; }
+    /**
+     * Representation of the factors of this front, used to classify
+     * the front in the memory report. NONE for dense fronts.
+     */
+    virtual CompressionType compression_kind() const {
+      return CompressionType::NONE;
+    }
 
     virtual void
     partition_fronts(const Opts_t& opts, const SpMat_t& A, integer_t* sorder,
@@ -230,6 +238,8 @@ namespace strumpack {
 
     void set_lchild(std::unique_ptr<F_t> ch) { lchild_ = std::move(ch); }
     void set_rchild(std::unique_ptr<F_t> ch) { rchild_ = std::move(ch); }
+    const F_t* lchild() const { return lchild_.get(); }
+    const F_t* rchild() const { return rchild_.get(); }
 
     // TODO compute this (and levels) once, store it
     // maybe compute it when setting pointers to the children
@@ -365,6 +375,9 @@ namespace strumpack {
       return dense_node_factor_nonzeros();
     }
 
+    void node_memory_report(MemoryReport& r, int etree_level,
+                            bool count_CB) const;
+
     virtual void partition(const Opts_t& opts, const SpMat_t& A,
                            integer_t* sorder,
                            bool is_root=true, int task_depth=0);
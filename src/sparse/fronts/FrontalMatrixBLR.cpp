@@ -29,6 +29,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 
 #include "FrontalMatrixBLR.hpp"
 #include "sparse/CSRGraph.hpp"
@@ -115,27 +116,48 @@ namespace strumpack {
     const std::size_t dupd = dim_upd();
     std::size_t upd2sep;
     auto I = this->upd_to_parent(p, upd2sep);
-    // if ACA was used, a compressed version of the CB was constructed
-    // in F22blr_, so we need to expand it first into F22_
-    if (F22blr_.rows() == dupd)
-      F22_ = F22blr_.dense();
+    // add B, the block of the CB starting at (r0, c0), to the parent
+    auto ea = [&](const DenseM_t& B, std::size_t r0, std::size_t c0) {
+      const std::size_t r1 = r0 + B.rows(), rs = std::max(r0, upd2sep);
+      for (std::size_t c=c0; c<c0+B.cols(); c++) {
+        auto pc = I[c];
+        if (pc < pdsep) {
+          for (std::size_t r=r0; r<std::min(r1, upd2sep); r++)
+            paF11(I[r],pc) += B(r-r0,c-c0);
+          for (std::size_t r=rs; r<r1; r++)
+            paF21(I[r]-pdsep,pc) += B(r-r0,c-c0);
+        } else {
+          for (std::size_t r=r0; r<std::min(r1, upd2sep); r++)
+            paF12(I[r],pc-pdsep) += B(r-r0,c-c0);
+          for (std::size_t r=rs; r<r1; r++)
+            paF22(I[r]-pdsep,pc-pdsep) += B(r-r0,c-c0);
+        }
+      }
+    };
+    if (F22blr_.rows() == dupd) {
+      // if ACA was used, a compressed version of the CB was
+      // constructed in F22blr_, add it tile by tile, only expanding
+      // a single low-rank tile at a time
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared)                    \
+  if(task_depth < params::task_recursion_cutoff_level)
+#endif
+      for (std::size_t tj=0; tj<F22blr_.colblocks(); tj++)
+        for (std::size_t ti=0; ti<F22blr_.rowblocks(); ti++) {
+          auto& T = F22blr_.tile(ti, tj);
+          if (T.is_low_rank()) {
+            if (!T.rank()) continue;
+            ea(T.dense(), F22blr_.tileroff(ti), F22blr_.tilecoff(tj));
+          } else
+            ea(T.D(), F22blr_.tileroff(ti), F22blr_.tilecoff(tj));
+        }
+    } else {
 #if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
 #pragma omp taskloop default(shared) grainsize(64)      \
   if(task_depth < params::task_recursion_cutoff_level)
 #endif
-    for (std::size_t c=0; c<dupd; c++) {
-      auto pc = I[c];
-      if (pc < pdsep) {
-        for (std::size_t r=0; r<upd2sep; r++)
-          paF11(I[r],pc) += F22_(r,c);
-        for (std::size_t r=upd2sep; r<dupd; r++)
-          paF21(I[r]-pdsep,pc) += F22_(r,c);
-      } else {
-        for (std::size_t r=0; r<upd2sep; r++)
-          paF12(I[r],pc-pdsep) += F22_(r, c);
-        for (std::size_t r=upd2sep; r<dupd; r++)
-          paF22(I[r]-pdsep,pc-pdsep) += F22_(r,c);
-      }
+      for (std::size_t c=0; c<dupd; c++)
+        ea(DenseMW_t(dupd, 1, F22_, 0, c), 0, c);
     }
     STRUMPACK_FLOPS((is_complex<scalar_t>()?2:1) * dupd * dupd);
     STRUMPACK_FULL_RANK_FLOPS((is_complex<scalar_t>()?2:1) * dupd * dupd);
@@ -147,35 +169,12 @@ namespace strumpack {
   (BLRM_t& paF11, BLRM_t& paF12, BLRM_t& paF21, BLRM_t& paF22,
    const F_t* p, int task_depth, const Opts_t& opts) {
     // extend_add from seq. BLR to seq. BLR
-    const std::size_t pdsep = paF11.rows();
-    const std::size_t dupd = dim_upd();
     std::size_t upd2sep;
     auto I = this->upd_to_parent(p, upd2sep);
-    if (opts.BLR_options().BLR_factor_algorithm() ==
-        BLR::BLRFactorAlgorithm::COLWISE)
-      F22blr_.decompress(); // change to colwise
-#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
-#pragma omp taskloop default(shared) grainsize(64)      \
-  if(task_depth < params::task_recursion_cutoff_level)
-#endif
-    for (std::size_t c=0; c<dupd; c++) {
-      auto pc = I[c];
-      if (pc < pdsep) {
-        for (std::size_t r=0; r<upd2sep; r++)
-          paF11(I[r],pc) += F22blr_(r,c);
-        for (std::size_t r=upd2sep; r<dupd; r++)
-          paF21(I[r]-pdsep,pc) += F22blr_(r,c);
-      } else {
-        for (std::size_t r=0; r<upd2sep; r++)
-          paF12(I[r],pc-pdsep) += F22blr_(r, c);
-        for (std::size_t r=upd2sep; r<dupd; r++)
-          paF22(I[r]-pdsep,pc-pdsep) += F22blr_(r,c);
-      }
-    }
-    STRUMPACK_FLOPS((is_complex<scalar_t>()?2:1) * dupd * dupd);
-    STRUMPACK_FULL_RANK_FLOPS((is_complex<scalar_t>()?2:1) * dupd * dupd);
+    extend_add_CB_tiles
+      (paF11, paF12, paF21, paF22, I, upd2sep, 0, dim_upd(), task_depth);
     release_work_memory();
-   }
+  }
 
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixBLR<scalar_t,integer_t>::extend_add_to_blr_col
@@ -183,49 +182,120 @@ namespace strumpack {
    const F_t* p, integer_t begin_col, integer_t end_col,
    int task_depth, const Opts_t& opts) {
     // extend_add from seq. BLR to seq. BLR
-    const std::size_t pdsep = paF11.rows();
-    const std::size_t dupd = dim_upd();
     std::size_t upd2sep;
     auto I = this->upd_to_parent(p, upd2sep);
-    int c_min = 0, c_max = 0;
-    for (std::size_t c=0; c<dupd; c++) {
-      auto pc = I[c];
-      if (c == dupd-1) c_max = dupd;
-      if (pc < std::size_t(begin_col)) {
-        c_min = c+1;
-        continue;
-      }
-      if (pc >= std::size_t(end_col)) {
-        c_max = c;
-        break;
-      }
+    // I is sorted, these CB columns map to [begin_col, end_col)
+    std::size_t c_min = std::lower_bound
+      (I.begin(), I.end(), std::size_t(begin_col)) - I.begin();
+    std::size_t c_max = std::lower_bound
+      (I.begin(), I.end(), std::size_t(end_col)) - I.begin();
+    extend_add_CB_tiles
+      (paF11, paF12, paF21, paF22, I, upd2sep, c_min, c_max, task_depth);
+    F22blr_.remove_tiles_before_local_column(c_min, c_max);
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixBLR<scalar_t,integer_t>::extend_add_CB_tiles
+  (BLRM_t& paF11, BLRM_t& paF12, BLRM_t& paF21, BLRM_t& paF22,
+   const std::vector<std::size_t>& I, std::size_t upd2sep,
+   std::size_t c_min, std::size_t c_max, int task_depth) {
+    if (c_min >= c_max) return;
+    const std::size_t pdsep = paF11.rows();
+    const std::size_t dupd = dim_upd();
+    // parent tile, and row/column in that tile, for each CB
+    // row/column, paF22 has the same row tiles as paF21 and column
+    // tiles as paF12, and is the only one set if pdsep == 0
+    std::vector<std::size_t> rt(dupd), rl(dupd), ct(dupd), cl(dupd);
+    for (std::size_t r=0; r<dupd; r++) {
+      auto& pa = (r < upd2sep) ? paF11 : paF22;
+      auto pr = (r < upd2sep) ? I[r] : I[r] - pdsep;
+      rt[r] = pa.rg2t(pr);
+      rl[r] = pr - pa.tileroff(rt[r]);
     }
-    if (opts.BLR_options().BLR_factor_algorithm() ==
-        BLR::BLRFactorAlgorithm::COLWISE)
-      F22blr_.decompress_local_columns(c_min, c_max);
+    for (std::size_t c=c_min; c<c_max; c++) {
+      auto& pa = (I[c] < pdsep) ? paF11 : paF22;
+      auto pc = (I[c] < pdsep) ? I[c] : I[c] - pdsep;
+      ct[c] = pa.cg2t(pc);
+      cl[c] = pc - pa.tilecoff(ct[c]);
+    }
+    auto ptile = [&](std::size_t r, std::size_t c) -> DenseM_t& {
+      auto& pa = (r < upd2sep) ?
+        ((I[c] < pdsep) ? paF11 : paF12) :
+        ((I[c] < pdsep) ? paF21 : paF22);
+      return pa.tile_dense(rt[r], ct[c]).D();
+    };
+    // do CB rows [r0, r1) map to consecutive rows of one parent tile?
+    auto single_tile_rows = [&](std::size_t r0, std::size_t r1) {
+      return (r0 < upd2sep) == (r1-1 < upd2sep) && rt[r0] == rt[r1-1]
+        && rl[r1-1] - rl[r0] == r1-1-r0;
+    };
+    auto single_tile_cols = [&](std::size_t c0, std::size_t c1) {
+      return (I[c0] < pdsep) == (I[c1-1] < pdsep) && ct[c0] == ct[c1-1]
+        && cl[c1-1] - cl[c0] == c1-1-c0;
+    };
+    // add B, the block of the CB starting at (r0, c0), to the parent
+    auto ea = [&](const DenseM_t& B, std::size_t r0, std::size_t c0) {
+      const std::size_t r1 = r0 + B.rows();
+      for (std::size_t c=c0; c<c0+B.cols(); c++)
+        for (std::size_t r=r0; r<r1; ) {
+          // rows in the same parent tile
+          auto pD = &ptile(r, c)(0, cl[c]);
+          auto t = rt[r];
+          bool top = r < upd2sep;
+          for (; r<r1 && rt[r] == t && (r < upd2sep) == top; r++)
+            pD[rl[r]] += B(r-r0, c-c0);
+        }
+    };
+    if (F22blr_.rows() != dupd) {
+      // CB was not compressed, columns map to different parent
+      // columns, so they can be added concurrently
 #if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
 #pragma omp taskloop default(shared) grainsize(64)      \
   if(task_depth < params::task_recursion_cutoff_level)
 #endif
-    for (std::size_t c=0; c<dupd; c++) { // TODO use c_min and c_max
-      auto pc = I[c];
-      if (pc < std::size_t(begin_col) || pc >= std::size_t(end_col))
-        continue;
-      if (pc < pdsep) {
-        for (std::size_t r=0; r<upd2sep; r++)
-          paF11(I[r],pc) += F22blr_(r,c);
-        for (std::size_t r=upd2sep; r<dupd; r++)
-          paF21(I[r]-pdsep,pc) += F22blr_(r,c);
-      } else {
-        for (std::size_t r=0; r<upd2sep; r++)
-          paF12(I[r],pc-pdsep) += F22blr_(r, c);
-        for (std::size_t r=upd2sep; r<dupd; r++)
-          paF22(I[r]-pdsep,pc-pdsep) += F22blr_(r,c);
+      for (std::size_t c=c_min; c<c_max; c++)
+        ea(DenseMW_t(dupd, 1, F22_, 0, c), 0, c);
+      STRUMPACK_FLOPS((is_complex<scalar_t>()?2:1) * dupd * (c_max-c_min));
+      STRUMPACK_FULL_RANK_FLOPS
+        ((is_complex<scalar_t>()?2:1) * dupd * (c_max-c_min));
+      return;
+    }
+    auto tc_begin = F22blr_.cg2t(c_min), tc_end = F22blr_.cg2t(c_max-1)+1;
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared)                    \
+  if(task_depth < params::task_recursion_cutoff_level)
+#endif
+    for (std::size_t tj=tc_begin; tj<tc_end; tj++) {
+      auto c0 = std::max(F22blr_.tilecoff(tj), c_min),
+        c1 = std::min(F22blr_.tilecoff(tj+1), c_max),
+        lc0 = c0 - F22blr_.tilecoff(tj);
+      bool scols = single_tile_cols(c0, c1);
+      for (std::size_t ti=0; ti<F22blr_.rowblocks(); ti++) {
+        auto r0 = F22blr_.tileroff(ti), r1 = F22blr_.tileroff(ti+1);
+        auto& T = F22blr_.tile(ti, tj);
+        if (T.is_low_rank()) {
+          if (!T.rank()) continue;
+          DenseMW_t V(T.rank(), c1-c0, T.V(), 0, lc0);
+          if (scols && single_tile_rows(r0, r1)) {
+            // the low-rank tile maps to a contiguous block of a
+            // single parent tile, add U*V directly
+            DenseMW_t P(r1-r0, c1-c0, ptile(r0, c0), rl[r0], cl[c0]);
+            gemm(Trans::N, Trans::N, scalar_t(1.), T.U(), V,
+                 scalar_t(1.), P, task_depth);
+          } else {
+            // straddles parent tiles, or is scattered
+            DenseM_t B(r1-r0, c1-c0);
+            gemm(Trans::N, Trans::N, scalar_t(1.), T.U(), V,
+                 scalar_t(0.), B, task_depth);
+            ea(B, r0, c0);
+          }
+        } else
+          ea(DenseMW_t(r1-r0, c1-c0, T.D(), 0, lc0), r0, c0);
       }
     }
-    STRUMPACK_FLOPS((is_complex<scalar_t>()?2:1) * dupd * dupd);
-    STRUMPACK_FULL_RANK_FLOPS((is_complex<scalar_t>()?2:1) * dupd * dupd);
-    F22blr_.remove_tiles_before_local_column(c_min, c_max);
+    STRUMPACK_FLOPS((is_complex<scalar_t>()?2:1) * dupd * (c_max-c_min));
+    STRUMPACK_FULL_RANK_FLOPS
+      ((is_complex<scalar_t>()?2:1) * dupd * (c_max-c_min));
   }
 
   template<typename scalar_t,typename integer_t> void
@@ -321,6 +391,16 @@ namespace strumpack {
                build_front_cols
                  (A, i, part, CP, e11, e12, e21, task_depth, opts);
              });
+        } else if (dupd) {
+          // empty separator, only assemble the contribution block
+          F22blr_ = BLRM_t(dupd, upd_tiles_, dupd, upd_tiles_);
+          F22blr_.fill(0.);
+          if (lchild_)
+            lchild_->extend_add_to_blr
+              (F11blr_, F12blr_, F21blr_, F22blr_, this, task_depth, opts);
+          if (rchild_)
+            rchild_->extend_add_to_blr
+              (F11blr_, F12blr_, F21blr_, F22blr_, this, task_depth, opts);
         }
       } else {
         DenseM_t F11(dsep, dsep), F12(dsep, dupd), F21(dupd, dsep);
@@ -97,6 +97,9 @@ namespace strumpack {
                                DenseM_t& B, int task_depth) const override;
 
     std::string type() const override { return "FrontalMatrixBLR"; }
+    CompressionType compression_kind() const override {
+      return CompressionType::BLR;
+    }
 
 #if defined(STRUMPACK_USE_MPI)
     void extend_add_copy_to_buffers(std::vector<std::vector<scalar_t>>& sbuf,
@@ -128,6 +131,19 @@ namespace strumpack {
 
     void draw_node(std::ostream& of, bool is_root) const override;
 
+    /**
+     * Add CB columns [c_min, c_max) to the parent, directly from the
+     * tiles of F22blr_ (or from F22_ if the CB was not compressed).
+     * Low-rank tiles that map to a contiguous block of a single
+     * parent tile are added with a single gemm, other low-rank tiles
+     * are expanded one at a time. The parent tiles should be dense.
+     */
+    void extend_add_CB_tiles(BLRM_t& paF11, BLRM_t& paF12,
+                             BLRM_t& paF21, BLRM_t& paF22,
+                             const std::vector<std::size_t>& I,
+                             std::size_t upd2sep, std::size_t c_min,
+                             std::size_t c_max, int task_depth);
+
     long long node_factor_nonzeros() const override;
 
     virtual ReturnCode node_subnormals(std::size_t& ns,
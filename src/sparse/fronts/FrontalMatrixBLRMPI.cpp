@@ -52,8 +52,12 @@ namespace strumpack {
   }
 
   template<typename scalar_t,typename integer_t> void
-  FrontalMatrixBLRMPI<scalar_t,integer_t>::extend_add() {
+  FrontalMatrixBLRMPI<scalar_t,integer_t>::extend_add(const Opts_t& opts) {
     if (!lchild_ && !rchild_) return;
+    using ExtAdd = BLR::BLRExtendAdd<scalar_t,integer_t>;
+    // distributed BLR children send their (compressed) contribution
+    // blocks as low-rank tiles
+    bool cmp = opts.BLR_options().compressed_extend_add();
     std::vector<std::vector<scalar_t>> sbuf(this->P());
     for (auto& ch : {lchild_.get(), rchild_.get()}) {
       if (ch && Comm().is_root()) {
@@ -61,16 +65,25 @@ namespace strumpack {
           (static_cast<long long int>(ch->dim_upd())*ch->dim_upd());
       }
       if (!visit(ch)) continue;
-      ch->extadd_blr_copy_to_buffers(sbuf, this);
+      auto chb = dynamic_cast<const FBLRMPI_t*>(ch);
+      if (cmp && chb)
+        ExtAdd::copy_to_buffers_compressed
+          (chb->F22blr_, sbuf, this, chb->upd_to_parent(this));
+      else ch->extadd_blr_copy_to_buffers(sbuf, this);
     }
     std::vector<scalar_t,NoInit<scalar_t>> rbuf;
     std::vector<scalar_t*> pbuf;
     Comm().all_to_all_v(sbuf, rbuf, pbuf);
     for (auto& ch : {lchild_.get(), rchild_.get()}) {
       if (!ch) continue;
-      ch->extadd_blr_copy_from_buffers
-        (F11blr_, F12blr_, F21blr_, F22blr_,
-         pbuf.data()+this->master(ch), this);
+      auto chb = dynamic_cast<const FBLRMPI_t*>(ch);
+      if (cmp && chb)
+        ExtAdd::copy_from_buffers_compressed
+          (F11blr_, F12blr_, F21blr_, F22blr_,
+           pbuf.data()+this->master(ch), this, chb);
+      else ch->extadd_blr_copy_from_buffers
+             (F11blr_, F12blr_, F21blr_, F22blr_,
+              pbuf.data()+this->master(ch), this);
     }
   }
 
@@ -303,7 +316,7 @@ namespace strumpack {
       if (rchild_) rchild_->release_work_memory();
     } else {
       build_front(A);
-      extend_add();
+      extend_add(opts);
       if (lchild_) lchild_->release_work_memory();
       if (rchild_) rchild_->release_work_memory();
       if (dim_sep() && grid2d().active()) {
@@ -313,10 +326,12 @@ namespace strumpack {
         auto nF = std::sqrt(nF11*nF11 + nF12*nF12 + nF21*nF21);
         auto lopts = opts.BLR_options();
         lopts.set_abs_tol(lopts.abs_tol() * nF);
-        if (dim_upd())
+        if (dim_upd()) {
           piv_ = BLRMPI_t::partial_factor
             (F11blr_, F12blr_, F21blr_, F22blr_, adm_, lopts);
-        else piv_ = F11blr_.factor(adm_, lopts);
+          if (lopts.compressed_extend_add())
+            F22blr_.compress(lopts);
+        } else piv_ = F11blr_.factor(adm_, lopts);
         // TODO flops?
       }
     }
@@ -63,7 +63,7 @@ namespace strumpack {
                           const std::vector<Triplet<scalar_t>>& r3buf,
                           const Opts_t& opts);
 
-    void extend_add();
+    void extend_add(const Opts_t& opts);
     void extend_add_cols(std::size_t i, bool part, std::size_t CP,
                          const Opts_t& opts);
     void extend_add_copy_to_buffers(std::vector<std::vector<scalar_t>>& sbuf,
@@ -107,6 +107,9 @@ namespace strumpack {
                                   std::vector<DistM_t>& B) const override;
 
     std::string type() const override { return "FrontalMatrixBLRMPI"; }
+    CompressionType compression_kind() const override {
+      return CompressionType::BLR;
+    }
 
     void partition(const Opts_t& opts, const SpMat_t& A,
                    integer_t* sorder, bool is_root, int task_depth) override;
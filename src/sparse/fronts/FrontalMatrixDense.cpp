@@ -27,7 +27,16 @@
  *
  */
 
+#include <limits>
+#include <functional>
+#include <typeinfo>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 #include "FrontalMatrixDense.hpp"
+#include "dense/BLASLAPACKOpenMPTask.hpp"
 #if defined(STRUMPACK_USE_MPI)
 #include "ExtendAdd.hpp"
 #include "FrontalMatrixMPI.hpp"
@@ -73,14 +82,23 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> ReturnCode
   FrontalMatrixDense<scalar_t,integer_t>::node_inertia
   (integer_t& neg, integer_t& zero, integer_t& pos) const {
+    if (lowp_) {
+      DenseM_t F11(F11lp_.rows(), F11lp_.cols());
+      copy(F11lp_, F11);
+      return matrix_inertia(F11, neg, zero, pos);
+    }
     return matrix_inertia(F11_, neg, zero, pos);
   }
 
   template<typename scalar_t,typename integer_t> ReturnCode
   FrontalMatrixDense<scalar_t,integer_t>::node_subnormals
   (std::size_t& ns, std::size_t& nz) const {
-    auto dns = F11_.subnormals() + F12_.subnormals() + F21_.subnormals();
-    auto dnz = F11_.zeros() + F12_.zeros() + F21_.zeros();
+    auto dns = lowp_ ?
+      F11lp_.subnormals() + F12lp_.subnormals() + F21lp_.subnormals() :
+      F11_.subnormals() + F12_.subnormals() + F21_.subnormals();
+    auto dnz = lowp_ ?
+      F11lp_.zeros() + F12lp_.zeros() + F21lp_.zeros() :
+      F11_.zeros() + F12_.zeros() + F21_.zeros();
     // if (dns || dnz)
     //   std::cout << "DENSE front ds= " << this->dim_sep()
     //             << " du= " << this->dim_upd()
@@ -201,6 +219,15 @@ namespace strumpack {
   (const SpMat_t& A, const Opts_t& opts, VectorPool<scalar_t>& workspace,
    int etree_level, int task_depth) {
     ReturnCode e1, e2;
+#if defined(STRUMPACK_USE_OPENMP_TASK_DEPEND)
+    if (task_depth == 0 && opts.use_openmp_tree() && opts.use_task_dag() &&
+        typeid(*this) == typeid(FrontalMatrixDense<scalar_t,integer_t>)) {
+      e1 = ReturnCode::SUCCESS;
+#pragma omp parallel if(!omp_in_parallel()) default(shared)
+#pragma omp single nowait
+      e2 = factor_task_dag(A, opts, workspace, etree_level);
+    } else
+#endif
     if (task_depth == 0) {
 #pragma omp parallel if(!omp_in_parallel()) default(shared)
 #pragma omp single nowait
@@ -215,6 +242,113 @@ namespace strumpack {
     return (e1 == ReturnCode::SUCCESS) ? e2 : e1;
   }
 
+  template<typename scalar_t,typename integer_t> ReturnCode
+  FrontalMatrixDense<scalar_t,integer_t>::factor_task_dag
+  (const SpMat_t& A, const Opts_t& opts, VectorPool<scalar_t>& workspace,
+   int etree_level) {
+#if defined(STRUMPACK_USE_OPENMP_TASK_DEPEND)
+    using FD_t = FrontalMatrixDense<scalar_t,integer_t>;
+    struct Node {
+      F_t* f;
+      FD_t* d;    // nullptr if the subtree is factored as a single task
+      int level, parent, l, r;
+      double cost, sub, cp;
+    };
+    // LU of F11, solves with F12 and F21, and the F22 update
+    auto front_cost = [](const F_t* f) {
+      double ds = f->dim_sep(), du = f->dim_upd();
+      return 2./3.*ds*ds*ds + 2.*ds*ds*du + 2.*ds*du*du;
+    };
+    // collect the fronts in postorder, only expand the children of
+    // fronts which are exactly FrontalMatrixDense
+    std::vector<Node> nodes;
+    std::function<int(F_t*,int)> add = [&](F_t* f, int level) {
+      Node nd{f, nullptr, level, -1, -1, -1, front_cost(f), 0., 0.};
+      if (typeid(*f) == typeid(FD_t)) {
+        nd.d = static_cast<FD_t*>(f);
+        if (nd.d->lchild_) nd.l = add(nd.d->lchild_.get(), level+1);
+        if (nd.d->rchild_) nd.r = add(nd.d->rchild_.get(), level+1);
+      } else // rough estimate for the entire subtree
+        nd.sub = double(f->dense_factor_nonzeros
+                        (params::task_recursion_cutoff_level)) * f->dim_sep();
+      nodes.push_back(nd);
+      int i = nodes.size() - 1;
+      for (auto c : {nd.l, nd.r})
+        if (c != -1) nodes[c].parent = i;
+      return i;
+    };
+    add(this, etree_level);
+    const int n = nodes.size();
+    // subtree cost, bottom-up
+    for (auto& nd : nodes) {
+      if (!nd.d) continue;
+      nd.sub = nd.cost;
+      for (auto c : {nd.l, nd.r})
+        if (c != -1) nd.sub += nodes[c].sub;
+    }
+    // critical path to the root, top-down. Subtrees with little work
+    // are factored as a single (sequential) task.
+    const double min_task =
+      nodes[n-1].sub / (64. * std::max(1, omp_get_num_threads()));
+    std::vector<bool> small(n), skip(n);
+    double cp_max = 0.;
+    for (int i=n-1; i>=0; i--) {
+      auto& nd = nodes[i];
+      small[i] = i != n-1 && nd.sub < min_task;
+      nd.cp = ((nd.d && !small[i]) ? nd.cost : nd.sub) +
+        ((nd.parent == -1) ? 0. : nodes[nd.parent].cp);
+      skip[i] = nd.parent != -1 && (small[nd.parent] || skip[nd.parent]);
+      cp_max = std::max(cp_max, nd.cp);
+    }
+    const int max_prio = omp_get_max_task_priority();
+    auto priority = [&](int i) {
+      return (cp_max > 0.) ? int(max_prio * nodes[i].cp / cp_max) : 0;
+    };
+    const int cutoff = params::task_recursion_cutoff_level;
+    ReturnCode err_code = ReturnCode::SUCCESS;
+    auto set_error = [&](ReturnCode e) {
+      if (e == ReturnCode::SUCCESS) return;
+#pragma omp critical
+      if (err_code == ReturnCode::SUCCESS) err_code = e;
+    };
+    // dependency tokens, D[n] is a dummy for missing children
+    std::unique_ptr<int[]> Eu(new int[n+1]), Du(new int[n+1]);
+    int *E = Eu.get(), *D = Du.get();
+    for (int i=0; i<n; i++) {
+      if (skip[i]) continue;
+      auto& nd = nodes[i];
+      int prio = priority(i);
+      if (!nd.d || small[i]) {
+        int td = small[i] ? cutoff : 1;
+#pragma omp task default(shared) firstprivate(i,td) \
+  depend(out:D[i]) priority(prio)
+        set_error(nodes[i].f->factor
+                  (A, opts, workspace, nodes[i].level, td));
+        continue;
+      }
+      int l = (nd.l == -1) ? n : nd.l, r = (nd.r == -1) ? n : nd.r;
+      int td = std::min(nd.level - etree_level, cutoff);
+      // the front can be extracted before the children are done
+#pragma omp task default(shared) firstprivate(i,td) \
+  depend(out:E[i]) priority(prio)
+      nodes[i].d->extract_front(A, td);
+#pragma omp task default(shared) firstprivate(i,td)     \
+  depend(in:E[i],D[l],D[r]) depend(out:D[i]) priority(prio)
+      {
+        auto d = nodes[i].d;
+        d->assemble_children(opts, workspace, nodes[i].level, td);
+        set_error(d->factor_phase2(A, opts, nodes[i].level, td));
+      }
+    }
+#pragma omp taskwait
+    return err_code;
+#else
+    auto e1 = factor_phase1(A, opts, workspace, etree_level, 1);
+    auto e2 = factor_phase2(A, opts, etree_level, 0);
+    return (e1 == ReturnCode::SUCCESS) ? e2 : e1;
+#endif
+  }
+
   template<typename scalar_t,typename integer_t> ReturnCode
   FrontalMatrixDense<scalar_t,integer_t>::factor_phase1
   (const SpMat_t& A, const Opts_t& opts, VectorPool<scalar_t>& workspace,
@@ -238,6 +372,14 @@ namespace strumpack {
         er = rchild_->factor(A, opts, workspace, etree_level+1, task_depth);
     }
     ReturnCode err_code = (el == ReturnCode::SUCCESS) ? er : el;
+    extract_front(A, task_depth);
+    assemble_children(opts, workspace, etree_level, task_depth);
+    return err_code;
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDense<scalar_t,integer_t>::extract_front
+  (const SpMat_t& A, int task_depth) {
     // TODO can we allocate the memory in one go??
     const auto dsep = dim_sep();
     const auto dupd = dim_upd();
@@ -247,6 +389,13 @@ namespace strumpack {
     A.extract_front
       (F11_, F12_, F21_, this->sep_begin_, this->sep_end_,
        this->upd_, task_depth);
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDense<scalar_t,integer_t>::assemble_children
+  (const Opts_t& opts, VectorPool<scalar_t>& workspace,
+   int etree_level, int task_depth) {
+    const auto dupd = dim_upd();
     if (dupd) {
       CBstorage_ = workspace.get();
       integer_t old_size = CBstorage_.size();
@@ -264,48 +413,150 @@ namespace strumpack {
       rchild_->extend_add_to_dense
         (F11_, F12_, F21_, F22_, this, workspace, task_depth);
     if (etree_level == 0 && opts.write_root_front()) F11_.write("Froot");
-    return err_code;
   }
 
   template<typename scalar_t,typename integer_t> ReturnCode
   FrontalMatrixDense<scalar_t,integer_t>::factor_phase2
   (const SpMat_t& A, const Opts_t& opts,
    int etree_level, int task_depth) {
+    TRACE_REGION("factor", this->sep_, etree_level,
+                 dim_sep(), dim_upd(), t_trace);
     ReturnCode err_code = ReturnCode::SUCCESS;
+    const bool try_lowp = allow_lowp_ && opts.adaptive_precision() &&
+      !std::is_same<lowp_t,scalar_t>::value &&
+      dim_sep() + dim_upd() >= opts.adaptive_precision_min_front_size();
+    real_t F11norm(0.);
     if (dim_sep()) {
-      if (F11_.LU(piv_, task_depth))
-        err_code = ReturnCode::ZERO_PIVOT;
-      if (opts.replace_tiny_pivots()) {
-        auto thresh = opts.pivot_threshold();
-        for (std::size_t i=0; i<F11_.rows(); i++)
-          if (std::abs(F11_(i,i)) < thresh)
-            F11_(i,i) = (std::real(F11_(i,i)) < 0) ? -thresh : thresh;
-      }
-      if (dim_upd()) {
-        F12_.laswp(piv_, true);
-        trsm(Side::L, UpLo::L, Trans::N, Diag::U,
-             scalar_t(1.), F11_, F12_, task_depth);
-        trsm(Side::R, UpLo::U, Trans::N, Diag::N,
-             scalar_t(1.), F11_, F21_, task_depth);
-        gemm(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_,
-             scalar_t(1.), F22_, task_depth);
+      if (try_lowp) F11norm = F11_.norm1();
+#if defined(_OPENMP)
+      const bool tiled = dim_sep() >= opts.tiled_LU_min_sep_size() &&
+        task_depth < params::task_recursion_cutoff_level &&
+        omp_in_parallel();
+#else
+      const bool tiled = false;
+#endif
+      if (tiled) {
+        // tiled LU, with F12/F21 solves and F22 update overlapped
+        piv_.resize(dim_sep());
+        if (getrf_tiled_omp_task
+            (dim_sep(), dim_upd(), F11_.data(), F11_.ld(),
+             F12_.data(), F12_.ld(), F21_.data(), F21_.ld(),
+             F22_.data(), F22_.ld(), piv_.data(),
+             opts.tiled_LU_tile_size(), opts.replace_tiny_pivots() ?
+             opts.pivot_threshold() : real_t(0.)))
+          err_code = ReturnCode::ZERO_PIVOT;
+      } else {
+        if (F11_.LU(piv_, task_depth))
+          err_code = ReturnCode::ZERO_PIVOT;
+        if (opts.replace_tiny_pivots()) {
+          auto thresh = opts.pivot_threshold();
+          for (std::size_t i=0; i<F11_.rows(); i++)
+            if (std::abs(F11_(i,i)) < thresh)
+              F11_(i,i) = (std::real(F11_(i,i)) < 0) ? -thresh : thresh;
+        }
+        if (dim_upd()) {
+          F12_.laswp(piv_, true);
+          trsm(Side::L, UpLo::L, Trans::N, Diag::U,
+               scalar_t(1.), F11_, F12_, task_depth);
+          trsm(Side::R, UpLo::U, Trans::N, Diag::N,
+               scalar_t(1.), F11_, F21_, task_depth);
+          gemm(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_,
+               scalar_t(1.), F22_, task_depth);
+        }
       }
     }
-    STRUMPACK_FULL_RANK_FLOPS
-      (LU_flops(F11_) +
-       gemm_flops(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_, scalar_t(1.)) +
-       trsm_flops(Side::L, scalar_t(1.), F11_, F12_) +
-       trsm_flops(Side::R, scalar_t(1.), F11_, F21_));
+#if defined(STRUMPACK_COUNT_FLOPS) || defined(STRUMPACK_TASK_TIMERS)
+    auto flops = LU_flops(F11_) +
+      gemm_flops(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_, scalar_t(1.)) +
+      trsm_flops(Side::L, scalar_t(1.), F11_, F12_) +
+      trsm_flops(Side::R, scalar_t(1.), F11_, F21_);
+    STRUMPACK_FULL_RANK_FLOPS(flops);
+    TRACE_FLOPS(t_trace, flops);
+#endif
+    if (try_lowp && err_code == ReturnCode::SUCCESS)
+      store_lower_precision(opts, F11norm);
     return err_code;
   }
 
+  /**
+   * Convert the factors F11, F12 and F21 to lower precision, if the
+   * (estimated) condition number of F11 is small enough that the
+   * lower precision factors still give a useful preconditioner for
+   * iterative refinement/GMRES in the working precision. The full
+   * precision factors are released. Returns true if the factors were
+   * converted.
+   */
+  template<typename scalar_t,typename integer_t> bool
+  FrontalMatrixDense<scalar_t,integer_t>::store_lower_precision
+  (const Opts_t& opts, real_t F11norm) {
+    using lowp_real_t = typename RealType<lowp_t>::value_type;
+    const auto ds = dim_sep();
+    if (!ds) return false;
+    real_t rcond(0.);
+    if (blas::gecon('1', ds, F11_.data(), F11_.ld(), F11norm, &rcond) ||
+        !(rcond > real_t(0.)))
+      return false;
+    const real_t eps_lowp = blas::lamch<lowp_real_t>('E');
+    if (eps_lowp / rcond > opts.adaptive_precision_tol())
+      return false;
+    // all entries should be representable in the lower precision
+    const real_t big = std::numeric_limits<lowp_real_t>::max();
+    auto fits = [&big](const DenseM_t& F) {
+      for (std::size_t j=0; j<F.cols(); j++)
+        for (std::size_t i=0; i<F.rows(); i++)
+          if (!(std::abs(F(i,j)) < big)) return false;
+      return true;
+    };
+    if (!fits(F11_) || !fits(F12_) || !fits(F21_))
+      return false;
+    F11lp_ = DenseMLP_t(F11_.rows(), F11_.cols());
+    F12lp_ = DenseMLP_t(F12_.rows(), F12_.cols());
+    F21lp_ = DenseMLP_t(F21_.rows(), F21_.cols());
+    copy(F11_, F11lp_);
+    copy(F12_, F12lp_);
+    copy(F21_, F21lp_);
+    F11_ = DenseM_t();
+    F12_ = DenseM_t();
+    F21_ = DenseM_t();
+    lowp_ = true;
+    return true;
+  }
+
+  template<typename scalar_t,typename integer_t> long long
+  FrontalMatrixDense<scalar_t,integer_t>::node_factor_nonzeros() const {
+    auto nnz = F_t::node_factor_nonzeros();
+    // report the memory equivalent in scalar_t
+    return lowp_ ? nnz * sizeof(lowp_t) / sizeof(scalar_t) : nnz;
+  }
+
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixDense<scalar_t,integer_t>::fwd_solve_phase2
   (DenseM_t& b, DenseM_t& bupd, int etree_level, int task_depth) const {
+    TRACE_REGION("forward_solve", this->sep_, etree_level,
+                 dim_sep(), dim_upd(), t_trace);
+    TRACE_FLOPS(t_trace, 2. * b.cols() * dim_sep() *
+                (dim_sep() + 2. * dim_upd()));
     if (dim_sep()) {
       DenseMW_t bloc(dim_sep(), b.cols(), b, this->sep_begin_, 0);
       bloc.laswp(piv_, true);
-      if (b.cols() == 1) {
+      if (lowp_) {
+        DenseMLP_t lb(bloc.rows(), bloc.cols());
+        copy(bloc, lb);
+        if (b.cols() == 1)
+          trsv(UpLo::L, Trans::N, Diag::U, F11lp_, lb, task_depth);
+        else
+          trsm(Side::L, UpLo::L, Trans::N, Diag::U,
+               lowp_t(1.), F11lp_, lb, task_depth);
+        copy(lb, bloc);
+        if (dim_upd()) {
+          DenseMLP_t lupd(bupd.rows(), bupd.cols());
+          gemm(Trans::N, Trans::N, lowp_t(-1.), F21lp_, lb,
+               lowp_t(0.), lupd, task_depth);
+          for (std::size_t j=0; j<bupd.cols(); j++)
+            for (std::size_t i=0; i<bupd.rows(); i++)
+              bupd(i,j) += static_cast<scalar_t>(lupd(i,j));
+        }
+      } else if (b.cols() == 1) {
         trsv(UpLo::L, Trans::N, Diag::U, F11_, bloc, task_depth);
         if (dim_upd())
           gemv(Trans::N, scalar_t(-1.), F21_, bloc,
@@ -323,9 +574,28 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixDense<scalar_t,integer_t>::bwd_solve_phase1
   (DenseM_t& y, DenseM_t& yupd, int etree_level, int task_depth) const {
+    TRACE_REGION("backward_solve", this->sep_, etree_level,
+                 dim_sep(), dim_upd(), t_trace);
+    TRACE_FLOPS(t_trace, 2. * y.cols() * dim_sep() *
+                (dim_sep() + 2. * dim_upd()));
     if (dim_sep()) {
       DenseMW_t yloc(dim_sep(), y.cols(), y, this->sep_begin_, 0);
-      if (y.cols() == 1) {
+      if (lowp_) {
+        DenseMLP_t ly(yloc.rows(), yloc.cols());
+        copy(yloc, ly);
+        if (dim_upd()) {
+          DenseMLP_t lupd(yupd.rows(), yupd.cols());
+          copy(yupd, lupd);
+          gemm(Trans::N, Trans::N, lowp_t(-1.), F12lp_, lupd,
+               lowp_t(1.), ly, task_depth);
+        }
+        if (y.cols() == 1)
+          trsv(UpLo::U, Trans::N, Diag::N, F11lp_, ly, task_depth);
+        else
+          trsm(Side::L, UpLo::U, Trans::N, Diag::N, lowp_t(1.),
+               F11lp_, ly, task_depth);
+        copy(ly, yloc);
+      } else if (y.cols() == 1) {
         if (dim_upd())
           gemv(Trans::N, scalar_t(-1.), F12_, yupd,
                scalar_t(1.), yloc, task_depth);
@@ -516,6 +786,10 @@ namespace strumpack {
     F12_ = DenseM_t();
     F21_ = DenseM_t();
     F22_ = DenseMW_t();
+    F11lp_ = DenseMLP_t();
+    F12lp_ = DenseMLP_t();
+    F21lp_ = DenseMLP_t();
+    lowp_ = false;
     piv_ = std::vector<int>();
   }
 
@@ -52,6 +52,9 @@ namespace strumpack {
     using SpMat_t = CompressedSparseMatrix<scalar_t,integer_t>;
     using BLRM_t = BLR::BLRMatrix<scalar_t>;
     using Opts_t = SPOptions<scalar_t>;
+    using real_t = typename RealType<scalar_t>::value_type;
+    using lowp_t = typename LowerPrecision<scalar_t>::value_type;
+    using DenseMLP_t = DenseMatrix<lowp_t>;
 
   public:
     FrontalMatrixDense(integer_t sep, integer_t sep_begin, integer_t sep_end,
@@ -133,6 +136,14 @@ namespace strumpack {
     std::vector<scalar_t,NoInit<scalar_t>> CBstorage_;
     std::vector<int> piv_; // regular int because it is passed to BLAS
 
+    // factors stored in lower precision, see
+    // SPOptions::enable_adaptive_precision
+    DenseMLP_t F11lp_, F12lp_, F21lp_;
+    bool lowp_ = false;
+    // set to false in derived classes which store the factors
+    // differently, for instance compressed
+    bool allow_lowp_ = true;
+
     FrontalMatrixDense(const FrontalMatrixDense&) = delete;
     FrontalMatrixDense& operator=(FrontalMatrixDense const&) = delete;
 
@@ -141,6 +152,29 @@ namespace strumpack {
                              int etree_level, int task_depth);
     ReturnCode factor_phase2(const SpMat_t& A, const Opts_t& opts,
                              int etree_level, int task_depth);
+    void extract_front(const SpMat_t& A, int task_depth);
+    void assemble_children(const Opts_t& opts,
+                           VectorPool<scalar_t>& workspace,
+                           int etree_level, int task_depth);
+
+    /**
+     * Factor the tree rooted at this front with one OpenMP task per
+     * dense front, and task dependencies from the children to the
+     * parent, instead of the recursive fork-join traversal. Ready
+     * tasks are prioritized by the critical path length (flops) to
+     * the root. Subtrees rooted at fronts which are not (exactly)
+     * FrontalMatrixDense, or with a small amount of work, are
+     * factored as a single task. Should be called from within an
+     * OpenMP parallel region.
+     *
+     * \see SPOptions::enable_task_dag
+     */
+    ReturnCode factor_task_dag(const SpMat_t& A, const Opts_t& opts,
+                               VectorPool<scalar_t>& workspace,
+                               int etree_level);
+
+    bool store_lower_precision(const Opts_t& opts, real_t F11norm);
+    long long node_factor_nonzeros() const override;
 
     virtual void
     fwd_solve_phase2(DenseM_t& b, DenseM_t& bupd, int etree_level,
@@ -155,16 +155,26 @@ namespace strumpack {
     TaskTimer pf("FrontalMatrixDenseMPI_factor");
     pf.start();
 #if defined(STRUMPACK_USE_SLATE_SCALAPACK)
+    const bool tiled = false;
     if (opts.use_gpu())
       slate_opts_.insert({slate::Option::Target, slate::Target::Devices});
     auto slateF11 = slate_matrix(F11_);
     // TODO get return value
     slate::getrf(slateF11, slate_piv_, slate_opts_);
 #else
-    if (F11_.LU(piv))
+    using real_t = typename RealType<scalar_t>::value_type;
+    const bool tiled = opts.distributed_tiled_LU() &&
+      this->dim_sep() >= opts.tiled_LU_min_sep_size();
+    if (tiled) {
+      // F12/F21 solves and the F22 update are part of the tiled LU
+      if (getrf_tiled_mpi(F11_, F12_, F21_, F22_, piv,
+                          opts.replace_tiny_pivots() ?
+                          opts.pivot_threshold() : real_t(0.)))
+        err_code = ReturnCode::ZERO_PIVOT;
+    } else if (F11_.LU(piv))
       err_code = ReturnCode::ZERO_PIVOT;
 #endif
-    if (opts.replace_tiny_pivots()) {
+    if (opts.replace_tiny_pivots() && !tiled) {
       auto thresh = opts.pivot_threshold();
       int prow = F11_.prow(), pcol = F11_.pcol();
       for (int i=0; i<F11_.rows(); i++) {
@@ -187,10 +197,12 @@ namespace strumpack {
       slate::gemm(scalar_t(-1.), slateF21, slateF12,
                   scalar_t(1.), slateF22, slate_opts_);
 #else
-      F12_.laswp(piv, true);
-      trsm(Side::L, UpLo::L, Trans::N, Diag::U, scalar_t(1.), F11_, F12_);
-      trsm(Side::R, UpLo::U, Trans::N, Diag::N, scalar_t(1.), F11_, F21_);
-      gemm(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_, scalar_t(1.), F22_);
+      if (!tiled) {
+        F12_.laswp(piv, true);
+        trsm(Side::L, UpLo::L, Trans::N, Diag::U, scalar_t(1.), F11_, F12_);
+        trsm(Side::R, UpLo::U, Trans::N, Diag::N, scalar_t(1.), F11_, F21_);
+        gemm(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_, scalar_t(1.), F22_);
+      }
 #endif
       flops += gemm_flops(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_, scalar_t(1.)) +
         trsm_flops(Side::L, scalar_t(1.), F11_, F12_) +
@@ -258,8 +270,17 @@ namespace strumpack {
     }
     if (lchild_) lchild_->release_work_memory();
     if (rchild_) rchild_->release_work_memory();
-    auto ef = partial_factorization(opts);
-    if (ef != ReturnCode::SUCCESS) err_code = ef;
+    {
+      TRACE_REGION("factor", this->sep_, etree_level,
+                   this->dim_sep(), this->dim_upd(), t_trace);
+      // flops for the entire front, not only for this rank
+      TRACE_FLOPS(t_trace, 2. * this->dim_sep() *
+                  (this->dim_sep() * this->dim_sep() / 3. +
+                   this->dim_sep() * this->dim_upd() +
+                   double(this->dim_upd()) * this->dim_upd()));
+      auto ef = partial_factorization(opts);
+      if (ef != ReturnCode::SUCCESS) err_code = ef;
+    }
 #if defined(STRUMPACK_USE_ZFP)
     compress(opts);
 #endif
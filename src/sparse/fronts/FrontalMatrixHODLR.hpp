@@ -132,6 +132,9 @@ namespace strumpack {
     integer_t front_rank(int task_depth=0) const override;
     void print_rank_statistics(std::ostream &out) const override;
     std::string type() const override { return "FrontalMatrixHODLR"; }
+    CompressionType compression_kind() const override {
+      return CompressionType::HODLR;
+    }
 
     void partition(const Opts_t& opts, const SpMat_t& A, integer_t* sorder,
                    bool is_root=true, int task_depth=0) override;
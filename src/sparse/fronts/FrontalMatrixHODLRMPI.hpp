@@ -107,6 +107,9 @@ namespace strumpack {
     long long node_factor_nonzeros() const override;
     integer_t front_rank(int task_depth=0) const override;
     std::string type() const override { return "FrontalMatrixHODLRMPI"; }
+    CompressionType compression_kind() const override {
+      return CompressionType::HODLR;
+    }
 
     void extract_CB_sub_matrix_2d(const VecVec_t& I, const VecVec_t& J,
                                   std::vector<DistM_t>& B) const override;
@@ -0,0 +1,205 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include "FrontalMatrixHODLRNative.hpp"
+#include "structured/ClusterTree.hpp"
+
+namespace strumpack {
+
+  template<typename scalar_t,typename integer_t>
+  FrontalMatrixHODLRNative<scalar_t,integer_t>::FrontalMatrixHODLRNative
+  (integer_t sep, integer_t sep_begin, integer_t sep_end,
+   std::vector<integer_t>& upd)
+    : FD_t(sep, sep_begin, sep_end, upd) {
+    this->allow_lowp_ = false;
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixHODLRNative<scalar_t,integer_t>::delete_factors() {
+    FD_t::delete_factors();
+    F11H_ = HODLR_t();
+    F12U_ = DenseM_t(); F12V_ = DenseM_t();
+    F21U_ = DenseM_t(); F21V_ = DenseM_t();
+    F12lr_ = F21lr_ = false;
+  }
+
+  template<typename scalar_t,typename integer_t> integer_t
+  FrontalMatrixHODLRNative<scalar_t,integer_t>::front_rank
+  (int task_depth) const {
+    return std::max
+      ({F11H_.rank(), F12V_.rows(), F21V_.rows()});
+  }
+
+  template<typename scalar_t,typename integer_t> long long
+  FrontalMatrixHODLRNative<scalar_t,integer_t>::node_factor_nonzeros() const {
+    return F11H_.nonzeros() + this->F12_.nonzeros() + this->F21_.nonzeros()
+      + F12U_.nonzeros() + F12V_.nonzeros()
+      + F21U_.nonzeros() + F21V_.nonzeros();
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  FrontalMatrixHODLRNative<scalar_t,integer_t>::factor
+  (const SpMat_t& A, const Opts_t& opts, VectorPool<scalar_t>& workspace,
+   int etree_level, int task_depth) {
+    ReturnCode e1, e2;
+    if (task_depth == 0) {
+#pragma omp parallel if(!omp_in_parallel()) default(shared)
+#pragma omp single nowait
+      {
+        e1 = this->factor_phase1
+          (A, opts, workspace, etree_level, task_depth+1);
+        e2 = factor_node(opts, etree_level, task_depth);
+      }
+    } else {
+      e1 = this->factor_phase1(A, opts, workspace, etree_level, task_depth);
+      e2 = factor_node(opts, etree_level, task_depth);
+    }
+    return (e1 == ReturnCode::SUCCESS) ? e2 : e1;
+  }
+
+  /**
+   * Replace F by U*V if the rank, with the HODLR tolerances, is small
+   * enough for this to save memory.
+   */
+  template<typename scalar_t,typename integer_t> bool
+  FrontalMatrixHODLRNative<scalar_t,integer_t>::compress_lr
+  (DenseM_t& F, DenseM_t& U, DenseM_t& V, const Opts_t& opts,
+   int task_depth) {
+    auto& hopts = opts.HODLR_options();
+    F.low_rank(U, V, hopts.rel_tol(), hopts.abs_tol(),
+               hopts.max_rank(), task_depth);
+    if (U.nonzeros() + V.nonzeros() < F.nonzeros()) {
+      F.clear();
+      return true;
+    }
+    U.clear();
+    V.clear();
+    return false;
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  FrontalMatrixHODLRNative<scalar_t,integer_t>::factor_node
+  (const Opts_t& opts, int etree_level, int task_depth) {
+    TRACE_REGION("factor", this->sep_, etree_level,
+                 dim_sep(), dim_upd(), t_trace);
+    ReturnCode err_code = ReturnCode::SUCCESS;
+    if (!dim_sep()) return err_code;
+    structured::ClusterTree t(dim_sep());
+    t.refine(opts.HODLR_options().leaf_size());
+    F11H_ = HODLR_t(t, this->F11_, opts.HODLR_options(), task_depth);
+    this->F11_.clear();
+    if (F11H_.factor(opts.replace_tiny_pivots() ?
+                     opts.pivot_threshold() : real_t(0.), task_depth))
+      err_code = ReturnCode::ZERO_PIVOT;
+    if (!dim_upd()) return err_code;
+    F12lr_ = compress_lr(this->F12_, F12U_, F12V_, opts, task_depth);
+    F21lr_ = compress_lr(this->F21_, F21U_, F21V_, opts, task_depth);
+    // F22 -= F21 * F11^{-1} * F12, with F12 = U12 V12 and/or F21 =
+    // U21 V21, the products are done right to left
+    DenseM_t X(F12lr_ ? F12U_ : this->F12_);
+    F11H_.solve(X, task_depth);
+    if (F21lr_) {
+      DenseM_t Y(F21V_.rows(), X.cols());
+      gemm(Trans::N, Trans::N, scalar_t(1.), F21V_, X,
+           scalar_t(0.), Y, task_depth);
+      X = std::move(Y);
+    }
+    const DenseM_t& L = F21lr_ ? F21U_ : this->F21_;
+    if (F12lr_) {
+      DenseM_t Z(dim_upd(), X.cols());
+      gemm(Trans::N, Trans::N, scalar_t(1.), L, X,
+           scalar_t(0.), Z, task_depth);
+      gemm(Trans::N, Trans::N, scalar_t(-1.), Z, F12V_,
+           scalar_t(1.), this->F22_, task_depth);
+    } else
+      gemm(Trans::N, Trans::N, scalar_t(-1.), L, X,
+           scalar_t(1.), this->F22_, task_depth);
+    return err_code;
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixHODLRNative<scalar_t,integer_t>::fwd_solve_phase2
+  (DenseM_t& b, DenseM_t& bupd, int etree_level, int task_depth) const {
+    if (!dim_sep()) return;
+    DenseMW_t bloc(dim_sep(), b.cols(), b, this->sep_begin_, 0);
+    F11H_.solve(bloc, task_depth);
+    if (!dim_upd()) return;
+    // bupd -= F21 * bloc
+    if (F21lr_) {
+      DenseM_t tmp(F21V_.rows(), b.cols());
+      gemm(Trans::N, Trans::N, scalar_t(1.), F21V_, bloc,
+           scalar_t(0.), tmp, task_depth);
+      gemm(Trans::N, Trans::N, scalar_t(-1.), F21U_, tmp,
+           scalar_t(1.), bupd, task_depth);
+    } else
+      gemm(Trans::N, Trans::N, scalar_t(-1.), this->F21_, bloc,
+           scalar_t(1.), bupd, task_depth);
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixHODLRNative<scalar_t,integer_t>::bwd_solve_phase1
+  (DenseM_t& y, DenseM_t& yupd, int etree_level, int task_depth) const {
+    if (!dim_sep() || !dim_upd()) return;
+    // yloc -= F11^{-1} F12 yupd, F11^{-1} F12 is not stored
+    DenseMW_t yloc(dim_sep(), y.cols(), y, this->sep_begin_, 0);
+    DenseM_t tmp(dim_sep(), y.cols());
+    if (F12lr_) {
+      DenseM_t tmp2(F12V_.rows(), y.cols());
+      gemm(Trans::N, Trans::N, scalar_t(1.), F12V_, yupd,
+           scalar_t(0.), tmp2, task_depth);
+      gemm(Trans::N, Trans::N, scalar_t(1.), F12U_, tmp2,
+           scalar_t(0.), tmp, task_depth);
+    } else
+      gemm(Trans::N, Trans::N, scalar_t(1.), this->F12_, yupd,
+           scalar_t(0.), tmp, task_depth);
+    F11H_.solve(tmp, task_depth);
+    yloc.scaled_add(scalar_t(-1.), tmp, task_depth);
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  FrontalMatrixHODLRNative<scalar_t,integer_t>::node_inertia
+  (integer_t& neg, integer_t& zero, integer_t& pos) const {
+    return ReturnCode::INACCURATE_INERTIA;
+  }
+
+  // explicit template instantiations
+  template class FrontalMatrixHODLRNative<float,int>;
+  template class FrontalMatrixHODLRNative<double,int>;
+  template class FrontalMatrixHODLRNative<std::complex<float>,int>;
+  template class FrontalMatrixHODLRNative<std::complex<double>,int>;
+
+  template class FrontalMatrixHODLRNative<float,long int>;
+  template class FrontalMatrixHODLRNative<double,long int>;
+  template class FrontalMatrixHODLRNative<std::complex<float>,long int>;
+  template class FrontalMatrixHODLRNative<std::complex<double>,long int>;
+
+  template class FrontalMatrixHODLRNative<float,long long int>;
+  template class FrontalMatrixHODLRNative<double,long long int>;
+  template class FrontalMatrixHODLRNative<std::complex<float>,long long int>;
+  template class FrontalMatrixHODLRNative<std::complex<double>,long long int>;
+
+} // end namespace strumpack
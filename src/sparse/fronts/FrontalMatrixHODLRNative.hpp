@@ -0,0 +1,112 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#ifndef FRONTAL_MATRIX_HODLR_NATIVE_HPP
+#define FRONTAL_MATRIX_HODLR_NATIVE_HPP
+
+#include "FrontalMatrixDense.hpp"
+#include "HODLR/HODLRMatrixNative.hpp"
+
+namespace strumpack {
+
+  /**
+   * Frontal matrix where the F11 block is compressed as a shared
+   * memory HODLR::HODLRMatrixNative, and the F12 and F21 blocks are
+   * stored as low-rank products U*V when that saves memory. This is
+   * used for CompressionType::HODLR when STRUMPACK is not configured
+   * with ButterflyPACK.
+   *
+   * The front is first assembled as a dense matrix, as in
+   * FrontalMatrixDense, then F11 is compressed and factored, and the
+   * Schur complement F22 - F21 F11^{-1} F12 is computed densely.
+   */
+  template<typename scalar_t,typename integer_t> class FrontalMatrixHODLRNative
+    : public FrontalMatrixDense<scalar_t,integer_t> {
+    using F_t = FrontalMatrix<scalar_t,integer_t>;
+    using FD_t = FrontalMatrixDense<scalar_t,integer_t>;
+    using DenseM_t = DenseMatrix<scalar_t>;
+    using DenseMW_t = DenseMatrixWrapper<scalar_t>;
+    using SpMat_t = CompressedSparseMatrix<scalar_t,integer_t>;
+    using HODLR_t = HODLR::HODLRMatrixNative<scalar_t>;
+    using real_t = typename RealType<scalar_t>::value_type;
+    using Opts_t = SPOptions<scalar_t>;
+
+  public:
+    FrontalMatrixHODLRNative(integer_t sep, integer_t sep_begin,
+                             integer_t sep_end, std::vector<integer_t>& upd);
+
+    ReturnCode
+    multifrontal_factorization(const SpMat_t& A, const Opts_t& opts,
+                               int etree_level=0, int task_depth=0) override {
+      VectorPool<scalar_t> workspace;
+      return factor(A, opts, workspace, etree_level, task_depth);
+    }
+    ReturnCode factor(const SpMat_t& A, const Opts_t& opts,
+                      VectorPool<scalar_t>& workspace,
+                      int etree_level=0, int task_depth=0) override;
+
+    void delete_factors() override;
+
+    std::string type() const override { return "FrontalMatrixHODLRNative"; }
+    CompressionType compression_kind() const override {
+      return CompressionType::HODLR;
+    }
+
+    integer_t front_rank(int task_depth=0) const override;
+    long long node_factor_nonzeros() const override;
+
+  private:
+    HODLR_t F11H_;
+    // F12 = F12U_ * F12V_ and F21 = F21U_ * F21V_ if compressed,
+    // else stored in F12_ and F21_
+    DenseM_t F12U_, F12V_, F21U_, F21V_;
+    bool F12lr_ = false, F21lr_ = false;
+
+    ReturnCode factor_node(const Opts_t& opts, int etree_level,
+                           int task_depth);
+    bool compress_lr(DenseM_t& F, DenseM_t& U, DenseM_t& V,
+                     const Opts_t& opts, int task_depth);
+
+    void fwd_solve_phase2(DenseM_t& b, DenseM_t& bupd,
+                          int etree_level, int task_depth) const override;
+    void bwd_solve_phase1(DenseM_t& y, DenseM_t& yupd,
+                          int etree_level, int task_depth) const override;
+
+    ReturnCode node_inertia(integer_t& neg, integer_t& zero,
+                            integer_t& pos) const override;
+
+    FrontalMatrixHODLRNative(const FrontalMatrixHODLRNative&) = delete;
+    FrontalMatrixHODLRNative& operator=
+    (FrontalMatrixHODLRNative const&) = delete;
+
+    using F_t::dim_sep;
+    using F_t::dim_upd;
+  };
+
+} // end namespace strumpack
+
+#endif // FRONTAL_MATRIX_HODLR_NATIVE_HPP
@@ -451,23 +451,40 @@ namespace strumpack {
     if (etree_level) {
       if (Theta_.cols() && Phi_.cols()) {
         DenseMW_t bloc(dim_sep(), b.cols(), b, sep_begin_, 0);
-        // TODO get rid of this!!!
-        ULVwork_ = std::unique_ptr<HSS::WorkSolve<scalar_t>>
-          (new HSS::WorkSolve<scalar_t>());
-        H_.child(0)->forward_solve(*ULVwork_, bloc, true);
+        auto& w = new_ULVwork(b);
+        H_.child(0)->forward_solve(w, bloc, true);
         if (dim_upd())
           gemm(Trans::N, Trans::N, scalar_t(-1.), Theta_,
-               ULVwork_->reduced_rhs, scalar_t(1.), bupd, task_depth);
-        ULVwork_->reduced_rhs.clear();
+               w.reduced_rhs, scalar_t(1.), bupd, task_depth);
+        w.reduced_rhs.clear();
       }
     } else {
       DenseMW_t bloc(dim_sep(), b.cols(), b, sep_begin_, 0);
-      ULVwork_ = std::unique_ptr<HSS::WorkSolve<scalar_t>>
-        (new HSS::WorkSolve<scalar_t>());
-      H_.forward_solve(*ULVwork_, bloc, false);
+      H_.forward_solve(new_ULVwork(b), bloc, false);
     }
   }
 
+  template<typename scalar_t,typename integer_t> HSS::WorkSolve<scalar_t>&
+  FrontalMatrixHSS<scalar_t,integer_t>::new_ULVwork
+  (const DenseM_t& b) const {
+    std::lock_guard<std::mutex> lock(ULVwork_mtx_);
+    auto& w = ULVwork_[b.data()];
+    w.reset(new HSS::WorkSolve<scalar_t>());
+    return *w;
+  }
+
+  template<typename scalar_t,typename integer_t>
+  std::unique_ptr<HSS::WorkSolve<scalar_t>>
+  FrontalMatrixHSS<scalar_t,integer_t>::take_ULVwork
+  (const DenseM_t& b) const {
+    std::lock_guard<std::mutex> lock(ULVwork_mtx_);
+    auto it = ULVwork_.find(b.data());
+    assert(it != ULVwork_.end());
+    auto w = std::move(it->second);
+    ULVwork_.erase(it);
+    return w;
+  }
+
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixHSS<scalar_t,integer_t>::backward_multifrontal_solve
   (DenseM_t& y, DenseM_t* work, int etree_level, int task_depth) const {
@@ -484,17 +501,17 @@ namespace strumpack {
     DenseMW_t yupd(dim_upd(), y.cols(), work[0], 0, 0);
     if (etree_level) {
       if (Phi_.cols() && Theta_.cols()) {
+        auto w = take_ULVwork(y);
         if (dim_upd()) {
           gemm(Trans::C, Trans::N, scalar_t(-1.), Phi_, yupd,
-               scalar_t(1.), ULVwork_->x, task_depth);
+               scalar_t(1.), w->x, task_depth);
         }
         DenseMW_t yloc(dim_sep(), y.cols(), y, sep_begin_, 0);
-        H_.child(0)->backward_solve(*ULVwork_, yloc);
-        ULVwork_.reset();
+        H_.child(0)->backward_solve(*w, yloc);
       }
     } else {
       DenseMW_t yloc(dim_sep(), y.cols(), y, sep_begin_, 0);
-      H_.backward_solve(*ULVwork_, yloc);
+      H_.backward_solve(*take_ULVwork(y), yloc);
     }
     this->bwd_solve_phase2(y, yupd, work, etree_level, task_depth);
   }
@@ -29,6 +29,9 @@
 #ifndef FRONTAL_MATRIX_HSS_HPP
 #define FRONTAL_MATRIX_HSS_HPP
 
+#include <map>
+#include <mutex>
+
 #include "FrontalMatrix.hpp"
 #include "HSS/HSSMatrix.hpp"
 
@@ -85,6 +88,9 @@ namespace strumpack {
     void print_rank_statistics(std::ostream &out) const override;
     bool isHSS() const override { return true; };
     std::string type() const override { return "FrontalMatrixHSS"; }
+    CompressionType compression_kind() const override {
+      return CompressionType::HSS;
+    }
 
     int random_samples() const override { return R1.cols(); };
 
@@ -95,8 +101,15 @@ namespace strumpack {
     // TODO make private?
     HSS::HSSMatrix<scalar_t> H_;
 
-    // TODO do not store this here: makes solve not thread safe!!
-    mutable std::unique_ptr<HSS::WorkSolve<scalar_t>> ULVwork_;
+    // ULV work memory from the forward to the backward solve, per
+    // right-hand side (identified by its data pointer), so that
+    // concurrent solves are safe
+    mutable std::map<const scalar_t*,
+                     std::unique_ptr<HSS::WorkSolve<scalar_t>>> ULVwork_;
+    mutable std::mutex ULVwork_mtx_;
+    HSS::WorkSolve<scalar_t>& new_ULVwork(const DenseM_t& b) const;
+    std::unique_ptr<HSS::WorkSolve<scalar_t>>
+    take_ULVwork(const DenseM_t& b) const;
 
     /** Schur complement update:
      *    S = F22 - _Theta * Vhat^C * _Phi^C
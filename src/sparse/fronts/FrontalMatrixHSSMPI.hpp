@@ -85,6 +85,9 @@ namespace strumpack {
     integer_t front_rank(int task_depth=0) const override;
     bool isHSS() const override { return true; };
     std::string type() const override { return "FrontalMatrixHSSMPI"; }
+    CompressionType compression_kind() const override {
+      return CompressionType::HSS;
+    }
 
     void partition(const Opts_t& opts, const SpMat_t& A, integer_t* sorder,
                    bool is_root=true, int task_depth=0) override;
@@ -119,7 +119,9 @@ namespace strumpack {
   FrontalMatrixLossy<scalar_t,integer_t>::FrontalMatrixLossy
   (integer_t sep, integer_t sep_begin, integer_t sep_end,
    std::vector<integer_t>& upd)
-    : FD_t(sep, sep_begin, sep_end, upd) {}
+    : FD_t(sep, sep_begin, sep_end, upd) {
+    this->allow_lowp_ = false;
+  }
 
   template<typename scalar_t,typename integer_t> long long
   FrontalMatrixLossy<scalar_t,integer_t>::node_factor_nonzeros() const {
@@ -103,6 +103,9 @@ namespace strumpack {
                       int etree_level=0, int task_depth=0) override;
 
     std::string type() const override { return "FrontalMatrixLossy"; }
+    CompressionType compression_kind() const override {
+      return CompressionType::LOSSY;
+    }
 
     void compress(const Opts_t& opts);
     void decompress(DenseM_t& F11, DenseM_t& F12, DenseM_t& F21) const;
@@ -247,6 +247,16 @@ namespace strumpack {
     return nnz;
   }
 
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixMPI<scalar_t,integer_t>::memory_report
+  (MemoryReport& r, int etree_level) const {
+    // factors and CB are distributed, only counted once, on the root
+    this->node_memory_report
+      (r, etree_level, !Comm().is_null() && Comm().is_root());
+    if (visit(lchild_)) lchild_->memory_report(r, etree_level+1);
+    if (visit(rchild_)) rchild_->memory_report(r, etree_level+1);
+  }
+
   template<typename scalar_t,typename integer_t> long long
   FrontalMatrixMPI<scalar_t,integer_t>::node_factor_nonzeros() const {
     long long dsep = this->dim_sep();
@@ -146,6 +146,7 @@ namespace strumpack {
     int P() const override { return grid()->P(); }
 
     virtual long long factor_nonzeros(int task_depth=0) const override;
+    void memory_report(MemoryReport& r, int etree_level=0) const override;
     virtual long long dense_factor_nonzeros(int task_depth=0) const override;
     virtual std::string type() const override { return "FrontalMatrixMPI"; }
     virtual bool isMPI() const override { return true; }
@@ -0,0 +1,223 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <algorithm>
+#include <numeric>
+
+#include "CoordinateReordering.hpp"
+#include "StrumpackParameters.hpp"
+#include "clustering/Clustering.hpp"
+
+namespace strumpack {
+
+  template<typename integer_t,typename real_t> class CoordOrderData {
+  public:
+    const integer_t *ptr, *ind;
+    const real_t* coords;
+    int d;
+    integer_t leaf;
+    ClusteringAlgorithm algo;
+    // part of each vertex in the current bisection, -1 for vertices
+    // which are already in a separator
+    std::vector<int> side;
+    integer_t* iperm;
+  };
+
+  /**
+   * Order the vertices in idx, these are written to
+   * cd.iperm[offset, offset+idx.size()). Returns the separator
+   * subtree, in postorder, with sep_end relative to offset.
+   *
+   * All neighbors of vertices in idx are either in idx, or in a
+   * separator of an ancestor, so cd.side can be modified by
+   * concurrent calls on disjoint subsets.
+   */
+  template<typename integer_t,typename real_t>
+  std::vector<Separator<integer_t>>
+  recursive_coordinate_ND(std::vector<integer_t>& idx, integer_t offset,
+                          CoordOrderData<integer_t,real_t>& cd, int depth) {
+    integer_t n = idx.size();
+    auto leaf = [&]() {
+      std::copy(idx.begin(), idx.end(), cd.iperm+offset);
+      return std::vector<Separator<integer_t>>(1, {n, -1, -1, -1});
+    };
+    if (n <= cd.leaf) return leaf();
+
+    // bisect the centered coordinates
+    const int d = cd.d;
+    DenseMatrix<real_t> p(d, n);
+    std::vector<real_t> mean(d, real_t(0.));
+    for (integer_t i=0; i<n; i++)
+      for (int k=0; k<d; k++)
+        mean[k] += cd.coords[std::size_t(idx[i])*d+k];
+    for (int k=0; k<d; k++) mean[k] /= n;
+    for (integer_t i=0; i<n; i++)
+      for (int k=0; k<d; k++)
+        p(k, i) = cd.coords[std::size_t(idx[i])*d+k] - mean[k];
+    std::vector<int> lp(n);
+    std::iota(lp.begin(), lp.end(), 0);
+    std::vector<std::size_t> nc(2);
+    if (cd.algo == ClusteringAlgorithm::KD_TREE)
+      kd_partition(p, nc, cd.leaf, lp.data());
+    else pca_partition(p, nc, lp.data());
+    p.clear();
+    for (integer_t i=0; i<n; i++)
+      cd.side[idx[lp[i]]] = (std::size_t(i) < nc[0]) ? 0 : 1;
+
+    // vertices with a neighbor on the other side of the cut
+    std::vector<integer_t> bnd[2];
+    for (auto v : idx) {
+      auto s = cd.side[v];
+      for (auto j=cd.ptr[v]; j<cd.ptr[v+1]; j++) {
+        auto u = cd.ind[j];
+        if (cd.side[u] == 1-s) {
+          bnd[s].push_back(v);
+          break;
+        }
+      }
+    }
+    auto& sep = (bnd[0].size() <= bnd[1].size()) ? bnd[0] : bnd[1];
+    for (auto v : sep) cd.side[v] = -1;
+    std::vector<integer_t> part[2];
+    for (auto v : idx)
+      if (cd.side[v] != -1) part[cd.side[v]].push_back(v);
+    if (part[0].empty() || part[1].empty()) {
+      for (auto v : sep) cd.side[v] = 0;
+      return leaf();
+    }
+    idx.clear();
+    idx.shrink_to_fit();
+
+    integer_t n0 = part[0].size(), n1 = part[1].size(),
+      nsep = sep.size();
+    std::copy(sep.begin(), sep.end(), cd.iperm+offset+n0+n1);
+    std::vector<Separator<integer_t>> lt, rt;
+    bool tasked = depth < params::task_recursion_cutoff_level;
+#pragma omp task default(shared) if(tasked)                             \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+    lt = recursive_coordinate_ND(part[0], offset, cd, depth+1);
+#pragma omp task default(shared) if(tasked)                             \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+    rt = recursive_coordinate_ND(part[1], offset+n0, cd, depth+1);
+#pragma omp taskwait
+
+    return combine_separator_subtrees(std::move(lt), rt, nsep);
+  }
+
+  template<typename integer_t,typename scalar_t>
+  SeparatorTree<integer_t>
+  coordinate_ND(const CompressedSparseMatrix<scalar_t,integer_t>& A,
+                const typename RealType<scalar_t>::value_type* coords,
+                int d, std::vector<integer_t>& perm,
+                std::vector<integer_t>& iperm,
+                const SPOptions<scalar_t>& opts) {
+    using real_t = typename RealType<scalar_t>::value_type;
+    integer_t n = A.size();
+    CoordOrderData<integer_t,real_t> cd;
+    cd.ptr = A.ptr();
+    cd.ind = A.ind();
+    cd.coords = coords;
+    cd.d = d;
+    cd.leaf = std::max(1, opts.nd_param());
+    cd.algo = opts.coordinate_ND_clustering();
+    cd.side.assign(n, 0);
+    cd.iperm = iperm.data();
+    std::vector<integer_t> idx(n);
+    std::iota(idx.begin(), idx.end(), 0);
+    std::vector<Separator<integer_t>> tree;
+#pragma omp parallel
+#pragma omp single
+    tree = recursive_coordinate_ND(idx, integer_t(0), cd, 0);
+    for (integer_t i=0; i<n; i++) perm[iperm[i]] = i;
+    return SeparatorTree<integer_t>(tree);
+  }
+
+  // explicit template instantiations
+  template SeparatorTree<int>
+  coordinate_ND(const CompressedSparseMatrix<float,int>& A,
+                const float* coords, int d,
+                std::vector<int>& perm, std::vector<int>& iperm,
+                const SPOptions<float>& opts);
+  template SeparatorTree<int>
+  coordinate_ND(const CompressedSparseMatrix<double,int>& A,
+                const double* coords, int d,
+                std::vector<int>& perm, std::vector<int>& iperm,
+                const SPOptions<double>& opts);
+  template SeparatorTree<int>
+  coordinate_ND(const CompressedSparseMatrix<std::complex<float>,int>& A,
+                const float* coords, int d,
+                std::vector<int>& perm, std::vector<int>& iperm,
+                const SPOptions<std::complex<float>>& opts);
+  template SeparatorTree<int>
+  coordinate_ND(const CompressedSparseMatrix<std::complex<double>,int>& A,
+                const double* coords, int d,
+                std::vector<int>& perm, std::vector<int>& iperm,
+                const SPOptions<std::complex<double>>& opts);
+
+  template SeparatorTree<long int>
+  coordinate_ND(const CompressedSparseMatrix<float,long int>& A,
+                const float* coords, int d,
+                std::vector<long int>& perm, std::vector<long int>& iperm,
+                const SPOptions<float>& opts);
+  template SeparatorTree<long int>
+  coordinate_ND(const CompressedSparseMatrix<double,long int>& A,
+                const double* coords, int d,
+                std::vector<long int>& perm, std::vector<long int>& iperm,
+                const SPOptions<double>& opts);
+  template SeparatorTree<long int>
+  coordinate_ND(const CompressedSparseMatrix<std::complex<float>,long int>& A,
+                const float* coords, int d,
+                std::vector<long int>& perm, std::vector<long int>& iperm,
+                const SPOptions<std::complex<float>>& opts);
+  template SeparatorTree<long int>
+  coordinate_ND(const CompressedSparseMatrix<std::complex<double>,long int>& A,
+                const double* coords, int d,
+                std::vector<long int>& perm, std::vector<long int>& iperm,
+                const SPOptions<std::complex<double>>& opts);
+
+  template SeparatorTree<long long int>
+  coordinate_ND(const CompressedSparseMatrix<float,long long int>& A,
+                const float* coords, int d,
+                std::vector<long long int>& perm, std::vector<long long int>& iperm,
+                const SPOptions<float>& opts);
+  template SeparatorTree<long long int>
+  coordinate_ND(const CompressedSparseMatrix<double,long long int>& A,
+                const double* coords, int d,
+                std::vector<long long int>& perm, std::vector<long long int>& iperm,
+                const SPOptions<double>& opts);
+  template SeparatorTree<long long int>
+  coordinate_ND(const CompressedSparseMatrix<std::complex<float>,long long int>& A,
+                const float* coords, int d,
+                std::vector<long long int>& perm, std::vector<long long int>& iperm,
+                const SPOptions<std::complex<float>>& opts);
+  template SeparatorTree<long long int>
+  coordinate_ND(const CompressedSparseMatrix<std::complex<double>,long long int>& A,
+                const double* coords, int d,
+                std::vector<long long int>& perm, std::vector<long long int>& iperm,
+                const SPOptions<std::complex<double>>& opts);
+
+} // end namespace strumpack
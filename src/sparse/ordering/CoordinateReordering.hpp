@@ -0,0 +1,68 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#ifndef COORDINATE_REORDERING_HPP
+#define COORDINATE_REORDERING_HPP
+
+#include <vector>
+
+#include "StrumpackOptions.hpp"
+#include "sparse/SeparatorTree.hpp"
+#include "sparse/CompressedSparseMatrix.hpp"
+
+namespace strumpack {
+
+  /**
+   * Nested dissection based on the coordinates of the unknowns, for
+   * matrices from unstructured meshes. The points are split
+   * recursively at the median, with either PCA (inertial) or kd-tree
+   * (coordinate) bisection, see
+   * SPOptions::set_coordinate_ND_clustering. The vertex separator is
+   * the set of vertices, on the side of the cut with the smallest
+   * such set, connected to a vertex on the other side. The two halves
+   * are ordered in parallel (OpenMP tasks).
+   *
+   * \param A matrix with symmetric sparsity pattern
+   * \param coords coordinates, d x A.size(), column major, point i
+   * is coords[i*d], ..., coords[i*d+d-1]
+   * \param d number of spatial dimensions
+   * \param perm output, perm[old] = new
+   * \param iperm output, iperm[new] = old
+   * \param opts uses nd_param (leaf size) and
+   * coordinate_ND_clustering
+   */
+  template<typename integer_t,typename scalar_t>
+  SeparatorTree<integer_t>
+  coordinate_ND(const CompressedSparseMatrix<scalar_t,integer_t>& A,
+                const typename RealType<scalar_t>::value_type* coords,
+                int d, std::vector<integer_t>& perm,
+                std::vector<integer_t>& iperm,
+                const SPOptions<scalar_t>& opts);
+
+} // end namespace strumpack
+
+#endif // COORDINATE_REORDERING_HPP
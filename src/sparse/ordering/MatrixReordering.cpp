@@ -30,6 +30,13 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
 
 #include "MatrixReordering.hpp"
 
@@ -55,6 +62,8 @@
 #include "RCMReordering.hpp"
 #include "ANDSparspak.hpp"
 #include "GeometricReordering.hpp"
+#include "CoordinateReordering.hpp"
+#include "ParallelNDReordering.hpp"
 #include "minimum_degree/AMDReordering.hpp"
 #include "minimum_degree/MMDReordering.hpp"
 // #include "spectral/SpectralReordering.hpp"
@@ -73,6 +82,17 @@ namespace strumpack {
   MatrixReordering<scalar_t,integer_t>::nested_dissection
   (const Opts_t& opts, const CSR_t& A,
    int nx, int ny, int nz, int components, int width) {
+    if (opts.nd_parallel_levels() > 0 &&
+        supports_parallel_ND(opts.reordering_method())) {
+      tree_ = parallel_nested_dissection(A, perm_, iperm_, opts);
+      tree_.check();
+      nested_dissection_print(opts, A.nnz(), opts.verbose());
+      if (opts.verbose())
+        std::cout << "#   - parallel nested dissection, top "
+                  << opts.nd_parallel_levels()
+                  << " levels by METIS bisection" << std::endl;
+      return 0;
+    }
     switch (opts.reordering_method()) {
     case ReorderingStrategy::NATURAL: {
       std::iota(perm_.begin(), perm_.end(), 0);
@@ -125,6 +145,11 @@ namespace strumpack {
       //   (A, perm_, iperm_, opts.ND_options());
       // break;
     }
+    case ReorderingStrategy::COORDINATE: {
+      std::cerr << "# ERROR: coordinate ordering requires the coordinates,"
+        " use reorder(coords, d)." << std::endl;
+      return 1;
+    }
     default:
       std::cerr << "# ERROR: parallel matrix reorderings are"
         " not supported from this interface, \n"
@@ -137,6 +162,20 @@ namespace strumpack {
     return 0;
   }
 
+  template<typename scalar_t,typename integer_t> int
+  MatrixReordering<scalar_t,integer_t>::nested_dissection
+  (const Opts_t& opts, const CSR_t& A, const real_t* coords, int d) {
+    if (!coords || d < 1) {
+      std::cerr << "# ERROR: invalid coordinates for the coordinate"
+        " ordering." << std::endl;
+      return 1;
+    }
+    tree_ = coordinate_ND(A, coords, d, perm_, iperm_, opts);
+    tree_.check();
+    nested_dissection_print(opts, A.nnz(), opts.verbose());
+    return 0;
+  }
+
   template<typename scalar_t,typename integer_t> int
   MatrixReordering<scalar_t,integer_t>::set_permutation
   (const Opts_t& opts, const CSR_t& A, const int* p, int base) {
@@ -150,6 +189,134 @@ namespace strumpack {
     return 0;
   }
 
+  /**
+   * 64 bit FNV-1a hash of the n elements of d. This is computed in
+   * parallel on fixed size blocks, and the block hashes are then
+   * combined in order, so the result does not depend on the number
+   * of threads.
+   */
+  template<typename T> std::uint64_t
+  hash_array(const T* d, std::size_t n, std::uint64_t h) {
+    const std::uint64_t prime = 1099511628211ULL;
+    const std::size_t B = 1 << 16;
+    std::size_t nb = (n + B - 1) / B;
+    std::vector<std::uint64_t> hb(nb);
+#pragma omp parallel for schedule(static)
+    for (std::size_t b=0; b<nb; b++) {
+      std::uint64_t hl = 14695981039346656037ULL;
+      for (std::size_t i=b*B, ie=std::min(n, (b+1)*B); i<ie; i++) {
+        std::uint64_t x = 0;
+        std::memcpy(&x, d+i, std::min(sizeof(T), sizeof(x)));
+        hl = (hl ^ x) * prime;
+      }
+      hb[b] = hl;
+    }
+    h = (h ^ std::uint64_t(n)) * prime;
+    for (auto b : hb) h = (h ^ b) * prime;
+    return h;
+  }
+
+  // change this when the cache file layout changes
+  static const int ordering_cache_version = 1;
+  static const char ordering_cache_magic[8] =
+    {'S', 'P', 'O', 'R', 'D', 'E', 'R', '\0'};
+
+  template<typename scalar_t,typename integer_t> std::string
+  MatrixReordering<scalar_t,integer_t>::cache_file
+  (const Opts_t& opts, const CSR_t& A, int nx, int ny, int nz,
+   int components, int width, const real_t* coords, int d) const {
+    std::vector<long long int> params =
+      {ordering_cache_version, (long long int)sizeof(integer_t),
+       A.size(), A.nnz(), int(opts.reordering_method()),
+       opts.nd_param(), opts.nd_planar_levels(),
+       opts.use_METIS_NodeNDP(), opts.use_MUMPS_SYMQAMD(),
+       opts.use_agg_amalg(), int(opts.coordinate_ND_clustering()),
+       opts.nd_parallel_levels(),
+       nx, ny, nz, components, width, coords ? d : 0};
+    auto h = hash_array(params.data(), params.size(),
+                        14695981039346656037ULL);
+    h = hash_array(A.ptr(), A.size()+1, h);
+    h = hash_array(A.ind(), A.nnz(), h);
+    if (coords) h = hash_array(coords, std::size_t(A.size())*d, h);
+    std::ostringstream fname;
+    fname << opts.ordering_cache() << "/strumpack_ordering_"
+          << std::hex << std::setw(16) << std::setfill('0') << h
+          << ".bin";
+    return fname.str();
+  }
+
+  template<typename scalar_t,typename integer_t> int
+  MatrixReordering<scalar_t,integer_t>::read_cache
+  (const Opts_t& opts, const CSR_t& A, const std::string& fname) {
+    std::ifstream is(fname, std::ios::in | std::ios::binary);
+    if (!is.good()) return 1;
+    char magic[8];
+    int version = 0;
+    integer_t n = 0, nnz = 0;
+    is.read(magic, sizeof(magic));
+    is.read((char*)&version, sizeof(version));
+    is.read((char*)&n, sizeof(n));
+    is.read((char*)&nnz, sizeof(nnz));
+    if (!is.good() ||
+        std::memcmp(magic, ordering_cache_magic, sizeof(magic)) ||
+        version != ordering_cache_version ||
+        n != A.size() || nnz != A.nnz())
+      return 1;
+    std::vector<integer_t> perm(n), iperm(n);
+    is.read((char*)perm.data(), sizeof(integer_t)*n);
+    is.read((char*)iperm.data(), sizeof(integer_t)*n);
+    SeparatorTree<integer_t> tree;
+    tree.read(is);
+    if (!is.good() || tree.separators() == 0 ||
+        tree.sizes[tree.separators()] != n)
+      return 1;
+    for (integer_t i=0; i<n; i++)
+      if (iperm[i] < 0 || iperm[i] >= n || perm[iperm[i]] != i)
+        return 1;
+    perm_ = std::move(perm);
+    iperm_ = std::move(iperm);
+    tree_ = std::move(tree);
+    tree_.check();
+    if (opts.verbose())
+      std::cout << "# read ordering from cache file "
+                << fname << std::endl;
+    nested_dissection_print(opts, A.nnz(), opts.verbose());
+    return 0;
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  MatrixReordering<scalar_t,integer_t>::write_cache
+  (const Opts_t& opts, const CSR_t& A, const std::string& fname) const {
+    // write to a temporary file first, and rename, so that
+    // concurrent processes never see a partially written file
+    std::ostringstream tmp;
+    tmp << fname << ".tmp" << std::hex << std::random_device{}();
+    {
+      std::ofstream os(tmp.str(), std::ios::out | std::ios::binary);
+      integer_t n = A.size(), nnz = A.nnz();
+      os.write(ordering_cache_magic, sizeof(ordering_cache_magic));
+      os.write((const char*)&ordering_cache_version,
+               sizeof(ordering_cache_version));
+      os.write((const char*)&n, sizeof(n));
+      os.write((const char*)&nnz, sizeof(nnz));
+      os.write((const char*)perm_.data(), sizeof(integer_t)*n);
+      os.write((const char*)iperm_.data(), sizeof(integer_t)*n);
+      tree_.write(os);
+      if (os.good()) {
+        os.close();
+        if (!std::rename(tmp.str().c_str(), fname.c_str())) {
+          if (opts.verbose())
+            std::cout << "# wrote ordering to cache file "
+                      << fname << std::endl;
+          return;
+        }
+      }
+    }
+    std::remove(tmp.str().c_str());
+    std::cerr << "# WARNING: could not write ordering cache file "
+              << fname << std::endl;
+  }
+
   template<typename scalar_t,typename integer_t> void
   MatrixReordering<scalar_t,integer_t>::clear_tree_data() {
     tree_ = SeparatorTree<integer_t>();
@@ -31,6 +31,7 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 
 #include "StrumpackOptions.hpp"
 #include "StrumpackConfig.hpp"
@@ -45,6 +46,7 @@ namespace strumpack {
   template<typename integer_t> class SeparatorTree;
 
   template<typename scalar_t,typename integer_t> class MatrixReordering {
+    using real_t = typename RealType<scalar_t>::value_type;
     using Opts_t = SPOptions<scalar_t>;
     using CSR_t = CSRMatrix<scalar_t,integer_t>;
     using F_t = FrontalMatrix<scalar_t,integer_t>;
@@ -58,9 +60,38 @@ namespace strumpack {
                           int nx, int ny, int nz,
                           int components, int width);
 
+    int nested_dissection(const Opts_t& opts, const CSR_t& A,
+                          const real_t* coords, int d);
+
     int set_permutation(const Opts_t& opts, const CSR_t& A,
                         const int* p, int base);
 
+    /**
+     * Name of the file, in the opts.ordering_cache() directory, for
+     * the ordering of A with the given options and geometry. The
+     * name contains a 64 bit hash of the sparsity pattern of A, the
+     * reordering options, the mesh dimensions and the coordinates (if
+     * not null).
+     */
+    std::string cache_file(const Opts_t& opts, const CSR_t& A,
+                           int nx, int ny, int nz,
+                           int components, int width,
+                           const real_t* coords, int d) const;
+
+    /**
+     * Read the permutation and separator tree from the file fname,
+     * written by write_cache. Returns nonzero if the file does not
+     * exist or does not match A.
+     */
+    int read_cache(const Opts_t& opts, const CSR_t& A,
+                   const std::string& fname);
+
+    /**
+     * Write the permutation and separator tree to the file fname.
+     */
+    void write_cache(const Opts_t& opts, const CSR_t& A,
+                     const std::string& fname) const;
+
     void separator_reordering(const Opts_t& opts, CSR_t& A, F_t* F);
 
     virtual void clear_tree_data();
@@ -124,6 +124,11 @@ namespace strumpack {
           //   (*Aseq, perm_, iperm_, opts.ND_options());
           // break;
         }
+        case ReorderingStrategy::COORDINATE: {
+          std::cerr << "# ERROR: coordinate ordering not supported"
+            " for distributed matrices." << std::endl;
+          return 1;
+        }
         default: assert(true);
         }
         Aseq.reset();
@@ -128,6 +128,25 @@ namespace strumpack {
        NULL, NULL, NULL, &edge_cut, partitioning.data());
   }
 
+  // this is used in the shared memory parallel nested dissection,
+  // part[v] is 0 or 1 for the two parts, 2 for the separator
+  template<typename integer_t> inline int WRAPPER_METIS_ComputeVertexSeparator
+  (idx_t nvtxs, integer_t* ptr, integer_t* ind, idx_t& sep_size,
+   std::vector<idx_t>& part) {
+    std::vector<idx_t> ptr_, ind_;
+    ptr_.assign(ptr, ptr+nvtxs+1);
+    ind_.assign(ind, ind+ptr[nvtxs]);
+    return METIS_ComputeVertexSeparator
+      (&nvtxs, ptr_.data(), ind_.data(), NULL, NULL,
+       &sep_size, part.data());
+  }
+  template<> inline int WRAPPER_METIS_ComputeVertexSeparator
+  (idx_t nvtxs, idx_t* ptr, idx_t* ind, idx_t& sep_size,
+   std::vector<idx_t>& part) {
+    return METIS_ComputeVertexSeparator
+      (&nvtxs, ptr, ind, NULL, NULL, &sep_size, part.data());
+  }
+
 
   template<typename integer_t> SeparatorTree<integer_t>
   sep_tree_from_metis_sizes(integer_t nodes, integer_t separators,
@@ -0,0 +1,256 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <algorithm>
+#include <numeric>
+
+#include "ParallelNDReordering.hpp"
+#include "StrumpackParameters.hpp"
+#include "sparse/CSRGraph.hpp"
+#include "MetisReordering.hpp"
+#if defined(STRUMPACK_USE_SCOTCH)
+#include "ScotchReordering.hpp"
+#endif
+#include "ANDSparspak.hpp"
+#include "minimum_degree/AMDReordering.hpp"
+#include "minimum_degree/MMDReordering.hpp"
+
+namespace strumpack {
+
+  /**
+   * Order the graph g with the sequential ordering from opts. The
+   * vertices of g have global indices gid, these are written to
+   * iperm[0, g.size()) in the new order. Returns the separator tree
+   * in postorder, with sep_end relative to the first vertex.
+   */
+  template<typename scalar_t,typename integer_t>
+  std::vector<Separator<integer_t>>
+  order_subgraph(const CSRGraph<integer_t>& g,
+                 const std::vector<integer_t>& gid, integer_t* iperm,
+                 const SPOptions<scalar_t>& opts) {
+    integer_t n = g.size();
+    std::vector<integer_t> lperm(n), liperm(n);
+    SeparatorTree<integer_t> t;
+    switch (opts.reordering_method()) {
+    case ReorderingStrategy::METIS:
+      t = metis_nested_dissection(g, lperm, liperm, opts); break;
+#if defined(STRUMPACK_USE_SCOTCH)
+    case ReorderingStrategy::SCOTCH:
+      t = scotch_nested_dissection(g, lperm, liperm, opts); break;
+#endif
+    case ReorderingStrategy::AMD:
+      t = ordering::amd_reordering(g, lperm, liperm); break;
+    case ReorderingStrategy::MMD:
+      t = ordering::mmd_reordering(g, lperm, liperm); break;
+    case ReorderingStrategy::AND:
+      t = ordering::and_reordering(g, lperm, liperm); break;
+    default:
+      std::iota(lperm.begin(), lperm.end(), 0);
+      t = build_sep_tree_from_perm(g.ptr(), g.ind(), lperm, liperm);
+    }
+    for (integer_t i=0; i<n; i++)
+      iperm[i] = gid[liperm[i]];
+    std::vector<Separator<integer_t>> seps;
+    seps.reserve(t.separators());
+    for (integer_t s=0; s<t.separators(); s++)
+      seps.emplace_back(t.sizes[s+1], t.parent[s], t.lch[s], t.rch[s]);
+    return seps;
+  }
+
+  /**
+   * Order the graph g, with global indices gid, writing the global
+   * indices in the new order to iperm[0, g.size()). If levels > 0,
+   * g is bisected, and the two parts, separated by a vertex
+   * separator, are ordered concurrently.
+   */
+  template<typename scalar_t,typename integer_t>
+  std::vector<Separator<integer_t>>
+  recursive_parallel_ND(CSRGraph<integer_t>&& g,
+                        std::vector<integer_t>&& gid, integer_t* iperm,
+                        int levels, const SPOptions<scalar_t>& opts,
+                        int depth) {
+    integer_t n = g.size();
+    if (levels == 0 || n < 2 || n <= 2 * opts.nd_param())
+      return order_subgraph(g, gid, iperm, opts);
+
+    std::vector<idx_t> side(n);
+    idx_t sep_size = 0;
+    int ierr = WRAPPER_METIS_ComputeVertexSeparator
+      (idx_t(n), g.ptr(), g.ind(), sep_size, side);
+    if (ierr != METIS_OK)
+      return order_subgraph(g, gid, iperm, opts);
+    std::vector<integer_t> sep;
+    sep.reserve(sep_size);
+    for (integer_t v=0; v<n; v++)
+      if (side[v] == 2) {
+        sep.push_back(v);
+        side[v] = -1;
+      }
+    // local index in the part, for vertices not in the separator
+    std::vector<integer_t> lid(n);
+    integer_t np[2] = {0, 0};
+    for (integer_t v=0; v<n; v++)
+      if (side[v] != -1) lid[v] = np[side[v]]++;
+    if (!np[0] || !np[1])
+      return order_subgraph(g, gid, iperm, opts);
+
+    // extract the two subgraphs, dropping the edges to the separator
+    CSRGraph<integer_t> gp[2];
+    std::vector<integer_t> gidp[2];
+    for (int p=0; p<2; p++) {
+      std::vector<integer_t> ptr(np[p]+1), ind;
+      gidp[p].resize(np[p]);
+      ptr[0] = 0;
+      for (integer_t v=0; v<n; v++) {
+        if (side[v] != p) continue;
+        for (auto j=g.ptr(v); j<g.ptr(v+1); j++) {
+          auto u = g.ind(j);
+          if (side[u] == p) ind.push_back(lid[u]);
+        }
+        gidp[p][lid[v]] = gid[v];
+        ptr[lid[v]+1] = ind.size();
+      }
+      gp[p] = CSRGraph<integer_t>(std::move(ptr), std::move(ind));
+    }
+    integer_t nsep = sep.size();
+    for (integer_t i=0; i<nsep; i++)
+      iperm[np[0]+np[1]+i] = gid[sep[i]];
+    g = CSRGraph<integer_t>();
+    gid.clear();
+    gid.shrink_to_fit();
+
+    std::vector<Separator<integer_t>> lt, rt;
+    bool tasked = depth < params::task_recursion_cutoff_level;
+#pragma omp task default(shared) if(tasked)                             \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+    lt = recursive_parallel_ND
+      (std::move(gp[0]), std::move(gidp[0]), iperm,
+       levels-1, opts, depth+1);
+#pragma omp task default(shared) if(tasked)                             \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+    rt = recursive_parallel_ND
+      (std::move(gp[1]), std::move(gidp[1]), iperm+np[0],
+       levels-1, opts, depth+1);
+#pragma omp taskwait
+    return combine_separator_subtrees(std::move(lt), rt, nsep);
+  }
+
+  template<typename integer_t,typename scalar_t>
+  SeparatorTree<integer_t>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<scalar_t,integer_t>& A,
+   std::vector<integer_t>& perm, std::vector<integer_t>& iperm,
+   const SPOptions<scalar_t>& opts) {
+    integer_t n = A.size();
+    auto Aptr = A.ptr();
+    auto Aind = A.ind();
+    // graph without the diagonal
+    std::vector<integer_t> ptr(n+1), ind;
+    ind.reserve(Aptr[n]);
+    for (integer_t i=0; i<n; i++) {
+      for (auto j=Aptr[i]; j<Aptr[i+1]; j++)
+        if (Aind[j] != i) ind.push_back(Aind[j]);
+      ptr[i+1] = ind.size();
+    }
+    CSRGraph<integer_t> g(std::move(ptr), std::move(ind));
+    std::vector<integer_t> gid(n);
+    std::iota(gid.begin(), gid.end(), 0);
+    std::vector<Separator<integer_t>> tree;
+#pragma omp parallel
+#pragma omp single
+    tree = recursive_parallel_ND
+      (std::move(g), std::move(gid), iperm.data(),
+       opts.nd_parallel_levels(), opts, 0);
+    for (integer_t i=0; i<n; i++) perm[iperm[i]] = i;
+    return SeparatorTree<integer_t>(tree);
+  }
+
+  // explicit template instantiations
+  template SeparatorTree<int>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<float,int>& A,
+   std::vector<int>& perm, std::vector<int>& iperm,
+   const SPOptions<float>& opts);
+  template SeparatorTree<int>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<double,int>& A,
+   std::vector<int>& perm, std::vector<int>& iperm,
+   const SPOptions<double>& opts);
+  template SeparatorTree<int>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<std::complex<float>,int>& A,
+   std::vector<int>& perm, std::vector<int>& iperm,
+   const SPOptions<std::complex<float>>& opts);
+  template SeparatorTree<int>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<std::complex<double>,int>& A,
+   std::vector<int>& perm, std::vector<int>& iperm,
+   const SPOptions<std::complex<double>>& opts);
+
+  template SeparatorTree<long int>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<float,long int>& A,
+   std::vector<long int>& perm, std::vector<long int>& iperm,
+   const SPOptions<float>& opts);
+  template SeparatorTree<long int>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<double,long int>& A,
+   std::vector<long int>& perm, std::vector<long int>& iperm,
+   const SPOptions<double>& opts);
+  template SeparatorTree<long int>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<std::complex<float>,long int>& A,
+   std::vector<long int>& perm, std::vector<long int>& iperm,
+   const SPOptions<std::complex<float>>& opts);
+  template SeparatorTree<long int>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<std::complex<double>,long int>& A,
+   std::vector<long int>& perm, std::vector<long int>& iperm,
+   const SPOptions<std::complex<double>>& opts);
+
+  template SeparatorTree<long long int>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<float,long long int>& A,
+   std::vector<long long int>& perm, std::vector<long long int>& iperm,
+   const SPOptions<float>& opts);
+  template SeparatorTree<long long int>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<double,long long int>& A,
+   std::vector<long long int>& perm, std::vector<long long int>& iperm,
+   const SPOptions<double>& opts);
+  template SeparatorTree<long long int>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<std::complex<float>,long long int>& A,
+   std::vector<long long int>& perm, std::vector<long long int>& iperm,
+   const SPOptions<std::complex<float>>& opts);
+  template SeparatorTree<long long int>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<std::complex<double>,long long int>& A,
+   std::vector<long long int>& perm, std::vector<long long int>& iperm,
+   const SPOptions<std::complex<double>>& opts);
+
+} // end namespace strumpack
@@ -0,0 +1,77 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#ifndef PARALLEL_ND_REORDERING_HPP
+#define PARALLEL_ND_REORDERING_HPP
+
+#include <vector>
+
+#include "StrumpackOptions.hpp"
+#include "sparse/SeparatorTree.hpp"
+#include "sparse/CompressedSparseMatrix.hpp"
+
+namespace strumpack {
+
+  /**
+   * Can the ordering method be used for the subgraphs in
+   * parallel_nested_dissection?
+   */
+  inline bool supports_parallel_ND(ReorderingStrategy method) {
+    switch (method) {
+    case ReorderingStrategy::METIS:
+    case ReorderingStrategy::SCOTCH:
+    case ReorderingStrategy::AMD:
+    case ReorderingStrategy::MMD:
+    case ReorderingStrategy::AND: return true;
+    default: return false;
+    }
+  }
+
+  /**
+   * Shared memory parallel nested dissection. The top
+   * opts.nd_parallel_levels() levels of separators are computed
+   * with METIS_ComputeVertexSeparator, the multilevel vertex
+   * bisection also used by METIS_NodeND. The remaining
+   * disjoint subgraphs are ordered concurrently, in OpenMP tasks,
+   * with opts.reordering_method() (see supports_parallel_ND), and
+   * the resulting separator trees are combined.
+   *
+   * \param A matrix with symmetric sparsity pattern
+   * \param perm output, perm[old] = new
+   * \param iperm output, iperm[new] = old
+   * \param opts reordering options
+   */
+  template<typename integer_t,typename scalar_t>
+  SeparatorTree<integer_t>
+  parallel_nested_dissection
+  (const CompressedSparseMatrix<scalar_t,integer_t>& A,
+   std::vector<integer_t>& perm, std::vector<integer_t>& iperm,
+   const SPOptions<scalar_t>& opts);
+
+} // end namespace strumpack
+
+#endif // PARALLEL_ND_REORDERING_HPP
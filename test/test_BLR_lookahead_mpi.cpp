@@ -0,0 +1,138 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "BLR/BLRMatrixMPI.hpp"
+
+using namespace std;
+using namespace strumpack;
+using namespace strumpack::BLR;
+
+
+/*
+ * Factor the same matrices with the right-looking BLRMatrixMPI
+ * factorization, with and without look-ahead. The look-ahead only
+ * changes the order in which the trailing tiles are updated, each
+ * tile receives the same updates in the same order, so the factors
+ * and pivots should be identical.
+ */
+template<typename scalar_t> BLRMatrixMPI<scalar_t>
+make_matrix(const ProcessorGrid2D& g, const vector<size_t>& Rt,
+            const vector<size_t>& Ct, size_t r0, size_t c0) {
+  BLRMatrixMPI<scalar_t> A(g, Rt, Ct);
+  A.fill(scalar_t(0.));
+  for (size_t j=0; j<A.lcols(); j++)
+    for (size_t i=0; i<A.lrows(); i++) {
+      auto gi = r0 + A.rl2g(i), gj = c0 + A.cl2g(j);
+      // Toeplitz, not diagonally dominant to force pivoting
+      A(i, j) = scalar_t(1. / (1. + std::abs(double(gi) - double(gj))))
+        + scalar_t((gi * 7 + gj * 3) % 5 == 0 ? 2. : 0.);
+    }
+  return A;
+}
+
+template<typename scalar_t> long long
+difference(BLRMatrixMPI<scalar_t>& A, BLRMatrixMPI<scalar_t>& B) {
+  long long d = 0;
+  if (!A.active() || !A.lcols()) return d;
+  A.decompress_local_columns(0, A.lcols());
+  B.decompress_local_columns(0, B.lcols());
+  for (size_t j=0; j<A.lcols(); j++)
+    for (size_t i=0; i<A.lrows(); i++)
+      if (A(i, j) != B(i, j)) d++;
+  return d;
+}
+
+template<typename scalar_t> int
+test_lookahead(const MPIComm& c, int n1, int n2, int nb,
+               BLROptions<scalar_t> opts) {
+  ProcessorGrid2D g(c);
+  auto tiles = [nb](int n) {
+    vector<size_t> t(n / nb, nb);
+    if (n % nb) t.push_back(n % nb);
+    return t;
+  };
+  auto T1 = tiles(n1), T2 = tiles(n2);
+  DenseMatrix<bool> adm(T1.size(), T1.size());
+  adm.fill(true);
+  for (size_t i=0; i<T1.size(); i++) adm(i, i) = false;
+  opts.set_BLR_factor_algorithm(BLRFactorAlgorithm::RL);
+  auto opts_la = opts;
+  opts.set_lookahead(false);
+  opts_la.set_lookahead(true);
+
+  // single matrix
+  auto A = make_matrix<scalar_t>(g, T1, T1, 0, 0),
+    B = make_matrix<scalar_t>(g, T1, T1, 0, 0);
+  auto pA = A.factor(adm, opts), pB = B.factor(adm, opts_la);
+  long long err = difference(A, B) + (pA != pB);
+
+  // partial factorization of [A11 A12; A21 A22]
+  auto A11 = make_matrix<scalar_t>(g, T1, T1, 0, 0),
+    A12 = make_matrix<scalar_t>(g, T1, T2, 0, n1),
+    A21 = make_matrix<scalar_t>(g, T2, T1, n1, 0),
+    A22 = make_matrix<scalar_t>(g, T2, T2, n1, n1);
+  auto B11 = make_matrix<scalar_t>(g, T1, T1, 0, 0),
+    B12 = make_matrix<scalar_t>(g, T1, T2, 0, n1),
+    B21 = make_matrix<scalar_t>(g, T2, T1, n1, 0),
+    B22 = make_matrix<scalar_t>(g, T2, T2, n1, n1);
+  pA = BLRMatrixMPI<scalar_t>::partial_factor(A11, A12, A21, A22, adm, opts);
+  pB = BLRMatrixMPI<scalar_t>::partial_factor
+    (B11, B12, B21, B22, adm, opts_la);
+  err += difference(A11, B11) + difference(A12, B12) +
+    difference(A21, B21) + difference(A22, B22) + (pA != pB);
+  err = c.all_reduce(err, MPI_SUM);
+  if (c.is_root())
+    cout << "# " << g.nprows() << "x" << g.npcols() << " grid, n1 = "
+         << n1 << ", n2 = " << n2 << ", tile size " << nb << ": "
+         << err << " differences with look-ahead" << endl;
+  return err ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+  MPI_Init(&argc, &argv);
+  int ierr = 0;
+  {
+    MPIComm c;
+    BLROptions<double> opts;
+    opts.set_verbose(false);
+    opts.set_from_command_line(argc, argv);
+    BLROptions<std::complex<float>> zopts;
+    zopts.set_verbose(false);
+    zopts.set_rel_tol(1e-3);
+    ierr |= test_lookahead<double>(c, 500, 200, opts.leaf_size(), opts);
+    ierr |= test_lookahead<double>(c, 137, 61, 16, opts);
+    ierr |= test_lookahead<double>(c, 32, 10, 16, opts);
+    ierr |= test_lookahead<std::complex<float>>(c, 150, 50, 24, zopts);
+    if (c.is_root() && ierr)
+      cout << "ERROR: look-ahead changed the BLR factors" << endl;
+  }
+  MPI_Finalize();
+  return ierr;
+}
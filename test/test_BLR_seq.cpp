@@ -28,10 +28,12 @@
  */
 #include <iostream>
 #include <random>
+#include <complex>
 using namespace std;
 
 #include "dense/DenseMatrix.hpp"
 #include "BLR/BLRMatrix.hpp"
+#include "BLR/LRTile.hpp"
 #include "structured/ClusterTree.hpp"
 #include "misc/TaskTimer.hpp"
 using namespace strumpack;
@@ -41,6 +43,43 @@ using namespace strumpack::BLR;
 #define SOLVE_TOLERANCE 1e-12
 
 
+/*
+ * Compress a complex, non-Hermitian, low-rank block with BACA, and
+ * check the error of the approximation. The low-rank interpolative
+ * decomposition in BACA needs Q^H (not Q^T) for complex scalars.
+ */
+int test_complex_BACA(const BLROptions<double>& blr_opts) {
+  using scalar_t = complex<double>;
+  int m = 200, n = 150;
+  DenseMatrix<scalar_t> T(m, n);
+  for (int j=0; j<n; j++)
+    for (int i=0; i<m; i++) {
+      double x = double(i) / m, y = 2. + double(j) / n;
+      T(i,j) = polar(1. / (y - x), 3. * x - 2. * y);
+    }
+  BLROptions<scalar_t> opts;
+  opts.set_rel_tol(blr_opts.rel_tol());
+  opts.set_abs_tol(blr_opts.abs_tol());
+  opts.set_BACA_blocksize(blr_opts.BACA_blocksize());
+  LRTile<scalar_t> lr
+    (m, n, [&](const vector<size_t>& I, DenseMatrix<scalar_t>& R) {
+      T.extract_rows(I, R); },
+      [&](const vector<size_t>& J, DenseMatrix<scalar_t>& C) {
+        T.extract_cols(J, C); }, opts);
+  auto Tnorm = T.normF();
+  T.scaled_add(scalar_t(-1.), lr.dense());
+  auto err = T.normF() / Tnorm;
+  cout << "# complex BACA rank = " << lr.rank()
+       << ", relative error = " << err << endl;
+  if (!(err < ERROR_TOLERANCE
+        * max(blr_opts.rel_tol(), blr_opts.abs_tol()))) {
+    cout << "ERROR: complex BACA compression error too big!!" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+
 int run(int argc, char* argv[]) {
   int m = 100; //, n = 1;
 
@@ -193,6 +232,7 @@ int run(int argc, char* argv[]) {
     return 1;
   }
 
+  if (test_complex_BACA(blr_opts)) return 1;
 
   cout << "# exiting" << endl;
   return 0;
@@ -0,0 +1,162 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <algorithm>
+using namespace std;
+
+#include "StrumpackSparseSolver.hpp"
+#include "StrumpackSparseSolverBatched.hpp"
+#include "sparse/CSRMatrix.hpp"
+#include "misc/RandomWrapper.hpp"
+
+using namespace strumpack;
+
+#define ERROR_TOLERANCE 1e2
+
+/**
+ * Factor a batch of systems with the pattern of A, with different
+ * values for each system, and check the solutions against a
+ * SparseSolver per system. One system is all zero, it should be
+ * reported as a zero pivot, without affecting the other systems.
+ */
+template<typename scalar_t,typename integer_t> int
+test_batched(int argc, const char* const argv[],
+             const CSRMatrix<scalar_t,integer_t>& A) {
+  using real_t = typename RealType<scalar_t>::value_type;
+  const int batch = 6, zero = 3;
+  const integer_t N = A.size(), nnz = A.nnz();
+  auto rgen = random::make_default_random_generator<real_t>();
+  vector<scalar_t> val(size_t(batch)*nnz), b(size_t(batch)*N),
+    x(size_t(batch)*N);
+  for (int s=0; s<batch; s++) {
+    auto v = &val[size_t(s)*nnz];
+    if (s == zero) continue;
+    for (integer_t i=0; i<N; i++)
+      for (integer_t k=A.ptr()[i]; k<A.ptr()[i+1]; k++)
+        v[k] = A.val()[k] * scalar_t
+          (A.ind()[k] == i ? real_t(1. + s) : real_t(1.) + rgen->get() / 4);
+  }
+  for (auto& bi : b) bi = rgen->get();
+
+  SparseSolverBatched<scalar_t,integer_t> bs(false);
+  bs.options().set_from_command_line(argc, argv);
+  bs.set_pattern(A);
+  if (bs.reorder() != ReturnCode::SUCCESS) {
+    cout << "problem with reordering of the pattern." << endl;
+    return 1;
+  }
+  vector<ReturnCode> info;
+  auto ierr = bs.factor(batch, val.data(), info);
+  if (ierr != ReturnCode::ZERO_PIVOT || int(info.size()) != batch ||
+      bs.batch() != batch) {
+    cout << "BATCHED FACTOR DID NOT REPORT THE ZERO PIVOT!" << endl;
+    return 1;
+  }
+  for (int s=0; s<batch; s++)
+    if ((s == zero) != (info[s] == ReturnCode::ZERO_PIVOT) ||
+        (s != zero && info[s] != ReturnCode::SUCCESS)) {
+      cout << "WRONG RETURN CODE " << info[s] << " FOR SYSTEM "
+           << s << "!" << endl;
+      return 1;
+    }
+  bs.solve(b.data(), x.data(), info);
+
+  vector<scalar_t> xs(N), xr(N);
+  for (int s=0; s<batch; s++) {
+    if (s == zero) continue;
+    auto bi = &b[size_t(s)*N];
+    auto xi = &x[size_t(s)*N];
+    CSRMatrix<scalar_t,integer_t> As
+      (N, A.ptr(), A.ind(), &val[size_t(s)*nnz], A.symm_sparse());
+    auto res = As.max_scaled_residual(xi, bi);
+    // a single system, from the same factors
+    bs.solve(s, bi, xs.data());
+    // a separate solver for this system
+    SparseSolver<scalar_t,integer_t> spss(false);
+    spss.options().set_from_command_line(argc, argv);
+    spss.set_matrix(As);
+    spss.solve(bi, xr.data());
+    real_t dsingle = 0;
+    for (integer_t i=0; i<N; i++)
+      dsingle = std::max(dsingle, std::abs(xs[i] - xi[i]));
+    blas::axpy(N, scalar_t(-1.), xi, 1, xr.data(), 1);
+    auto diff = blas::nrm2(N, xr.data(), 1) / blas::nrm2(N, xi, 1);
+    cout << "# SYSTEM " << s << ": COMPONENTWISE SCALED RESIDUAL = "
+         << res << ", DIFFERENCE WITH SparseSolver = " << diff << endl;
+    if (res > ERROR_TOLERANCE*bs.options().rel_tol() ||
+        diff > ERROR_TOLERANCE*bs.options().rel_tol()) {
+      cout << "BATCHED SOLUTION IS NOT ACCURATE!" << endl;
+      return 1;
+    }
+    if (dsingle != real_t(0.)) {
+      cout << "SOLVE WITH A SINGLE SYSTEM DIFFERS FROM THE BATCH!" << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+template<typename real_t,typename integer_t>
+int read_matrix_and_run_tests(int argc, const char* const argv[]) {
+  CSRMatrix<real_t,integer_t> A;
+  if (A.read_matrix_market(argv[1])) {
+    std::cerr << "Could not read matrix from file." << std::endl;
+    return 1;
+  }
+  if (test_batched(argc, argv, A)) return 1;
+  // the same systems in complex arithmetic
+  CSRMatrix<complex<real_t>,integer_t> Ac
+    (A.size(), A.ptr(), A.ind(), nullptr, A.symm_sparse());
+  for (integer_t k=0; k<A.nnz(); k++)
+    Ac.val()[k] = complex<real_t>(A.val()[k], A.val()[k] / 2);
+  return test_batched(argc, argv, Ac);
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    cout
+      << "Solve a batch of linear systems with the sparsity pattern of\n"
+      << "a matrix given in matrix market format, using the batched\n"
+      << "sparse solver.\n\n"
+      << "Usage: \n\t./test_batched_seq pde900.mtx" << endl;
+    return 1;
+  }
+  cout << "# Running with:\n# ";
+#if defined(_OPENMP)
+  cout << "OMP_NUM_THREADS=" << omp_get_max_threads() << " ";
+#endif
+  for (int i=0; i<argc; i++)
+    cout << argv[i] << " ";
+  cout << endl;
+
+  int ierr = read_matrix_and_run_tests<double,int>(argc, argv);
+  if (ierr) return ierr;
+  return read_matrix_and_run_tests<double,long long int>(argc, argv);
+}
@@ -0,0 +1,111 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <iostream>
+#include <complex>
+using namespace std;
+
+#include "StrumpackOptions.hpp"
+#include "sparse/fronts/FrontCostModel.hpp"
+
+using namespace strumpack;
+
+
+/*
+ * Check the choices made by the front cost model used for
+ * --sp_compression auto: fronts that fit in a single BLR tile stay
+ * dense, very large fronts are compressed, the selection does not
+ * flip back to dense when a front grows, and under a memory budget
+ * the representation with the smallest footprint is selected.
+ */
+template<typename scalar_t> int test_cost_model() {
+  const auto& model = FrontCostModel<scalar_t>::instance();
+  SPOptions<scalar_t> opts;
+  opts.set_verbose(false);
+  const int b = opts.BLR_options().leaf_size();
+  double mem = 0.;
+  if (model.select(b/2, 4*b, opts, mem) != CompressionType::NONE) {
+    cout << "ERROR: front smaller than a BLR tile was compressed" << endl;
+    return 1;
+  }
+  if (model.select(b, 0, opts, mem) != CompressionType::NONE) {
+    cout << "ERROR: single tile front was compressed" << endl;
+    return 1;
+  }
+  if (model.select(20000, 10000, opts, mem) != CompressionType::BLR) {
+    cout << "ERROR: very large front was not compressed" << endl;
+    return 1;
+  }
+  bool blr = false;
+  for (int n=b; n<=40000; n*=2) {
+    bool s = model.select(n, n/2, opts, mem) == CompressionType::BLR;
+    if (blr && !s) {
+      cout << "ERROR: selection switched back to dense at dsep="
+           << n << endl;
+      return 1;
+    }
+    blr = s;
+  }
+  // over the memory budget: pick the smallest representation
+  const int n = 2*b;
+  mem = 0.;
+  auto ct_t = model.select(n, n, opts, mem);
+  opts.set_auto_compression_memory_budget(1.);
+  double mem_d, mem_b;
+  model.dense(n, n, mem_d);
+  model.BLR(n, n, b, std::max
+            (1., double(opts.auto_compression_rank_ratio()) * b), mem_b);
+  mem = 1e12;
+  auto ct = model.select(n, n, opts, mem);
+  if ((mem_b < mem_d) != (ct == CompressionType::BLR)) {
+    cout << "ERROR: memory budget did not select the smallest front"
+         << endl;
+    return 1;
+  }
+  if (ct == CompressionType::BLR && mem != 1e12 - (mem_d - mem_b)) {
+    cout << "ERROR: memory estimate not updated" << endl;
+    return 1;
+  }
+  // within the budget the choice only depends on the run time
+  opts.set_auto_compression_memory_budget(1e15);
+  mem = 0.;
+  if (model.select(n, n, opts, mem) != ct_t) {
+    cout << "ERROR: memory budget changed the selection" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  int ierr = 0;
+  ierr |= test_cost_model<double>();
+  ierr |= test_cost_model<float>();
+  ierr |= test_cost_model<std::complex<double>>();
+  ierr |= test_cost_model<std::complex<float>>();
+  if (!ierr) cout << "# front cost model tests passed" << endl;
+  return ierr;
+}
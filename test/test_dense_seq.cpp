@@ -0,0 +1,280 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <algorithm>
+using namespace std;
+
+#include "dense/DenseMatrix.hpp"
+#include "dense/BLASLAPACKOpenMPTask.hpp"
+#include "HODLR/HODLRMatrixNative.hpp"
+#include "misc/RandomWrapper.hpp"
+
+using namespace strumpack;
+
+#define ERROR_TOLERANCE 1e2
+
+
+/*
+ * Factor a random front [F11 F12; F21 F22] with the tiled, task
+ * based partial LU, and compare with getrf on F11, followed by the
+ * row interchanges and triangular solves for F12 and F21, and the
+ * Schur complement update of F22.
+ */
+template<typename scalar_t> int
+test_tiled_LU(int n1, int n2, int nb, int zero_col) {
+  using real_t = typename RealType<scalar_t>::value_type;
+  const int n = n1 + n2;
+  DenseMatrix<scalar_t> F(n, n);
+  auto rgen = random::make_default_random_generator<real_t>();
+  F.random(*rgen);
+  if (zero_col >= 0)
+    for (int i=0; i<n; i++) F(i, zero_col) = scalar_t(0.);
+  DenseMatrix<scalar_t> G(F);
+  std::vector<int> piv(n1), piv_ref(n1);
+
+  // reference
+  int info_ref = blas::getrf(n1, n1, G.data(), G.ld(), piv_ref.data());
+  blas::laswp(n2, G.ptr(0, n1), G.ld(), 1, n1, piv_ref.data(), 1);
+  blas::trsm('L', 'L', 'N', 'U', n1, n2, scalar_t(1.), G.data(), G.ld(),
+             G.ptr(0, n1), G.ld());
+  blas::trsm('R', 'U', 'N', 'N', n2, n1, scalar_t(1.), G.data(), G.ld(),
+             G.ptr(n1, 0), G.ld());
+  blas::gemm('N', 'N', n2, n2, n1, scalar_t(-1.), G.ptr(n1, 0), G.ld(),
+             G.ptr(0, n1), G.ld(), scalar_t(1.), G.ptr(n1, n1), G.ld());
+
+  int info = 0;
+#pragma omp parallel
+#pragma omp single nowait
+  info = getrf_tiled_omp_task
+    (n1, n2, F.data(), F.ld(), F.ptr(0, n1), F.ld(), F.ptr(n1, 0), F.ld(),
+     F.ptr(n1, n1), F.ld(), piv.data(), nb, real_t(0.));
+
+  cout << "# n1 = " << n1 << ", n2 = " << n2 << ", nb = " << nb
+       << ", info = " << info << " (getrf " << info_ref << ")";
+  if ((info == 0) != (info_ref == 0)) {
+    cout << endl << "ERROR: tiled LU did not detect the zero pivot" << endl;
+    return 1;
+  }
+  if (info) {
+    // the factors are not unique after a zero pivot
+    cout << endl;
+    return 0;
+  }
+  if (piv != piv_ref) {
+    cout << endl << "ERROR: tiled LU pivots differ from getrf" << endl;
+    return 1;
+  }
+  auto nrm = G.normF();
+  G.scaled_add(scalar_t(-1.), F);
+  auto err = G.normF() / nrm;
+  cout << ", relative difference = " << err << endl;
+  if (err > ERROR_TOLERANCE * n * blas::lamch<real_t>('E')) {
+    cout << "ERROR: tiled LU differs from getrf" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+/*
+ * Compress a smooth kernel matrix as a HODLRMatrixNative, and
+ * compare the solve with a dense LU. Then check that a zero pivot
+ * is reported, for a zero pivot in a leaf, also when tiny pivots are
+ * replaced, and for a singular K = I + [0 V12; V21 0] W, with
+ * nonsingular diagonal blocks.
+ */
+template<typename scalar_t> int test_HODLR_native(int n) {
+  using real_t = typename RealType<scalar_t>::value_type;
+  HODLR::HODLROptions<scalar_t> opts;
+  opts.set_rel_tol
+    (std::max(real_t(1e-10), real_t(10.) * blas::lamch<real_t>('E')));
+  opts.set_abs_tol(1e-14);
+  opts.set_leaf_size(16);
+  structured::ClusterTree t(n);
+  t.refine(opts.leaf_size());
+  DenseMatrix<scalar_t> A(n, n), B(n, 2), X(n, 2);
+  for (int j=0; j<n; j++)
+    for (int i=0; i<n; i++)
+      A(i, j) = (i == j) ? scalar_t(n) : scalar_t(1. / (1 + std::abs(i-j)));
+  auto rgen = random::make_default_random_generator<real_t>();
+  B.random(*rgen);
+  X.copy(B);
+  int info = 0;
+  {
+    HODLR::HODLRMatrixNative<scalar_t> H(t, A, opts);
+    info = H.factor(real_t(0.), 0);
+    H.solve(X);
+  }
+  DenseMatrix<scalar_t> LU(A);
+  auto piv = LU.LU();
+  auto Xd = LU.solve(B, piv);
+  Xd.scaled_add(scalar_t(-1.), X);
+  auto err = Xd.normF() / X.normF();
+  cout << "# HODLR native n = " << n << ", info = " << info
+       << ", relative difference with dense LU = " << err << endl;
+  if (info || err > ERROR_TOLERANCE * opts.rel_tol()) {
+    cout << "ERROR: HODLR native solve is not accurate" << endl;
+    return 1;
+  }
+  // zero row and column in the first leaf
+  for (int i=0; i<n; i++) A(i, 0) = A(0, i) = scalar_t(0.);
+  for (real_t thresh : {real_t(0.), real_t(1e-8)}) {
+    HODLR::HODLRMatrixNative<scalar_t> H(t, A, opts);
+    if (!H.factor(thresh, 0)) {
+      cout << "ERROR: HODLR native did not report the zero pivot in "
+           << "a leaf, with threshold " << thresh << endl;
+      return 1;
+    }
+  }
+  // A = [I e1*e1^T; e1*e1^T I] is singular, only K is
+  const int m = opts.leaf_size();
+  structured::ClusterTree t2(2*m);
+  t2.refine(m);
+  DenseMatrix<scalar_t> S(2*m, 2*m);
+  S.eye();
+  S(0, m) = S(m, 0) = scalar_t(1.);
+  HODLR::HODLRMatrixNative<scalar_t> H(t2, S, opts);
+  if (!H.factor(real_t(0.), 0)) {
+    cout << "ERROR: HODLR native did not report the zero pivot in K"
+         << endl;
+    return 1;
+  }
+  return 0;
+}
+
+/*
+ * The Philox generator computes element (i,j) of a block from its
+ * coordinates: a parallel fill (of a submatrix with an arbitrary
+ * leading dimension) gives the same numbers as element wise
+ * generation, consecutive blocks and different seeds differ, and
+ * the numbers follow the requested distribution.
+ */
+template<typename real_t> int
+test_philox(int m, int n, random::RandomDistribution d) {
+  using namespace random;
+  PhiloxGenerator<real_t> g(1234, d), h(1234, d), g2(4321, d);
+  const int ld = m + 3;
+  std::vector<real_t> A(ld*n, real_t(-7.)), B(ld*n);
+  g.fill(m, n, A.data(), ld);
+  for (int j=0; j<n; j++)
+    for (int i=0; i<m; i++)
+      B[i+j*ld] = h.get(i, j);
+  int diff = 0, same = 0;
+  for (int j=0; j<n; j++) {
+    for (int i=0; i<m; i++)
+      if (A[i+j*ld] != B[i+j*ld]) diff++;
+    for (int i=m; i<ld; i++)
+      if (A[i+j*ld] != real_t(-7.)) diff++;
+  }
+  // get() runs over a row, starting from the position set by seed(i,j)
+  h.seed(3, 5);
+  for (int j=5; j<n; j++)
+    if (h.get() != B[3+j*ld]) diff++;
+  if (diff) {
+    cout << "ERROR: Philox fill differs from element wise generation"
+         << endl;
+    return 1;
+  }
+  // fill moved g on to the next block
+  std::vector<real_t> C(ld*n), D(ld*n);
+  g.fill(m, n, C.data(), ld);
+  g2.fill(m, n, D.data(), ld);
+  double sum = 0., sum2 = 0.;
+  real_t lo = A[0], hi = A[0];
+  for (int j=0; j<n; j++)
+    for (int i=0; i<m; i++) {
+      auto a = A[i+j*ld];
+      if (a == C[i+j*ld] || a == D[i+j*ld]) same++;
+      sum += a;
+      sum2 += double(a) * a;
+      lo = std::min(lo, a);
+      hi = std::max(hi, a);
+    }
+  if (same > m*n/1000) {
+    cout << "ERROR: Philox blocks or seeds repeat numbers" << endl;
+    return 1;
+  }
+  double N = double(m) * n, mean = sum / N, var = sum2 / N - mean*mean;
+  cout << "# Philox " << get_name(d) << ", " << m << "x" << n
+       << ": mean = " << mean << ", variance = " << var << endl;
+  double emean = 0., evar = 1.;
+  if (d == RandomDistribution::UNIFORM) {
+    emean = .5;
+    evar = 1. / 12.;
+    if (lo < real_t(0.) || hi > real_t(1.)) {
+      cout << "ERROR: uniform numbers outside [0,1]" << endl;
+      return 1;
+    }
+  }
+  if (std::abs(mean - emean) > 5. * std::sqrt(evar / N) ||
+      std::abs(var - evar) > .05 * evar) {
+    cout << "ERROR: wrong mean or variance" << endl;
+    return 1;
+  }
+  // DenseMatrix::random uses fill, also with a parallel fill
+  DenseMatrix<real_t> R(m, n);
+  PhiloxGenerator<real_t> r(1234, d);
+  R.random(r);
+  for (int j=0; j<n; j++)
+    for (int i=0; i<m; i++)
+      if (R(i, j) != A[i+j*ld]) diff++;
+  if (diff) {
+    cout << "ERROR: DenseMatrix::random differs from the Philox fill"
+         << endl;
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  cout << "# Running with:\n# ";
+#if defined(_OPENMP)
+  cout << "OMP_NUM_THREADS=" << omp_get_max_threads() << " ";
+#endif
+  for (int i=0; i<argc; i++) cout << argv[i] << " ";
+  cout << endl;
+
+  int ierr = 0;
+  // tile sizes that do and do not divide n1 and n2, and a single tile
+  for (int nb : {16, 37, 64, 1000}) {
+    ierr += test_tiled_LU<double>(300, 200, nb, -1);
+    ierr += test_tiled_LU<complex<float>>(150, 70, nb, -1);
+  }
+  ierr += test_tiled_LU<double>(200, 100, 32, 70);
+  ierr += test_tiled_LU<double>(200, 0, 32, -1);
+  ierr += test_HODLR_native<double>(500);
+  ierr += test_HODLR_native<complex<float>>(200);
+  for (auto d : {random::RandomDistribution::NORMAL,
+        random::RandomDistribution::UNIFORM}) {
+    ierr += test_philox<double>(500, 300, d);
+    ierr += test_philox<float>(77, 131, d);
+  }
+  return ierr ? 1 : 0;
+}
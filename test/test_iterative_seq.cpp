@@ -0,0 +1,98 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <iostream>
+#include <vector>
+#include <cmath>
+using namespace std;
+
+#include "iterative/SStepGMRes.hpp"
+
+using namespace strumpack;
+using namespace strumpack::iterative;
+
+#define SOLVE_TOLERANCE 1e-10
+
+
+/*
+ * Solve a nonsymmetric, tridiagonal system with s-step GMRES, with a
+ * callback that counts the global reductions. Each block of s Krylov
+ * vectors should need exactly one reduction for each of the two
+ * block Gram-Schmidt passes, plus one for the norm of the initial
+ * residual.
+ */
+int test_sstep_gmres(int n, int s) {
+  auto spmv = [n](const double* x, double* y) {
+    for (int i=0; i<n; i++)
+      y[i] = 2.5 * x[i] + (i > 0 ? -1.3 * x[i-1] : 0.) +
+        (i < n-1 ? -0.7 * x[i+1] : 0.);
+  };
+  auto prec = [](double*) {};
+  vector<double> x(n), b(n, 1.), r(n);
+  int block_reductions = 0, other_reductions = 0;
+  auto allreduce = [&](double*, int len) {
+    if (len > 1) block_reductions++;
+    else other_reductions++;
+  };
+  const int maxit = 100;
+  int its = 0;
+  sstep_gmres<double,double>
+    (allreduce, spmv, prec, n, x.data(), b.data(), SOLVE_TOLERANCE, 1e-14,
+     its, maxit, maxit, s, false, false);
+  spmv(x.data(), r.data());
+  double rnrm = 0.;
+  for (int i=0; i<n; i++)
+    rnrm += (r[i] - b[i]) * (r[i] - b[i]);
+  rnrm = std::sqrt(rnrm / n);
+  int blocks = (its + s - 1) / s;
+  cout << "# s = " << s << ", iterations = " << its
+       << ", block reductions = " << block_reductions
+       << ", other reductions = " << other_reductions
+       << ", residual = " << rnrm << endl;
+  if (rnrm > 1e2 * SOLVE_TOLERANCE || its >= maxit) {
+    cout << "ERROR: s-step GMRES did not converge" << endl;
+    return 1;
+  }
+  if (block_reductions != 2 * blocks || other_reductions != 1) {
+    cout << "ERROR: expected " << 2 * blocks
+         << " block reductions and 1 other reduction" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  cout << "# Running with:\n# ";
+  for (int i=0; i<argc; i++) cout << argv[i] << " ";
+  cout << endl;
+  int n = 1000;
+  if (argc > 1) n = stoi(argv[1]);
+  int ierr = 0;
+  for (int s : {1, 2, 4, 8})
+    ierr += test_sstep_gmres(n, s);
+  return ierr ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <iostream>
+using namespace std;
+
+#include "StrumpackSparseSolverMixedPrecision.hpp"
+#include "sparse/CSRMatrix.hpp"
+#include "misc/RandomWrapper.hpp"
+
+using namespace strumpack;
+
+#define ERROR_TOLERANCE 1e2
+
+
+/*
+ * Factor in single precision, refine in double precision. The
+ * preconditioner keeps a work matrix between solves, so solve for
+ * a number of right-hand sides, then for more, then for fewer, and
+ * check the residual each time. Solving the same system again has
+ * to give the same solution.
+ */
+template<typename integer_t> int
+test_mixed_precision(int argc, char* argv[],
+                     const CSRMatrix<double,integer_t>& A) {
+  SparseSolverMixedPrecision<float,double,integer_t> spss(false);
+  spss.options().set_Krylov_solver(KrylovSolver::REFINE);
+  spss.options().set_rel_tol(1e-10);
+  spss.options().set_from_command_line(argc, argv);
+  spss.solver().options().set_Krylov_solver(KrylovSolver::DIRECT);
+  spss.solver().options().set_from_command_line(argc, argv);
+
+  spss.set_matrix(A);
+  if (spss.factor() != ReturnCode::SUCCESS) {
+    cout << "problem during factorization of the matrix." << endl;
+    return 1;
+  }
+  integer_t N = A.size();
+  auto rgen = random::make_default_random_generator<double>();
+  DenseMatrix<double> x0;
+  for (int nrhs : {1, 3, 1}) {
+    DenseMatrix<double> b(N, nrhs), x(N, nrhs);
+    b.random(*rgen);
+    if (spss.solve(b, x) != ReturnCode::SUCCESS) {
+      cout << "problem during the solve." << endl;
+      return 1;
+    }
+    auto res = A.max_scaled_residual(x, b);
+    cout << "# NRHS = " << nrhs << ", REFINEMENT STEPS = "
+         << spss.Krylov_iterations()
+         << ", COMPONENTWISE SCALED RESIDUAL = " << res << endl;
+    if (res > ERROR_TOLERANCE * spss.options().rel_tol()) {
+      cout << "RESIDUAL TOO LARGE!" << endl;
+      return 1;
+    }
+    if (nrhs == 3) {
+      // the same solve again, after the work space was used
+      DenseMatrix<double> x2(N, nrhs);
+      spss.solve(b, x2);
+      for (int j=0; j<nrhs; j++)
+        for (integer_t i=0; i<N; i++)
+          if (x2(i, j) != x(i, j)) {
+            cout << "REPEATED SOLVE GIVES A DIFFERENT SOLUTION!" << endl;
+            return 1;
+          }
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    cout << "Usage: \n\t./test_mixed_precision_seq pde900.mtx" << endl;
+    return 1;
+  }
+  cout << "# Running with:\n# ";
+#if defined(_OPENMP)
+  cout << "OMP_NUM_THREADS=" << omp_get_max_threads() << " ";
+#endif
+  for (int i=0; i<argc; i++)
+    cout << argv[i] << " ";
+  cout << endl;
+
+  CSRMatrix<double,int> A;
+  if (A.read_matrix_market(argv[1])) {
+    cerr << "Could not read matrix from file." << endl;
+    return 1;
+  }
+  int ierr = test_mixed_precision(argc, argv, A);
+  if (ierr) return ierr;
+  CSRMatrix<double,long long int> Al;
+  Al.read_matrix_market(argv[1]);
+  return test_mixed_precision(argc, argv, Al);
+}
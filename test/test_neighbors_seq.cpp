@@ -0,0 +1,216 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <iostream>
+#include <random>
+#include <algorithm>
+using namespace std;
+
+#include "clustering/NeighborSearch.hpp"
+using namespace strumpack;
+
+#define ERROR_TOLERANCE 1e-4
+
+
+/*
+ * Compare the k nearest neighbors in (nbrs, scores) with the exact
+ * ones from a brute force search. Neighbors at the same distance can
+ * come in any order, so the squared distances are compared, and each
+ * returned index should be a point at that distance.
+ */
+template<typename real_t> int
+compare(const DenseMatrix<real_t>& data, const DenseMatrix<real_t>& Q,
+        const DenseMatrix<unsigned int>& nbrs,
+        const DenseMatrix<real_t>& scores,
+        const DenseMatrix<real_t>& exact_scores, const string& name) {
+  auto k = exact_scores.rows(), d = data.rows();
+  if (nbrs.rows() != k || nbrs.cols() != Q.cols() ||
+      scores.rows() != k || scores.cols() != Q.cols()) {
+    cout << "ERROR: " << name << " wrong output dimensions" << endl;
+    return 1;
+  }
+  for (size_t j=0; j<Q.cols(); j++) {
+    auto smax = exact_scores(k-1, j) + real_t(1.);
+    for (size_t i=0; i<k; i++) {
+      if (abs(scores(i, j) - exact_scores(i, j)) > ERROR_TOLERANCE * smax) {
+        cout << "ERROR: " << name << " distance " << i << " of point "
+             << j << " is " << scores(i, j) << ", should be "
+             << exact_scores(i, j) << endl;
+        return 1;
+      }
+      real_t dist(0.);
+      for (size_t l=0; l<d; l++) {
+        auto e = data(l, nbrs(i, j)) - Q(l, j);
+        dist += e * e;
+      }
+      if (abs(dist - scores(i, j)) > ERROR_TOLERANCE * smax) {
+        cout << "ERROR: " << name << " neighbor " << i << " of point "
+             << j << " does not match its distance" << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+template<typename real_t> int
+run(size_t n, size_t d, size_t k) {
+  mt19937 gen(1);
+  normal_distribution<real_t> nd(0., 1.);
+  DenseMatrix<real_t> data(d, n), Q(d, 100);
+  for (size_t j=0; j<n; j++)
+    for (size_t i=0; i<d; i++)
+      data(i, j) = nd(gen);
+  for (size_t j=0; j<Q.cols(); j++)
+    for (size_t i=0; i<d; i++)
+      Q(i, j) = nd(gen);
+
+  // reference: the exact neighbors, from an O(n^2) search without
+  // any of the NeighborIndex code
+  auto exact = [&](const DenseMatrix<real_t>& P, DenseMatrix<real_t>& S) {
+    S = DenseMatrix<real_t>(k, P.cols());
+    vector<real_t> dist(n);
+    for (size_t j=0; j<P.cols(); j++) {
+      for (size_t p=0; p<n; p++) {
+        dist[p] = real_t(0.);
+        for (size_t l=0; l<d; l++)
+          dist[p] += (data(l, p) - P(l, j)) * (data(l, p) - P(l, j));
+      }
+      partial_sort(dist.begin(), dist.begin()+k, dist.end());
+      for (size_t i=0; i<k; i++) S(i, j) = dist[i];
+    }
+  };
+  DenseMatrix<real_t> exact_all, exact_Q;
+  exact(data, exact_all);
+  exact(Q, exact_Q);
+
+  int ierr = 0;
+  for (auto type : {NeighborIndexType::BRUTE_FORCE,
+        NeighborIndexType::KD_TREE}) {
+    NeighborIndex<real_t> index(data, type, 8);
+    DenseMatrix<unsigned int> nbrs;
+    DenseMatrix<real_t> scores;
+    index.query_all(k, nbrs, scores);
+    ierr += compare(data, data, nbrs, scores, exact_all,
+                    get_name(type) + " query_all");
+    index.query(Q, k, nbrs, scores);
+    ierr += compare(data, Q, nbrs, scores, exact_Q,
+                    get_name(type) + " query");
+    index.query(Q, 0, nbrs, scores);
+    if (nbrs.rows() != 0 || nbrs.cols() != Q.cols()) {
+      cout << "ERROR: " << get_name(type) << " query with k = 0" << endl;
+      ierr++;
+    }
+  }
+
+  // the random projection forest is approximate, check that the
+  // lists are complete, sorted and without duplicates, and that every
+  // point finds itself. With leaves smaller than k, the lists have to
+  // be completed, for a single tree the leaf of a query never holds k
+  // points. With the default leaves, also check the recall.
+  for (auto lt : {make_pair(k/2, size_t(1)), make_pair(k/2, size_t(4)),
+        make_pair(size_t(0), size_t(4))}) {
+    auto leaf = lt.first;
+    NeighborIndex<real_t> index
+      (data, NeighborIndexType::RP_FOREST, leaf, lt.second);
+    DenseMatrix<unsigned int> nbrs;
+    DenseMatrix<real_t> scores;
+    index.query(Q, k, nbrs, scores);
+    if (nbrs.rows() != k || nbrs.cols() != Q.cols()) {
+      cout << "ERROR: rpforest query wrong output dimensions" << endl;
+      return 1;
+    }
+    for (size_t j=0; j<Q.cols(); j++) {
+      vector<unsigned int> l(nbrs.ptr(0, j), nbrs.ptr(0, j)+k);
+      sort(l.begin(), l.end());
+      if (l.back() >= n || adjacent_find(l.begin(), l.end()) != l.end() ||
+          !is_sorted(scores.ptr(0, j), scores.ptr(0, j)+k)) {
+        cout << "ERROR: rpforest query invalid neighbor list for point "
+             << j << endl;
+        return 1;
+      }
+      for (size_t i=0; i<k; i++) {
+        real_t dist(0.);
+        for (size_t l=0; l<d; l++) {
+          auto e = data(l, nbrs(i, j)) - Q(l, j);
+          dist += e * e;
+        }
+        if (abs(dist - scores(i, j)) >
+            ERROR_TOLERANCE * (exact_Q(k-1, j) + real_t(1.))) {
+          cout << "ERROR: rpforest query neighbor " << i << " of point "
+               << j << " does not match its distance" << endl;
+          return 1;
+        }
+      }
+    }
+    index.query_all(k, nbrs, scores);
+    size_t found = 0;
+    for (size_t j=0; j<n; j++) {
+      vector<unsigned int> l(nbrs.ptr(0, j), nbrs.ptr(0, j)+k);
+      sort(l.begin(), l.end());
+      if (scores(0, j) != real_t(0.) ||
+          adjacent_find(l.begin(), l.end()) != l.end() ||
+          !is_sorted(scores.ptr(0, j), scores.ptr(0, j)+k)) {
+        cout << "ERROR: rpforest invalid neighbor list for point "
+             << j << endl;
+        return 1;
+      }
+      for (size_t i=0; i<k; i++)
+        if (scores(i, j) <= exact_all(k-1, j)) found++;
+    }
+    auto recall = double(found) / (n * k);
+    cout << "# rpforest leaf_size = " << leaf << ", trees = " << lt.second
+         << ", recall = " << recall << endl;
+    if (leaf == 0 && recall < 0.8) {
+      cout << "ERROR: rpforest recall too low" << endl;
+      ierr++;
+    }
+  }
+  return ierr;
+}
+
+int main(int argc, char* argv[]) {
+  cout << "# Running with:\n# ";
+#if defined(_OPENMP)
+  cout << "OMP_NUM_THREADS=" << omp_get_max_threads() << " ";
+#endif
+  for (int i=0; i<argc; i++) cout << argv[i] << " ";
+  cout << endl;
+
+  size_t n = 2000, d = 3, k = 10;
+  if (argc > 1) n = stoul(argv[1]);
+  if (argc > 2) d = stoul(argv[2]);
+  if (argc > 3) k = stoul(argv[3]);
+  if (n < k || !k) {
+    cout << "# usage: ./test_neighbors_seq n d k, with 0 < k <= n" << endl;
+    return 1;
+  }
+  int ierr = run<double>(n, d, k);
+  ierr += run<float>(n, d, k);
+  if (!ierr) cout << "# exiting" << endl;
+  return ierr ? 1 : 0;
+}
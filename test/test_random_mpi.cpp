@@ -0,0 +1,97 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <iostream>
+#include <vector>
+using namespace std;
+
+#include "dense/DistributedMatrix.hpp"
+#include "misc/RandomWrapper.hpp"
+
+using namespace strumpack;
+
+
+/*
+ * Fill DistributedMatrices with the Philox generator, on different
+ * process grids and with different block sizes, and compare every
+ * local element with the same element of a sequential DenseMatrix
+ * filled with the same seed. Processes outside the grid do not
+ * generate anything, but stay in sync with the processes on the
+ * grid, so a second fill gives the second block on all of them.
+ */
+template<typename real_t> int
+test_philox_grid(const MPIComm& c, const BLACSGrid* g, int m, int n,
+                 int mb, int nb) {
+  using namespace random;
+  PhiloxGenerator<real_t> rs(2023), rd(2023);
+  DenseMatrix<real_t> S1(m, n), S2(m, n);
+  S1.random(rs);
+  S2.random(rs);
+  DistributedMatrix<real_t> D1(g, m, n, mb, nb), D2(g, m, n, mb, nb);
+  D1.random(rd);
+  D2.random(rd);
+  int err = 0;
+  if (D1.active())
+    for (int j=0; j<D1.lcols(); j++)
+      for (int i=0; i<D1.lrows(); i++)
+        if (D1(i, j) != S1(D1.rowl2g(i), D1.coll2g(j)) ||
+            D2(i, j) != S2(D2.rowl2g(i), D2.coll2g(j)))
+          err++;
+  err = c.all_reduce(err, MPI_SUM);
+  int pr = c.all_reduce(g->active() ? g->nprows() : 0, MPI_MAX),
+    pc = c.all_reduce(g->active() ? g->npcols() : 0, MPI_MAX);
+  if (c.is_root())
+    cout << "# " << pr << "x" << pc << " grid, " << m << "x" << n
+         << " matrix, " << mb << "x" << nb << " blocks: "
+         << err << " elements differ" << endl;
+  return err ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+  MPI_Init(&argc, &argv);
+  int ierr = 0;
+  {
+    MPIComm c;
+    int P = c.size();
+    BLACSGrid all(c), one(c.sub(0, 1), 1);
+    // a grid on the last P-1 processes, with a different shape
+    BLACSGrid rest(c.sub(P > 1 ? 1 : 0, P > 1 ? P-1 : 1),
+                   P > 1 ? P-1 : 1);
+    for (auto g : {&all, &one, &rest}) {
+      ierr |= test_philox_grid<double>(c, g, 200, 130, 32, 32);
+      ierr |= test_philox_grid<float>(c, g, 57, 91, 8, 5);
+    }
+    if (c.is_root())
+      cout << (ierr ? "ERROR: " : "# ")
+           << "Philox random matrices "
+           << (ierr ? "depend" : "do not depend")
+           << " on the process grid" << endl;
+  }
+  scalapack::Cblacs_exit(1);
+  MPI_Finalize();
+  return ierr;
+}
@@ -0,0 +1,426 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+using namespace std;
+
+#include "StrumpackSparseSolver.hpp"
+#include "sparse/CSRMatrix.hpp"
+#include "sparse/SeparatorTree.hpp"
+#include "sparse/ordering/MatrixReordering.hpp"
+
+using namespace strumpack;
+
+#define ERROR_TOLERANCE 1e2
+
+/*
+ * 5-point Laplacian on an n x n grid. If shuffle, the unknowns are
+ * numbered in a random order, as for an unstructured mesh, otherwise
+ * row by row. The coordinates of unknown i are stored in coords[2*i]
+ * and coords[2*i+1].
+ */
+template<typename scalar_t,typename integer_t> CSRMatrix<scalar_t,integer_t>
+laplacian(int n, bool shuffled, vector<double>& coords) {
+  integer_t N = n * n;
+  vector<integer_t> p(N);   // grid point to unknown
+  iota(p.begin(), p.end(), 0);
+  if (shuffled)
+    shuffle(p.begin(), p.end(), default_random_engine(7));
+  vector<integer_t> ip(N);  // unknown to grid point
+  for (integer_t i=0; i<N; i++) ip[p[i]] = i;
+  CSRMatrix<scalar_t,integer_t> A(N, 5*N-4*n);
+  auto ptr = A.ptr();
+  auto ind = A.ind();
+  auto val = A.val();
+  coords.resize(2*N);
+  integer_t nnz = 0;
+  ptr[0] = 0;
+  for (integer_t i=0; i<N; i++) {
+    int row = ip[i] / n, col = ip[i] % n;
+    coords[2*i] = col;
+    coords[2*i+1] = row;
+    val[nnz] = 4.; ind[nnz++] = i;
+    if (col > 0)   { val[nnz] = -1.; ind[nnz++] = p[ip[i]-1]; }
+    if (col < n-1) { val[nnz] = -1.; ind[nnz++] = p[ip[i]+1]; }
+    if (row > 0)   { val[nnz] = -1.; ind[nnz++] = p[ip[i]-n]; }
+    if (row < n-1) { val[nnz] = -1.; ind[nnz++] = p[ip[i]+n]; }
+    ptr[i+1] = nnz;
+  }
+  A.set_symm_sparse();
+  return A;
+}
+
+/*
+ * Permute the matrix, with a copy or in place, and compare with the dense
+ * permutation: B(i,j) = A(iorder[i],iorder[j]). The column indices
+ * in each row of the permuted matrix should be sorted.
+ */
+template<typename scalar_t,typename integer_t> int
+test_permute(int n, bool in_place) {
+  vector<double> coords;
+  auto A = laplacian<scalar_t,integer_t>(n, true, coords);
+  integer_t N = A.size();
+  // all different values, so any misplaced nonzero is detected
+  for (integer_t j=0; j<A.nnz(); j++) A.val(j) = scalar_t(j+1);
+  vector<integer_t> order(N), iorder(N);
+  iota(iorder.begin(), iorder.end(), 0);
+  shuffle(iorder.begin(), iorder.end(), default_random_engine(11));
+  for (integer_t i=0; i<N; i++) order[iorder[i]] = i;
+  auto B = A;
+  if (in_place) B.permute_in_place(iorder, order);
+  else B.permute(iorder, order);
+  auto dense = [N](const CSRMatrix<scalar_t,integer_t>& M) {
+    vector<scalar_t> D(N*N, scalar_t(0.));
+    for (integer_t i=0; i<N; i++)
+      for (auto j=M.ptr(i); j<M.ptr(i+1); j++)
+        D[i+M.ind(j)*N] = M.val(j);
+    return D;
+  };
+  auto Ad = dense(A), Bd = dense(B);
+  for (integer_t i=0; i<N; i++) {
+    for (auto j=B.ptr(i)+1; j<B.ptr(i+1); j++)
+      if (B.ind(j-1) >= B.ind(j)) {
+        cout << "PERMUTED MATRIX ROW " << i << " NOT SORTED!" << endl;
+        return 1;
+      }
+    for (integer_t j=0; j<N; j++)
+      if (Bd[i+j*N] != Ad[iorder[i]+iorder[j]*N]) {
+        cout << "PERMUTED MATRIX WRONG AT (" << i << ", " << j << ")!"
+             << endl;
+        return 1;
+      }
+  }
+  if (B.nnz() != A.nnz() || B.ptr(N) != A.nnz()) {
+    cout << "PERMUTED MATRIX HAS WRONG NUMBER OF NONZEROS!" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+/*
+ * The coordinate nested dissection, with PCA and kd-tree bisection,
+ * on a randomly numbered grid. The solve should be accurate, and the
+ * fill should be close to the geometric nested dissection on the
+ * (lexicographically numbered) grid.
+ */
+template<typename scalar_t,typename integer_t> int
+test_coordinate_ND(int argc, const char* const argv[], int n) {
+  vector<double> coords;
+  auto A = laplacian<scalar_t,integer_t>(n, true, coords);
+  integer_t N = A.size();
+  vector<scalar_t> b(N, scalar_t(1.)), x(N);
+
+  size_t geo_nnz = 0;
+  {
+    // reference, geometric nested dissection on the original grid
+    vector<double> c;
+    auto L = laplacian<scalar_t,integer_t>(n, false, c);
+    StrumpackSparseSolver<scalar_t,integer_t> spss(false);
+    spss.options().set_reordering_method(ReorderingStrategy::GEOMETRIC);
+    spss.set_matrix(L);
+    spss.reorder(n, n);
+    spss.factor();
+    geo_nnz = spss.factor_nonzeros();
+  }
+
+  for (auto c : {ClusteringAlgorithm::PCA, ClusteringAlgorithm::KD_TREE}) {
+    StrumpackSparseSolver<scalar_t,integer_t> spss(false);
+    spss.options().set_from_command_line(argc, argv);
+    spss.options().set_reordering_method(ReorderingStrategy::COORDINATE);
+    spss.options().set_coordinate_ND_clustering(c);
+    spss.set_matrix(A);
+    // this fails, but the solver can still be used with coordinates
+    if (spss.reorder() != ReturnCode::REORDERING_ERROR) {
+      cout << "COORDINATE ORDERING WITHOUT COORDINATES SHOULD FAIL!"
+           << endl;
+      return 1;
+    }
+    if (spss.reorder(coords.data(), 2) != ReturnCode::SUCCESS ||
+        spss.factor() != ReturnCode::SUCCESS) {
+      cout << "COORDINATE ORDERING FAILED!" << endl;
+      return 1;
+    }
+    spss.solve(b.data(), x.data());
+    auto res = A.max_scaled_residual(x.data(), b.data());
+    auto fnnz = spss.factor_nonzeros();
+    cout << "# " << get_name(c) << ": COMPONENTWISE SCALED RESIDUAL = "
+         << res << ", FACTOR NONZEROS = " << fnnz
+         << ", GEOMETRIC = " << geo_nnz << endl;
+    if (res > ERROR_TOLERANCE * spss.options().rel_tol()) {
+      cout << "RESIDUAL TOO LARGE!" << endl;
+      return 1;
+    }
+    if (fnnz > 1.25 * geo_nnz) {
+      cout << "COORDINATE ORDERING HAS TOO MUCH FILL!" << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/*
+ * The ordering cache. The first solve writes the ordering to the
+ * cache, the second reads it. A cache file that is truncated, has an
+ * invalid permutation or separator tree, or was written for another
+ * matrix, is rejected, and the solver then recomputes the ordering.
+ */
+template<typename scalar_t,typename integer_t> int
+test_ordering_cache(int argc, const char* const argv[], int n) {
+  vector<double> coords;
+  auto A = laplacian<scalar_t,integer_t>(n, false, coords);
+  integer_t N = A.size();
+  vector<scalar_t> b(N, scalar_t(1.)), x(N);
+  SPOptions<scalar_t> opts;
+  opts.set_from_command_line(argc, argv);
+  opts.set_verbose(false);
+  opts.set_matching(MatchingJob::NONE);
+  opts.set_reordering_method(ReorderingStrategy::GEOMETRIC);
+  opts.set_ordering_cache(".");
+  auto fname = MatrixReordering<scalar_t,integer_t>(N).cache_file
+    (opts, A, n, n, 1, 1, 1, nullptr, 0);
+  remove(fname.c_str());
+
+  auto solve = [&](size_t& fnnz) {
+    StrumpackSparseSolver<scalar_t,integer_t> spss(false);
+    spss.options() = opts;
+    spss.set_matrix(A);
+    if (spss.reorder(n, n) != ReturnCode::SUCCESS ||
+        spss.factor() != ReturnCode::SUCCESS) {
+      cout << "CACHED ORDERING FAILED!" << endl;
+      return 1;
+    }
+    spss.solve(b.data(), x.data());
+    auto res = A.max_scaled_residual(x.data(), b.data());
+    fnnz = spss.factor_nonzeros();
+    if (res > ERROR_TOLERANCE * opts.rel_tol()) {
+      cout << "RESIDUAL TOO LARGE! " << res << endl;
+      return 1;
+    }
+    return 0;
+  };
+  auto read = [&](const CSRMatrix<scalar_t,integer_t>& M) {
+    MatrixReordering<scalar_t,integer_t> nd(M.size());
+    return nd.read_cache(opts, M, fname);
+  };
+
+  size_t fnnz = 0, cached_fnnz = 0;
+  if (solve(fnnz)) return 1;
+  ifstream is(fname, ios::binary);
+  vector<char> file((istreambuf_iterator<char>(is)),
+                    istreambuf_iterator<char>());
+  is.close();
+  if (file.empty() || read(A)) {
+    cout << "ORDERING CACHE WAS NOT WRITTEN!" << endl;
+    return 1;
+  }
+  if (solve(cached_fnnz)) return 1;
+  if (cached_fnnz != fnnz) {
+    cout << "CACHED ORDERING DIFFERS! " << cached_fnnz
+         << " != " << fnnz << endl;
+    return 1;
+  }
+
+  // the file layout is: magic[8], int version, n, nnz, perm[n],
+  // iperm[n], nseps, sizes[nseps+1], parent[nseps], lch[nseps],
+  // rch[nseps]
+  const size_t perm = 8 + sizeof(int) + 2 * sizeof(integer_t),
+    nseps_off = perm + 2 * N * sizeof(integer_t);
+  integer_t nseps;
+  memcpy(&nseps, &file[nseps_off], sizeof(integer_t));
+  const size_t sizes = nseps_off + sizeof(integer_t),
+    parent = sizes + (nseps+1) * sizeof(integer_t),
+    lch = parent + nseps * sizeof(integer_t);
+  auto write = [&](const vector<char>& f) {
+    ofstream os(fname, ios::binary);
+    os.write(f.data(), f.size());
+  };
+  auto corrupt = [&](size_t off, integer_t v) {
+    auto f = file;
+    memcpy(&f[off], &v, sizeof(integer_t));
+    return f;
+  };
+  integer_t p0;
+  memcpy(&p0, &file[perm+sizeof(integer_t)], sizeof(integer_t));
+  vector<pair<string,vector<char>>> bad =
+    {{"truncated", vector<char>(file.begin(), file.end()-1)},
+     {"truncated tree", vector<char>(file.begin(), file.begin()+lch)},
+     {"not a permutation", corrupt(perm, p0)},
+     {"nseps too large", corrupt(nseps_off, N+1)},
+     {"sizes not monotone", corrupt(sizes+(nseps-1)*sizeof(integer_t), N+1)},
+     {"parent out of range", corrupt(parent, nseps)},
+     {"lch out of range", corrupt(lch, -2)},
+     {"lch is not a child", corrupt(lch, nseps-1)}};
+  if (nseps < 3) {
+    cout << "SEPARATOR TREE TOO SMALL!" << endl;
+    return 1;
+  }
+  for (auto& f : bad) {
+    write(f.second);
+    if (!read(A)) {
+      cout << "CORRUPTED ORDERING CACHE (" << f.first
+           << ") WAS NOT REJECTED!" << endl;
+      return 1;
+    }
+    // the ordering is recomputed, and the cache file is rewritten
+    if (solve(cached_fnnz)) return 1;
+    if (cached_fnnz != fnnz || read(A)) {
+      cout << "ORDERING NOT RECOMPUTED AFTER REJECTING THE CACHE ("
+           << f.first << ")!" << endl;
+      return 1;
+    }
+  }
+  // a cache file written for another matrix
+  auto B = laplacian<scalar_t,integer_t>(n+1, false, coords);
+  if (!read(B)) {
+    cout << "ORDERING CACHE FOR ANOTHER MATRIX WAS NOT REJECTED!"
+         << endl;
+    return 1;
+  }
+  remove(fname.c_str());
+  cout << "# ORDERING CACHE: FACTOR NONZEROS = " << fnnz
+       << ", " << bad.size() << " CORRUPTED FILES REJECTED" << endl;
+  return 0;
+}
+
+/*
+ * Check that the separator tree is valid, and is an elimination tree
+ * for the permuted matrix: the separator containing the later of the
+ * two unknowns coupled by a nonzero must be an ancestor of the
+ * separator containing the other.
+ */
+template<typename scalar_t,typename integer_t> bool
+check_tree(const CSRMatrix<scalar_t,integer_t>& A,
+           const MatrixReordering<scalar_t,integer_t>& nd) {
+  integer_t N = A.size();
+  auto& perm = nd.perm();
+  auto& iperm = nd.iperm();
+  for (integer_t i=0; i<N; i++)
+    if (perm[i] < 0 || perm[i] >= N || iperm[perm[i]] != i)
+      return false;
+  auto& t = nd.tree();
+  if (!t.valid()) return false;
+  vector<integer_t> sep(N);
+  for (integer_t s=0; s<t.separators(); s++)
+    for (auto i=t.sizes[s]; i<t.sizes[s+1]; i++)
+      sep[i] = s;
+  for (integer_t r=0; r<N; r++)
+    for (auto j=A.ptr(r); j<A.ptr(r+1); j++) {
+      auto i = perm[r], k = perm[A.ind(j)];
+      auto s = sep[min(i, k)];
+      while (s != -1 && s != sep[max(i, k)]) s = t.parent[s];
+      if (s == -1) return false;
+    }
+  return true;
+}
+
+/*
+ * The shared memory parallel nested dissection, with AMD and AND on
+ * the subgraphs. The tree should be a valid elimination tree, and
+ * the solve should be accurate. The fill is reported, compared to the
+ * sequential ordering, it depends on the METIS vertex separators.
+ */
+template<typename scalar_t,typename integer_t> int
+test_parallel_ND(int argc, const char* const argv[], int n) {
+  vector<double> coords;
+  auto A = laplacian<scalar_t,integer_t>(n, false, coords);
+  integer_t N = A.size();
+  vector<scalar_t> b(N, scalar_t(1.)), x(N);
+  for (auto m : {ReorderingStrategy::AMD, ReorderingStrategy::AND}) {
+    size_t seq_nnz = 0;
+    for (int levels : {0, 1, 3}) {
+      SPOptions<scalar_t> opts;
+      opts.set_from_command_line(argc, argv);
+      opts.set_verbose(false);
+      opts.set_reordering_method(m);
+      opts.set_nd_parallel_levels(levels);
+      MatrixReordering<scalar_t,integer_t> nd(N);
+      if (nd.nested_dissection(opts, A, n, n, 1, 1, 1) ||
+          !check_tree(A, nd)) {
+        cout << "PARALLEL ND WITH " << levels
+             << " LEVELS GAVE AN INVALID TREE!" << endl;
+        return 1;
+      }
+      StrumpackSparseSolver<scalar_t,integer_t> spss(false);
+      spss.options() = opts;
+      spss.set_matrix(A);
+      if (spss.reorder(n, n) != ReturnCode::SUCCESS ||
+          spss.factor() != ReturnCode::SUCCESS) {
+        cout << "PARALLEL ND FAILED!" << endl;
+        return 1;
+      }
+      spss.solve(b.data(), x.data());
+      auto res = A.max_scaled_residual(x.data(), b.data());
+      auto fnnz = spss.factor_nonzeros();
+      if (!levels) seq_nnz = fnnz;
+      cout << "# " << get_name(m) << ", nd_parallel_levels = " << levels
+           << ": COMPONENTWISE SCALED RESIDUAL = " << res
+           << ", FACTOR NONZEROS = " << fnnz
+           << ", SEQUENTIAL = " << seq_nnz << endl;
+      if (res > ERROR_TOLERANCE * opts.rel_tol()) {
+        cout << "RESIDUAL TOO LARGE!" << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  cout << "# Running with:\n# ";
+#if defined(_OPENMP)
+  cout << "OMP_NUM_THREADS=" << omp_get_max_threads() << " ";
+#endif
+  for (int i=0; i<argc; i++)
+    cout << argv[i] << " ";
+  cout << endl;
+
+  int ierr = 0;
+  for (bool in_place : {false, true}) {
+    ierr = test_permute<double,int>(20, in_place);
+    if (ierr) return ierr;
+    ierr = test_permute<complex<float>,long long int>(15, in_place);
+    if (ierr) return ierr;
+  }
+  ierr = test_coordinate_ND<double,int>(argc, argv, 60);
+  if (ierr) return ierr;
+  ierr = test_coordinate_ND<double,long long int>(argc, argv, 45);
+  if (ierr) return ierr;
+  ierr = test_ordering_cache<double,int>(argc, argv, 40);
+  if (ierr) return ierr;
+  ierr = test_ordering_cache<double,long long int>(argc, argv, 30);
+  if (ierr) return ierr;
+  ierr = test_parallel_ND<double,int>(argc, argv, 60);
+  if (ierr) return ierr;
+  return test_parallel_ND<double,long long int>(argc, argv, 40);
+}
@@ -28,6 +28,7 @@
  */
 #include <iostream>
 #include <cstring>
+#include <cmath>
 using namespace std;
 
 #include "StrumpackSparseSolver.hpp"
@@ -39,6 +40,30 @@ using namespace strumpack;
 #define ERROR_TOLERANCE 1e2
 #define SOLVE_TOLERANCE 1e-12
 
+// Factor A with a copy of the options of spss, after changing them
+// with set_opts, to compare against.
+template<typename scalar_t,typename integer_t,typename F> int
+factor_reference(const StrumpackSparseSolver<scalar_t,integer_t>& spss,
+                 const CSRMatrix<scalar_t,integer_t>& A, F set_opts,
+                 StrumpackSparseSolver<scalar_t,integer_t>& ref) {
+  ref.options() = spss.options();
+  ref.options().set_verbose(false);
+  set_opts(ref.options());
+  ref.set_matrix(A);
+  if (ref.factor() != ReturnCode::SUCCESS) {
+    cout << "problem during factorization of the matrix." << endl;
+    return 1;
+  }
+  return 0;
+}
+
+// Check for a test flag, these are ignored by set_from_command_line.
+bool has_flag(int argc, const char* const argv[], const string& flag) {
+  for (int i=1; i<argc; i++)
+    if (flag == argv[i]) return true;
+  return false;
+}
+
 template<typename scalar_t,typename integer_t> int
 test_sparse_solver(int argc, const char* const argv[],
                    CSRMatrix<scalar_t,integer_t>& A) {
@@ -70,6 +95,137 @@ test_sparse_solver(int argc, const char* const argv[],
   cout << "# COMPONENTWISE SCALED RESIDUAL = "
        << comp_scal_res << endl;
 
+  if (has_flag(argc, argv, "--test_memory_report")) {
+    // the memory report splits the factors over the front types and
+    // the levels of the tree, both should add up to the nonzeros
+    auto r = spss.memory_report();
+    long long fmem = spss.factor_nonzeros() * sizeof(scalar_t), lf = 0;
+    for (auto l : r.level_factors) lf += l;
+    long long comp = 0;
+    switch (spss.options().compression()) {
+    case CompressionType::NONE: break;
+    case CompressionType::HSS: comp = r.HSS; break;
+    case CompressionType::BLR:
+    case CompressionType::AUTO: comp = r.BLR; break;
+    case CompressionType::HODLR: comp = r.HODLR; break;
+    case CompressionType::BLR_HODLR: comp = r.BLR + r.HODLR; break;
+    case CompressionType::LOSSLESS:
+    case CompressionType::LOSSY: comp = r.lossy; break;
+    default: comp = r.factors() - r.dense;
+    }
+    cout << "# MEMORY REPORT: DENSE " << r.dense << ", COMPRESSED "
+         << comp << " BYTES, FACTOR NONZEROS "
+         << spss.factor_nonzeros() << endl;
+    if (r.factors() != fmem || lf != fmem || r.dense + comp != fmem) {
+      cout << "MEMORY REPORT DOES NOT MATCH THE FACTOR NONZEROS!" << endl;
+      return 1;
+    }
+  }
+
+  if (has_flag(argc, argv, "--test_concurrent_solve")) {
+    // concurrent solves on the same factors, each with its own context
+    const int ns = 4;
+    vector<vector<scalar_t>> xs(ns, vector<scalar_t>(N));
+    vector<ReturnCode> err(ns);
+#pragma omp parallel for num_threads(ns) schedule(static,1)
+    for (int i=0; i<ns; i++) {
+      SolveContext<scalar_t> ctx;
+      err[i] = spss.solve(b.data(), xs[i].data(), ctx);
+    }
+    for (int i=0; i<ns; i++) {
+      auto res = A.max_scaled_residual(xs[i].data(), b.data());
+      if (err[i] != ReturnCode::SUCCESS ||
+          res > ERROR_TOLERANCE*spss.options().rel_tol()) {
+        cout << "CONCURRENT SOLVE FAILED, RESIDUAL = " << res << endl;
+        return 1;
+      }
+    }
+  }
+
+  if (has_flag(argc, argv, "--test_update_values")) {
+    // update the values, keeping the sparsity pattern. The first
+    // update builds a map from the input nonzeros to the internal
+    // matrix, the later updates use that map.
+    CSRMatrix<scalar_t,integer_t> Au(A);
+    vector<scalar_t> bu(N), xu(N);
+    for (int u=1; u<=3; u++) {
+      for (integer_t i=0; i<A.nnz(); i++)
+        Au.val()[i] = A.val()[i] *
+          scalar_t(1. + 0.05 * u * std::sin(real_t(i)));
+      Au.spmv(x_exact.data(), bu.data());
+      spss.update_matrix_values(Au);
+      if (spss.solve(bu.data(), xu.data()) != ReturnCode::SUCCESS) {
+        cout << "problem during the solve after update "
+             << u << "." << endl;
+        return 1;
+      }
+      auto res = Au.max_scaled_residual(xu.data(), bu.data());
+      cout << "# UPDATE " << u << ", COMPONENTWISE SCALED RESIDUAL = "
+           << res << endl;
+      if (res > ERROR_TOLERANCE*spss.options().rel_tol()) {
+        cout << "RESIDUAL AFTER VALUES UPDATE TOO LARGE!" << endl;
+        return 1;
+      }
+    }
+  }
+
+  if (spss.options().adaptive_precision()) {
+    // the same factorization, with all factors in working precision
+    StrumpackSparseSolver<scalar_t,integer_t> ref;
+    if (factor_reference(spss, A, [](SPOptions<scalar_t>& o) {
+          o.disable_adaptive_precision(); }, ref))
+      return 1;
+    cout << "# FACTOR MEMORY = " << spss.factor_memory() / 1.e6
+         << " MB, IN WORKING PRECISION = " << ref.factor_memory() / 1.e6
+         << " MB" << endl;
+    if (!(spss.factor_memory() < ref.factor_memory())) {
+      cout << "ADAPTIVE PRECISION DID NOT REDUCE THE FACTOR MEMORY!" << endl;
+      return 1;
+    }
+  }
+
+  if (spss.options().front_amalgamation_fill() > 0) {
+    // merging fronts adds explicit zeros to the factors, and removes
+    // levels from the bottom of the elimination tree
+    StrumpackSparseSolver<scalar_t,integer_t> ref;
+    if (factor_reference(spss, A, [](SPOptions<scalar_t>& o) {
+          o.set_front_amalgamation_fill(0.); }, ref))
+      return 1;
+    auto levels = spss.memory_report().level_factors.size(),
+      ref_levels = ref.memory_report().level_factors.size();
+    cout << "# AMALGAMATION: " << levels << " LEVELS, "
+         << spss.factor_nonzeros() << " FACTOR NONZEROS, WITHOUT: "
+         << ref_levels << " LEVELS, " << ref.factor_nonzeros()
+         << " FACTOR NONZEROS" << endl;
+    if (!(levels < ref_levels) ||
+        !(spss.factor_nonzeros() > ref.factor_nonzeros())) {
+      cout << "AMALGAMATION DID NOT MERGE ANY FRONTS!" << endl;
+      return 1;
+    }
+  }
+
+  if (spss.options().use_task_dag()) {
+    // the same factorization, with the recursive tree traversal. Only
+    // the order of the extend-add from the children can differ.
+    StrumpackSparseSolver<scalar_t,integer_t> ref;
+    if (factor_reference(spss, A, [](SPOptions<scalar_t>& o) {
+          o.disable_task_dag(); }, ref))
+      return 1;
+    vector<scalar_t> xr(N);
+    ref.solve(b.data(), xr.data());
+    if (ref.factor_nonzeros() != spss.factor_nonzeros()) {
+      cout << "TASK DAG CHANGED THE FACTOR NONZEROS!" << endl;
+      return 1;
+    }
+    blas::axpy(N, scalar_t(-1.), x.data(), 1, xr.data(), 1);
+    auto diff = blas::nrm2(N, xr.data(), 1) / blas::nrm2(N, x.data(), 1);
+    cout << "# DIFFERENCE WITH RECURSIVE TRAVERSAL = " << diff << endl;
+    if (diff > ERROR_TOLERANCE*spss.options().rel_tol()) {
+      cout << "TASK DAG SOLUTION DIFFERS FROM THE RECURSIVE ONE!" << endl;
+      return 1;
+    }
+  }
+
   blas::axpy(N, scalar_t(-1.), x_exact.data(), 1, x.data(), 1);
   auto nrm_error = blas::nrm2(N, x.data(), 1);
   auto nrm_x_exact = blas::nrm2(N, x_exact.data(), 1);
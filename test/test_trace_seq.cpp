@@ -0,0 +1,128 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ */
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <cmath>
+using namespace std;
+
+#include "misc/TaskTimer.hpp"
+
+using namespace strumpack;
+
+
+std::size_t count(const std::string& s, const std::string& p) {
+  std::size_t n = 0;
+  for (auto i=s.find(p); i!=std::string::npos; i=s.find(p, i+p.size()))
+    n++;
+  return n;
+}
+
+/*
+ * Record events from several threads with TraceRegion, write them
+ * with TraceRecorder::write_events and check the Chrome trace event
+ * output: one complete event per region, with the front arguments
+ * and flops, escaped names, shifted times, and, when a ring buffer
+ * overflows, only the most recent events are kept.
+ */
+int main(int argc, char* argv[]) {
+  const int nt = 4, ne = 100;
+  {
+    TraceRegion r("say \"hi\"", 7, 3, 20, 10);
+    r.add_flops(1000.);
+    r.add_flops(234.);
+  }
+#pragma omp parallel for num_threads(nt) schedule(static, 1)
+  for (int t=0; t<nt; t++)
+    for (int i=0; i<ne; i++) {
+      TraceRegion r("factor", i, t, 1, 1);
+    }
+  if (TraceRecorder::dropped()) {
+    cout << "ERROR: events were dropped" << endl;
+    return 1;
+  }
+  std::ostringstream os;
+  bool first = true;
+  TraceRecorder::write_events(os, 5, 0., first);
+  auto s = os.str();
+  if (first || count(s, "\"ph\":\"X\"") != nt*ne+1 ||
+      count(s, "\"name\":\"factor\"") != nt*ne) {
+    cout << "ERROR: wrong number of events" << endl;
+    return 1;
+  }
+  if (count(s, "\"pid\":5,") != nt*ne+1 ||
+      count(s, "},\n{") != nt*ne) {
+    cout << "ERROR: events not separated or wrong pid" << endl;
+    return 1;
+  }
+  if (s.find("{\"name\":\"say \\\"hi\\\"\"") != 0 ||
+      s.find("\"args\":{\"front\":7,\"level\":3,\"dim_sep\":20,"
+             "\"dim_upd\":10,\"flops\":1234}}") == std::string::npos) {
+    cout << "ERROR: wrong event name or arguments" << endl;
+    cout << s.substr(0, 200) << endl;
+    return 1;
+  }
+  // all times shifted by 1000 seconds
+  std::ostringstream os2;
+  first = true;
+  TraceRecorder::write_events(os2, 5, 1000., first);
+  auto ts = [](const std::string& s) {
+    auto i = s.find("\"ts\":") + 5;
+    return std::stod(s.substr(i, s.find(',', i) - i));
+  };
+  if (std::abs(ts(os2.str()) - ts(s) - 1e9) > 1.) {
+    cout << "ERROR: time offset not applied" << endl;
+    return 1;
+  }
+
+  // overflow the ring buffer of a new thread
+  const std::size_t extra = 10;
+  std::thread overflow([&]() {
+      for (std::size_t i=0; i<TraceRecorder::capacity+extra; i++) {
+        TraceRegion r("solve", 0, 0, 1, 1);
+      }
+    });
+  overflow.join();
+  if (TraceRecorder::dropped() != extra) {
+    cout << "ERROR: dropped " << TraceRecorder::dropped()
+         << " events, expected " << extra << endl;
+    return 1;
+  }
+  std::ostringstream os3;
+  first = true;
+  TraceRecorder::write_events(os3, 0, 0., first);
+  s = os3.str();
+  if (count(s, "\"ph\":\"X\"") != TraceRecorder::capacity + nt*ne + 1 ||
+      count(s, "\"name\":\"solve\"") != TraceRecorder::capacity) {
+    cout << "ERROR: wrong events after overflow" << endl;
+    return 1;
+  }
+  cout << "# trace recorder tests passed" << endl;
+  return 0;
+}